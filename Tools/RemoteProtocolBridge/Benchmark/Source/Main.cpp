@@ -0,0 +1,322 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include <JuceHeader.h>
+
+#include "MicroBenchmark.h"
+
+#include "../../Source/ObjectDataHandling.h"
+#include "../../Source/ProcessingEngineConfig.h"
+#include "../../Source/ProcessingEngineNode.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCAddressTable.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCBundlePacker.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCMessageEncoder.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCProtocolProcessor.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCRawMessageDecoder.h"
+
+#include <iostream>
+
+
+/**
+ * Ports used by the protocol processors under test. Only the loopback interface is used.
+ */
+enum BenchmarkPorts
+{
+	BP_HostPort		= 59011,	/**< The port the protocol processor under test listens on. */
+	BP_ClientPort	= 59010		/**< The port the protocol processor under test sends to. Nobody listens on it. */
+};
+
+/**
+ * Protocol processor listener that discards everything it receives, to measure the receiving side only.
+ */
+class DiscardingListener : public ProtocolProcessor_Abstract::Listener
+{
+public:
+	void OnProtocolMessageReceived(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData) override
+	{
+		ignoreUnused(receiver, id, msgData);
+	}
+};
+
+/**
+ * Helper to create the configuration of an OSC protocol talking to the loopback interface.
+ *
+ * @param PId	The id of the protocol.
+ * @return	The protocol configuration.
+ */
+static ProcessingEngineConfig::ProtocolData CreateLoopbackProtocolData(ProtocolId PId)
+{
+	ProcessingEngineConfig::ProtocolData protocolData;
+	protocolData.Id = PId;
+	protocolData.Type = PT_OSCProtocol;
+	protocolData.IpAddress = "127.0.0.1";
+	protocolData.ClientPort = BP_ClientPort;
+	protocolData.HostPort = BP_HostPort;
+	protocolData.UsesActiveRemoteObjects = false;
+	protocolData.PollingInterval = ET_DefaultPollingRate;
+	protocolData.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+	protocolData.BundleWindow = 0;
+	protocolData.BundleMTU = EBS_DefaultBundleMTU;
+	protocolData.CoalescingInterval = 0;
+	protocolData.RateLimit = 0;
+	protocolData.RateBurst = EBS_DefaultRateBurst;
+	protocolData.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
+
+	return protocolData;
+}
+
+/**
+ * Helper to create the message data of a source position with the given values.
+ *
+ * @param values	The two xy values, referred to by the returned message data.
+ * @param source	The source (channel) to address.
+ * @return	The message data.
+ */
+static RemoteObjectMessageData CreatePositionMessageData(float* values, int16 source)
+{
+	RemoteObjectMessageData msgData;
+	msgData.addrVal = RemoteObjectAddressing(source, 1);
+	msgData.valType = ROVT_FLOAT;
+	msgData.valCount = 2;
+	msgData.payload = values;
+	msgData.payloadSize = 2 * sizeof(float);
+
+	return msgData;
+}
+
+/**
+ * Benchmarks of parsing received OSC packets: the raw decoder that handles known addresses
+ * and the receive handlers of OSCProtocolProcessor that classify the messages and forward them to the node.
+ *
+ * @param benchmark	The benchmark to run the cases with.
+ */
+static void RunReceiveBenchmarks(MicroBenchmark& benchmark)
+{
+	float values[2] = { 0.25f, 0.75f };
+	RemoteObjectMessageData msgData = CreatePositionMessageData(values, 1);
+
+	OSCMessageEncoder encoder;
+	char message[256];
+	size_t messageSize = encoder.EncodeMessage(ROI_SoundObject_Position_XY, msgData, message, sizeof(message));
+
+	// a typical console bundle, carrying the positions of several sources
+	OSCBundlePacker packer;
+	for (int16 source = 1; source <= 8; ++source)
+	{
+		char bundleMessage[256];
+		RemoteObjectMessageData sourceData = CreatePositionMessageData(values, source);
+		size_t bundleMessageSize = encoder.EncodeMessage(ROI_SoundObject_Position_XY, sourceData, bundleMessage, sizeof(bundleMessage));
+		packer.AddMessage(bundleMessage, bundleMessageSize);
+	}
+	size_t bundleSize = 0;
+	const char* bundle = packer.GetPacket(bundleSize);
+
+	int decodedCount = 0;
+	benchmark.Run("OSCRawMessageDecoder::DecodePacket message", [&]()
+	{
+		OSCRawMessageDecoder::DecodePacket(message, messageSize, [&decodedCount](RemoteObjectMessageCopy&) { ++decodedCount; });
+	});
+	benchmark.Run("OSCRawMessageDecoder::DecodePacket bundle of 8", [&]()
+	{
+		OSCRawMessageDecoder::DecodePacket(bundle, bundleSize, [&decodedCount](RemoteObjectMessageCopy&) { ++decodedCount; });
+	});
+
+	DiscardingListener listener;
+	OSCProtocolProcessor processor(BP_HostPort);
+	processor.AddListener(&listener);
+	processor.SetProtocolConfigurationData(CreateLoopbackProtocolData(1), Array<RemoteObject>(), 1, 1);
+
+	SenderEndpoint sender = SenderEndpoint::fromString("127.0.0.1", BP_ClientPort);
+	benchmark.Run("OSCProtocolProcessor::oscRawDataReceived message", [&]()
+	{
+		processor.oscRawDataReceived(message, messageSize, sender);
+	});
+	benchmark.Run("OSCProtocolProcessor::oscRawDataReceived bundle of 8", [&]()
+	{
+		processor.oscRawDataReceived(bundle, bundleSize, sender);
+	});
+
+	OSCMessage oscMessage(OSCAddressPattern(String(OSCAddressTable::GetAddress(ROI_SoundObject_Position_XY)) + "/1/1"), values[0], values[1]);
+	String senderAddress("127.0.0.1");
+	int senderPort = BP_ClientPort;
+	benchmark.Run("OSCProtocolProcessor::oscMessageReceived", [&]()
+	{
+		processor.oscMessageReceived(oscMessage, senderAddress, senderPort);
+	});
+}
+
+/**
+ * Benchmarks of serializing and sending messages.
+ *
+ * @param benchmark	The benchmark to run the cases with.
+ */
+static void RunSendBenchmarks(MicroBenchmark& benchmark)
+{
+	float values[2] = { 0.25f, 0.75f };
+	RemoteObjectMessageData msgData = CreatePositionMessageData(values, 1);
+
+	OSCMessageEncoder encoder;
+	char message[256];
+	benchmark.Run("OSCMessageEncoder::EncodeMessage", [&]()
+	{
+		encoder.EncodeMessage(ROI_SoundObject_Position_XY, msgData, message, sizeof(message));
+	});
+
+	OSCProtocolProcessor processor(BP_HostPort);
+	processor.SetProtocolConfigurationData(CreateLoopbackProtocolData(1), Array<RemoteObject>(), 1, 1);
+	if (!processor.Start())
+	{
+		std::cerr << "OSCProtocolProcessor could not be started, skipping the send benchmark" << std::endl;
+		return;
+	}
+
+	// every message is sent as it would be when the node processes a single received message
+	int source = 0;
+	benchmark.Run("OSCProtocolProcessor::SendMessage + FlushPendingMessages", [&]()
+	{
+		msgData.addrVal.first = static_cast<int16>(1 + (source++ & 63));
+		processor.SendMessage(ROI_SoundObject_Position_XY, msgData);
+		processor.FlushPendingMessages();
+	});
+
+	processor.Stop();
+}
+
+/**
+ * Benchmarks of the object data handling modes on the forwarding path.
+ * The handling objects belong to a node whose protocols are not started, so forwarding to them ends right away
+ * and only the handling itself is measured.
+ *
+ * @param benchmark	The benchmark to run the cases with.
+ */
+static void RunObjectDataHandlingBenchmarks(MicroBenchmark& benchmark)
+{
+	// a node with two role A and two role B protocols, with 64 channels per role A and 128 per role B protocol
+	ProcessingEngineConfig config;
+	config.Clear();
+	config.AddDefaultNode();
+	NodeId NId = config.GetNodeIds()[0];
+	config.AddDefaultProtocolA(NId);
+	config.AddDefaultProtocolB(NId);
+
+	ProcessingEngineConfig::ObjectHandlingData ohData = config.GetObjectHandlingData(NId);
+	ohData.ACnt = 64;
+	ohData.BCnt = 128;
+	ohData.Prec = 0.001;
+	config.SetObjectHandlingData(NId, ohData);
+
+	ProcessingEngineNode node;
+	node.SetNodeConfiguration(config, NId);
+
+	Array<ProtocolId> PAIds = config.GetProtocolAIds(NId);
+	Array<ProtocolId> PBIds = config.GetProtocolBIds(NId);
+	auto setupHandling = [&](ObjectDataHandling_Abstract& handling)
+	{
+		handling.SetObjectHandlingConfiguration(config, NId);
+		for (ProtocolId PAId : PAIds)
+			handling.AddProtocolAId(PAId);
+		for (ProtocolId PBId : PBIds)
+			handling.AddProtocolBId(PBId);
+	};
+
+	// the handling modes may modify the message data they forward, so it is set up again for every message
+	float values[2] = { 0.25f, 0.75f };
+	ProtocolId PAId = PAIds[PAIds.size() - 1];
+
+	Forward_only_valueChanges valueFilter(&node);
+	setupHandling(valueFilter);
+	benchmark.Run("Forward_only_valueChanges (IsChangedDataValue) unchanged", [&]()
+	{
+		RemoteObjectMessageData msgData = CreatePositionMessageData(values, 1);
+		valueFilter.OnReceivedMessageFromProtocol(PAId, ROI_SoundObject_Position_XY, msgData);
+	});
+	benchmark.Run("Forward_only_valueChanges (IsChangedDataValue) changed", [&]()
+	{
+		values[0] = values[0] < 0.5f ? 0.75f : 0.25f;
+		RemoteObjectMessageData msgData = CreatePositionMessageData(values, 1);
+		valueFilter.OnReceivedMessageFromProtocol(PAId, ROI_SoundObject_Position_XY, msgData);
+	});
+
+	Mux_nA_to_mB_withValFilter muxFilter(&node);
+	setupHandling(muxFilter);
+	int source = 0;
+	benchmark.Run("Mux_nA_to_mB_withValFilter (GetTargetProtocolsAndSource)", [&]()
+	{
+		values[0] = values[0] < 0.5f ? 0.75f : 0.25f;
+		RemoteObjectMessageData msgData = CreatePositionMessageData(values, static_cast<int16>(1 + (source++ & 63)));
+		muxFilter.OnReceivedMessageFromProtocol(PAId, ROI_SoundObject_Position_XY, msgData);
+	});
+
+	Remap_A_X_Y_to_B_XY_Handling remap(&node);
+	setupHandling(remap);
+	benchmark.Run("Remap_A_X_Y_to_B_XY_Handling::OnReceivedMessageFromProtocol", [&]()
+	{
+		RemoteObjectMessageData msgData = CreatePositionMessageData(values, static_cast<int16>(1 + (source++ & 63)));
+		msgData.valCount = 1;
+		msgData.payloadSize = sizeof(float);
+		remap.OnReceivedMessageFromProtocol(PAId, ROI_SoundObject_Position_X, msgData);
+	});
+}
+
+/**
+ * Entry point of the micro benchmark console application.
+ * Usage: RemoteProtocolBridgeBenchmark [name filter] [--min-time <ms per case>]
+ */
+int main(int argc, char* argv[])
+{
+	String filter;
+	double minRunTime = 500.0;
+	for (int i = 1; i < argc; ++i)
+	{
+		String arg(argv[i]);
+		if (arg == "--min-time" && i + 1 < argc)
+			minRunTime = String(argv[++i]).getDoubleValue();
+		else
+			filter = arg;
+	}
+
+	MicroBenchmark benchmark(filter, minRunTime);
+
+	RunReceiveBenchmarks(benchmark);
+	RunSendBenchmarks(benchmark);
+	RunObjectDataHandlingBenchmarks(benchmark);
+
+	std::cout << benchmark.GetReport();
+
+	DeletedAtShutdown::deleteAll();
+	MessageManager::deleteInstance();
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#include "MicroBenchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+/**
+ * Count of all heap allocations done through the global operator new since the process started.
+ */
+static std::atomic<uint64> s_allocationCount(0);
+
+/**
+ * Replacements of the global allocation functions, counting every allocation.
+ * The array and nothrow variants of the standard library forward to these.
+ */
+void* operator new(std::size_t size)
+{
+	++s_allocationCount;
+
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+
+// **************************************************************************************
+//    class MicroBenchmark
+// **************************************************************************************
+/**
+ * Constructor
+ *
+ * @param filter		Only benchmark cases whose name contains this string are run. Empty to run all cases.
+ * @param minRunTime	The min. time in ms every benchmark case is measured for.
+ */
+MicroBenchmark::MicroBenchmark(const String& filter, double minRunTime)
+	: m_filter(filter),
+	m_minRunTime(minRunTime)
+{
+}
+
+/**
+ * Destructor
+ */
+MicroBenchmark::~MicroBenchmark()
+{
+}
+
+/**
+ * Method to measure a benchmark case, if it matches the filter.
+ * The operation is run in batches of doubling size until a batch takes at least the min. run time,
+ * the result is taken from that last batch only, to keep the timer resolution and warm up effects out of it.
+ *
+ * @param name		The name of the benchmark case.
+ * @param operation	The operation to measure. Has to leave its state ready to be run again.
+ */
+void MicroBenchmark::Run(const String& name, const std::function<void()>& operation)
+{
+	if (m_filter.isNotEmpty() && !name.containsIgnoreCase(m_filter))
+		return;
+
+	// warm up caches, lazily allocated state and branch predictors
+	for (int i = 0; i < 1000; ++i)
+		operation();
+
+	int64 iterations = 1000;
+	while (true)
+	{
+		uint64 allocationsBefore = GetAllocationCount();
+		double startTime = Time::getMillisecondCounterHiRes();
+
+		for (int64 i = 0; i < iterations; ++i)
+			operation();
+
+		double elapsed = Time::getMillisecondCounterHiRes() - startTime;
+		uint64 allocations = GetAllocationCount() - allocationsBefore;
+
+		if (elapsed >= m_minRunTime)
+		{
+			Result result;
+			result.Name = name;
+			result.Iterations = iterations;
+			result.NsPerOp = elapsed * 1000000.0 / double(iterations);
+			result.AllocsPerOp = double(allocations) / double(iterations);
+			m_results.push_back(result);
+
+			return;
+		}
+
+		iterations *= 2;
+	}
+}
+
+/**
+ * Getter for the results of the benchmark cases run so far.
+ *
+ * @return	The results, in the order the cases were run.
+ */
+const std::vector<MicroBenchmark::Result>& MicroBenchmark::GetResults() const
+{
+	return m_results;
+}
+
+/**
+ * Method to format the results of the benchmark cases run so far as a table.
+ *
+ * @return	The table, one line per benchmark case.
+ */
+String MicroBenchmark::GetReport() const
+{
+	int nameWidth = 9;
+	for (const Result& result : m_results)
+		nameWidth = jmax(nameWidth, result.Name.length());
+
+	String report = String("Benchmark").paddedRight(' ', nameWidth) + String("ns/op").paddedLeft(' ', 12) + String("allocs/op").paddedLeft(' ', 12) + String("iterations").paddedLeft(' ', 14) + "\n";
+	for (const Result& result : m_results)
+	{
+		report += result.Name.paddedRight(' ', nameWidth)
+			+ String(result.NsPerOp, 1).paddedLeft(' ', 12)
+			+ String(result.AllocsPerOp, 3).paddedLeft(' ', 12)
+			+ String(result.Iterations).paddedLeft(' ', 14) + "\n";
+	}
+
+	return report;
+}
+
+/**
+ * Getter for the number of heap allocations since the process started.
+ *
+ * @return	The allocation count.
+ */
+uint64 MicroBenchmark::GetAllocationCount()
+{
+	return s_allocationCount.load();
+}
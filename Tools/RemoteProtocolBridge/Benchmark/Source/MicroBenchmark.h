@@ -0,0 +1,81 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <functional>
+#include <vector>
+
+
+/**
+ * Class MicroBenchmark runs single operations of the message hot path repeatedly and measures
+ * their average duration and the number of heap allocations they cause.
+ * Allocations are counted by replacing the global operator new in MicroBenchmark.cpp,
+ * so every allocation of the process is seen, incl. those of JUCE and the standard library.
+ */
+class MicroBenchmark
+{
+public:
+	/**
+	 * The measurement result of a single benchmark case.
+	 */
+	struct Result
+	{
+		String	Name;			/**< The name of the benchmark case. */
+		int64	Iterations;		/**< The number of times the operation was run for the measurement. */
+		double	NsPerOp;		/**< The average duration of the operation in ns. */
+		double	AllocsPerOp;	/**< The average number of heap allocations of the operation. */
+	};
+
+public:
+	MicroBenchmark(const String& filter, double minRunTime);
+	~MicroBenchmark();
+
+	void Run(const String& name, const std::function<void()>& operation);
+	const std::vector<Result>& GetResults() const;
+	String GetReport() const;
+
+	static uint64 GetAllocationCount();
+
+private:
+	String				m_filter;		/**< Only benchmark cases whose name contains this string are run. Empty to run all cases. */
+	double				m_minRunTime;	/**< The min. time in ms every benchmark case is measured for. */
+	std::vector<Result>	m_results;		/**< The results of the benchmark cases run so far. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MicroBenchmark)
+};
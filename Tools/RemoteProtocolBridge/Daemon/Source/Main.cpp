@@ -0,0 +1,283 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include <JuceHeader.h>
+
+#include "../../Source/ProcessingEngine.h"
+#include "../../Source/ProcessingEngineConfig.h"
+
+#include <csignal>
+#include <iostream>
+
+
+/**
+ * Flags set by the signal handlers, to be picked up on the message thread.
+ * Signal handlers may only touch lock-free atomic flags, everything else is done by the SignalPollTimer.
+ */
+static volatile std::sig_atomic_t s_stopRequested = 0;
+static volatile std::sig_atomic_t s_reloadRequested = 0;
+
+/**
+ * Signal handler for the signals that shall stop the daemon (SIGINT, SIGTERM).
+ *
+ * @param signal	The signal that was raised.
+ */
+static void HandleStopSignal(int signal)
+{
+	ignoreUnused(signal);
+	s_stopRequested = 1;
+}
+
+/**
+ * Signal handler for the signal that shall reload the configuration (SIGHUP).
+ *
+ * @param signal	The signal that was raised.
+ */
+static void HandleReloadSignal(int signal)
+{
+	ignoreUnused(signal);
+	s_reloadRequested = 1;
+}
+
+
+/**
+ * Class RemoteProtocolBridgeDaemon is the headless console application of the RemoteProtocolBridge.
+ * It loads the configuration from the file given on the command line and runs the ProcessingEngine
+ * without any user interface, until it is stopped by SIGINT/SIGTERM. SIGHUP reloads the configuration file.
+ * It derives from JUCEApplicationBase instead of JUCEApplication, to not depend on the JUCE gui modules.
+ */
+class RemoteProtocolBridgeDaemon : public JUCEApplicationBase
+{
+public:
+	RemoteProtocolBridgeDaemon() : m_signalPollTimer(*this) {}
+
+	const String getApplicationName() override       { return ProjectInfo::projectName; }	/**< JUCE default implementation to get project name from projucer configuration. */
+	const String getApplicationVersion() override    { return ProjectInfo::versionString; }	/**< JUCE default implementation to get version string from projucer configuration. */
+	bool moreThanOneInstanceAllowed() override       { return true; }						/**< Several daemon instances with different configurations may run side by side. */
+
+	/**
+	 * Initialization of the daemon. Parses the command line, loads the configuration and starts the engine.
+	 *
+	 * @param commandLine	The command line the daemon was started with.
+	 */
+	void initialise(const String& commandLine) override
+	{
+		StringArray args = StringArray::fromTokens(commandLine, true);
+		args.trim();
+		args.removeEmptyStrings();
+
+		if (args.contains("--help") || args.contains("-h") || args.size() != 1)
+		{
+			std::cout << "Usage: " << getApplicationName() << " <path to " << CONFIGURATION_FILE << ">" << std::endl;
+			std::cout << "SIGINT/SIGTERM stop the engine and quit, SIGHUP reloads the configuration file." << std::endl;
+			setApplicationReturnValue(args.size() == 1 ? 0 : 1);
+			quit();
+			return;
+		}
+
+		m_config.SetConfigFile(File::getCurrentWorkingDirectory().getChildFile(args[0].unquoted()));
+		if (!ReadConfig(m_config) || !StartEngine(m_config))
+		{
+			setApplicationReturnValue(1);
+			quit();
+			return;
+		}
+
+		std::signal(SIGINT, HandleStopSignal);
+		std::signal(SIGTERM, HandleStopSignal);
+#ifdef SIGHUP
+		std::signal(SIGHUP, HandleReloadSignal);
+#endif
+
+		m_signalPollTimer.startTimer(ET_DaemonSignalPollInterval);
+	}
+
+	/**
+	 * Shutdown of the daemon. Stops the engine.
+	 */
+	void shutdown() override
+	{
+		m_signalPollTimer.stopTimer();
+
+		if (m_engine.IsRunning())
+			m_engine.Stop();
+	}
+
+	/**
+	 * Handling of system quit request
+	 */
+	void systemRequestedQuit() override
+	{
+		quit();
+	}
+
+	void anotherInstanceStarted(const String& commandLine) override { ignoreUnused(commandLine); }		/**< Nothing to do for other instances, they run with their own configuration. */
+	void suspended() override {}																		/**< Not relevant for a daemon. */
+	void resumed() override {}																			/**< Not relevant for a daemon. */
+
+	/**
+	 * Handling of unhandled exceptions. Logs the exception and quits with an error return value.
+	 *
+	 * @param e				The exception, if it is a std::exception.
+	 * @param sourceFilename	The source file the exception was thrown in.
+	 * @param lineNumber	The line the exception was thrown at.
+	 */
+	void unhandledException(const std::exception* e, const String& sourceFilename, int lineNumber) override
+	{
+		std::cerr << "Unhandled exception" << (e != nullptr ? String(": ") + e->what() : String()) << " (" << sourceFilename << ":" << lineNumber << ")" << std::endl;
+		setApplicationReturnValue(1);
+		quit();
+	}
+
+private:
+	/**
+	 * Timer to pick up the flags set by the signal handlers on the message thread.
+	 */
+	class SignalPollTimer : public Timer
+	{
+	public:
+		SignalPollTimer(RemoteProtocolBridgeDaemon& daemon) : m_daemon(daemon) {}
+		void timerCallback() override { m_daemon.OnSignalPoll(); }
+
+	private:
+		RemoteProtocolBridgeDaemon& m_daemon;
+	};
+
+	/**
+	 * Method to (re)read the configuration file into the given configuration object and validate it.
+	 *
+	 * @param config	The configuration object to read the configuration file of into.
+	 * @return	True if the configuration was read and defines at least one node.
+	 */
+	bool ReadConfig(ProcessingEngineConfig& config)
+	{
+		if (!config.GetConfigFile().existsAsFile())
+		{
+			std::cerr << "Configuration file " << config.GetConfigFile().getFullPathName() << " does not exist" << std::endl;
+			return false;
+		}
+
+		config.Clear();
+		if (!config.ReadConfiguration())
+		{
+			std::cerr << "Configuration file " << config.GetConfigFile().getFullPathName() << " could not be read" << std::endl;
+			return false;
+		}
+
+		if (config.GetNodeIds().isEmpty())
+		{
+			std::cerr << "Configuration file " << config.GetConfigFile().getFullPathName() << " does not define any node" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	/**
+	 * Method to start the engine with the given configuration. If the engine fails to start, what was started of it is stopped again.
+	 *
+	 * @param config	The configuration to start the engine with.
+	 * @return	True if the engine started.
+	 */
+	bool StartEngine(ProcessingEngineConfig& config)
+	{
+		m_engine.SetConfig(config);
+		if (!m_engine.Start())
+		{
+			std::cerr << "Engine failed to start with configuration " << config.GetConfigFile().getFullPathName() << std::endl;
+			m_engine.Stop();
+			return false;
+		}
+
+		std::cout << "Engine started with configuration " << config.GetConfigFile().getFullPathName() << std::endl;
+		return true;
+	}
+
+	/**
+	 * Method to reload the configuration file. The engine is only restarted once the new configuration was read and validated,
+	 * otherwise it keeps running with the previous configuration. If the engine fails to start with the new configuration,
+	 * it is restarted with the previous one.
+	 */
+	void ReloadConfig()
+	{
+		std::cout << "Reloading configuration" << std::endl;
+
+		ProcessingEngineConfig newConfig;
+		newConfig.SetConfigFile(m_config.GetConfigFile());
+		if (!ReadConfig(newConfig))
+		{
+			std::cerr << "Keeping the previous configuration" << std::endl;
+			return;
+		}
+
+		if (m_engine.IsRunning())
+			m_engine.Stop();
+
+		if (StartEngine(newConfig))
+		{
+			m_config.Clear();
+			m_config = newConfig;
+			return;
+		}
+
+		std::cerr << "Restarting the engine with the previous configuration" << std::endl;
+		StartEngine(m_config);
+	}
+
+	/**
+	 * Method to handle the signals that were raised since the last call. Called by the SignalPollTimer.
+	 */
+	void OnSignalPoll()
+	{
+		if (s_stopRequested)
+		{
+			m_signalPollTimer.stopTimer();
+			quit();
+			return;
+		}
+
+		if (s_reloadRequested)
+		{
+			s_reloadRequested = 0;
+			ReloadConfig();
+		}
+	}
+
+	ProcessingEngineConfig	m_config;			/**< The configuration the engine is run with. */
+	ProcessingEngine		m_engine;			/**< The engine that does the actual protocol bridging. */
+	SignalPollTimer			m_signalPollTimer;	/**< Timer to handle the raised signals on the message thread. */
+};
+
+START_JUCE_APPLICATION (RemoteProtocolBridgeDaemon)
@@ -0,0 +1,195 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#include "ConsoleGenerator.h"
+
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCMessageEncoder.h"
+
+
+// **************************************************************************************
+//    class ConsoleGenerator
+// **************************************************************************************
+/**
+ * Constructor of the generator. Preallocates the send time storage for all messages to be sent.
+ *
+ * @param streamIndex	The index of this generator stream, below 256.
+ * @param targetAddress	The ip address of the bridge to send to.
+ * @param targetPort	The port the role A protocol of the bridge listens on.
+ * @param objectCount	The number of sources the messages cycle through.
+ * @param rate			The send rate in messages per second.
+ * @param messageCount	The total number of messages to send, below 2^24.
+ */
+ConsoleGenerator::ConsoleGenerator(int streamIndex, const String& targetAddress, int targetPort, int objectCount, int rate, int messageCount)
+	: Thread("LoadTest Console " + String(streamIndex)),
+	m_streamIndex(streamIndex),
+	m_targetAddress(targetAddress),
+	m_targetPort(targetPort),
+	m_objectCount(jmax(1, objectCount)),
+	m_rate(jmax(1, rate)),
+	m_sendTimes(static_cast<size_t>(jlimit(0, static_cast<int>(SequenceScale) - 1, messageCount))),
+	m_sentCount(0)
+{
+	jassert(streamIndex >= 0 && streamIndex < static_cast<int>(StreamScale));
+
+	for (auto& sendTime : m_sendTimes)
+		sendTime = 0.0;
+}
+
+/**
+ * Destructor
+ */
+ConsoleGenerator::~ConsoleGenerator()
+{
+	stopThread(1000);
+}
+
+/**
+ * Getter for the index of this generator stream.
+ *
+ * @return	The stream index.
+ */
+int ConsoleGenerator::GetStreamIndex() const
+{
+	return m_streamIndex;
+}
+
+/**
+ * Getter for the number of messages sent so far.
+ *
+ * @return	The number of sent messages.
+ */
+int ConsoleGenerator::GetSentCount() const
+{
+	return m_sentCount.load();
+}
+
+/**
+ * Getter for the total number of messages this generator sends.
+ *
+ * @return	The total number of messages.
+ */
+int ConsoleGenerator::GetMessageCount() const
+{
+	return static_cast<int>(m_sendTimes.size());
+}
+
+/**
+ * Getter for the time a message was sent at. Safe to be called from any thread.
+ *
+ * @param sequenceNumber	The sequence number of the message.
+ * @return	The send time in ms (Time::getMillisecondCounterHiRes), 0 if the message was not sent.
+ */
+double ConsoleGenerator::GetSendTime(int sequenceNumber) const
+{
+	if (sequenceNumber < 0 || sequenceNumber >= GetMessageCount())
+		return 0.0;
+
+	return m_sendTimes[static_cast<size_t>(sequenceNumber)].load();
+}
+
+/**
+ * Helper method to encode a stream index and sequence number into the xy values of a message.
+ *
+ * @param streamIndex		The index of the sending generator stream.
+ * @param sequenceNumber	The sequence number of the message.
+ * @param values			The two float values to write.
+ */
+void ConsoleGenerator::EncodeValues(int streamIndex, int sequenceNumber, float* values)
+{
+	values[0] = static_cast<float>(sequenceNumber) / SequenceScale;
+	values[1] = static_cast<float>(streamIndex) / StreamScale;
+}
+
+/**
+ * Helper method to decode the stream index and sequence number from the xy values of a received message.
+ *
+ * @param values			The two float values of the message.
+ * @param streamIndex		The decoded index of the sending generator stream.
+ * @param sequenceNumber	The decoded sequence number of the message.
+ * @return	True if the values could have been sent by a generator, false if not.
+ */
+bool ConsoleGenerator::DecodeValues(const float* values, int& streamIndex, int& sequenceNumber)
+{
+	if (values[0] < 0.0f || values[0] >= 1.0f || values[1] < 0.0f || values[1] >= 1.0f)
+		return false;
+
+	sequenceNumber = static_cast<int>(values[0] * SequenceScale);
+	streamIndex = static_cast<int>(values[1] * StreamScale);
+
+	return true;
+}
+
+/**
+ * Reimplemented from Thread to send all messages at the configured rate.
+ * Messages that are due are sent in a burst every millisecond, to keep the rate
+ * independent of the sleep granularity of the system.
+ */
+void ConsoleGenerator::run()
+{
+	DatagramSocket socket;
+	if (!socket.bindToPort(0))
+		return;
+
+	OSCMessageEncoder encoder;
+	char buffer[256];
+	float values[2];
+
+	RemoteObjectMessageData msgData;
+	msgData.valType = ROVT_FLOAT;
+	msgData.valCount = 2;
+	msgData.payload = values;
+	msgData.payloadSize = sizeof(values);
+
+	double startTime = Time::getMillisecondCounterHiRes();
+	int messageCount = GetMessageCount();
+	int sequenceNumber = 0;
+	while (!threadShouldExit() && sequenceNumber < messageCount)
+	{
+		int dueCount = jmin(messageCount, static_cast<int>((Time::getMillisecondCounterHiRes() - startTime) * m_rate / 1000.0));
+		for (; sequenceNumber < dueCount; ++sequenceNumber)
+		{
+			msgData.addrVal = RemoteObjectAddressing(static_cast<int16>(1 + sequenceNumber % m_objectCount), 1);
+			EncodeValues(m_streamIndex, sequenceNumber, values);
+
+			size_t size = encoder.EncodeMessage(ROI_SoundObject_Position_XY, msgData, buffer, sizeof(buffer));
+			m_sendTimes[static_cast<size_t>(sequenceNumber)] = Time::getMillisecondCounterHiRes();
+			socket.write(m_targetAddress, m_targetPort, buffer, static_cast<int>(size));
+			m_sentCount = sequenceNumber + 1;
+		}
+
+		wait(1);
+	}
+}
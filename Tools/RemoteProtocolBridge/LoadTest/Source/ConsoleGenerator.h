@@ -0,0 +1,83 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#pragma once
+
+#include "../../Source/RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <vector>
+
+
+/**
+ * Class ConsoleGenerator emulates a console sending source position changes to a role A OSC protocol of the bridge.
+ * It sends ROI_SoundObject_Position_XY messages over UDP at a fixed rate, cycling through the configured number of sources.
+ * Every message carries a unique value, so the DS100Emulator can tell which message it received and how long it took:
+ * x is the message sequence number scaled to [0, 1), y is the index of the generator stream that sent it.
+ */
+class ConsoleGenerator : public Thread
+{
+public:
+	ConsoleGenerator(int streamIndex, const String& targetAddress, int targetPort, int objectCount, int rate, int messageCount);
+	~ConsoleGenerator() override;
+
+	int GetStreamIndex() const;
+	int GetSentCount() const;
+	int GetMessageCount() const;
+	double GetSendTime(int sequenceNumber) const;
+
+	static void EncodeValues(int streamIndex, int sequenceNumber, float* values);
+	static bool DecodeValues(const float* values, int& streamIndex, int& sequenceNumber);
+
+	//==============================================================================
+	void run() override;
+
+private:
+	static constexpr float	SequenceScale = 16777216.0f;	/**< Scale of the sequence number in x, 2^24 keeps every sequence number exactly representable in a float. */
+	static constexpr float	StreamScale = 256.0f;			/**< Scale of the stream index in y. */
+
+	int									m_streamIndex;		/**< The index of this generator stream, to be told apart from the other streams by the emulator. */
+	String								m_targetAddress;	/**< The ip address of the bridge to send to. */
+	int									m_targetPort;		/**< The port the role A protocol of the bridge listens on. */
+	int									m_objectCount;		/**< The number of sources the messages cycle through. */
+	int									m_rate;				/**< The send rate in messages per second. */
+	std::vector<std::atomic<double>>	m_sendTimes;		/**< The send time in ms per sequence number, 0 for messages not sent yet. */
+	std::atomic<int>					m_sentCount;		/**< The number of messages sent so far. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConsoleGenerator)
+};
@@ -0,0 +1,267 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#include "DS100Emulator.h"
+
+#include "ConsoleGenerator.h"
+
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCAddressTable.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCRawMessageDecoder.h"
+
+
+// **************************************************************************************
+//    class DS100Emulator
+// **************************************************************************************
+/**
+ * Constructor of the emulator. Preallocates the bookkeeping for all messages the given generators send.
+ *
+ * @param bridgeAddress	The ip address of the bridge to send poll answers to.
+ * @param listenPort	The port the bridge sends to (the client port of the role B protocol).
+ * @param replyPort		The port the role B protocol of the bridge listens on (its host port).
+ * @param generators	The generators that feed the bridge node, indexed by their stream index.
+ */
+DS100Emulator::DS100Emulator(const String& bridgeAddress, int listenPort, int replyPort, const Array<ConsoleGenerator*>& generators)
+	: Thread("LoadTest DS100 " + String(listenPort)),
+	m_bridgeAddress(bridgeAddress),
+	m_listenPort(listenPort),
+	m_replyPort(replyPort),
+	m_generators(generators),
+	m_duplicateCount(0),
+	m_pollCount(0),
+	m_malformedCount(0)
+{
+	int totalCount = 0;
+	for (ConsoleGenerator* generator : m_generators)
+	{
+		m_received.push_back(std::vector<bool>(static_cast<size_t>(generator->GetMessageCount()), false));
+		totalCount += generator->GetMessageCount();
+	}
+
+	m_latencies.reserve(static_cast<size_t>(totalCount));
+}
+
+/**
+ * Destructor
+ */
+DS100Emulator::~DS100Emulator()
+{
+	stopThread(1000);
+}
+
+/**
+ * Method to bind the emulator to its listening port. To be called before the bridge is started.
+ *
+ * @return	True on success, false if the port is not available.
+ */
+bool DS100Emulator::Bind()
+{
+	return m_socket.bindToPort(m_listenPort);
+}
+
+/**
+ * Getter for the number of distinct generator messages that were received.
+ * Only to be called while the thread is not running.
+ *
+ * @return	The number of received messages.
+ */
+int DS100Emulator::GetReceivedCount() const
+{
+	return static_cast<int>(m_latencies.size());
+}
+
+/**
+ * Getter for the number of generator messages that were received more than once.
+ * Only to be called while the thread is not running.
+ *
+ * @return	The number of duplicates.
+ */
+int DS100Emulator::GetDuplicateCount() const
+{
+	return m_duplicateCount;
+}
+
+/**
+ * Getter for the number of generator messages that were sent, but not received.
+ * Only to be called while the thread is not running.
+ *
+ * @return	The number of missing messages.
+ */
+int DS100Emulator::GetMissingCount() const
+{
+	int sentCount = 0;
+	for (ConsoleGenerator* generator : m_generators)
+		sentCount += generator->GetSentCount();
+
+	return sentCount - GetReceivedCount();
+}
+
+/**
+ * Getter for the number of polls that were answered.
+ * Only to be called while the thread is not running.
+ *
+ * @return	The number of answered polls.
+ */
+int DS100Emulator::GetPollCount() const
+{
+	return m_pollCount;
+}
+
+/**
+ * Getter for the number of received packets that could not be decoded.
+ * Only to be called while the thread is not running.
+ *
+ * @return	The number of malformed packets.
+ */
+int DS100Emulator::GetMalformedCount() const
+{
+	return m_malformedCount;
+}
+
+/**
+ * Getter for the measured forwarding latencies, sorted ascending to read percentiles from.
+ * Only to be called while the thread is not running.
+ *
+ * @return	The sorted latencies in ms.
+ */
+std::vector<float> DS100Emulator::GetSortedLatencies() const
+{
+	std::vector<float> latencies(m_latencies);
+	std::sort(latencies.begin(), latencies.end());
+
+	return latencies;
+}
+
+/**
+ * Reimplemented from Thread to receive and handle the packets the bridge sends, until the thread is stopped.
+ */
+void DS100Emulator::run()
+{
+	char buffer[65536];
+
+	while (!threadShouldExit())
+	{
+		if (m_socket.waitUntilReady(true, 50) != 1)
+			continue;
+
+		int size = m_socket.read(buffer, sizeof(buffer), false);
+		if (size <= 0)
+			continue;
+
+		double receiveTime = Time::getMillisecondCounterHiRes();
+
+		OSCRawMessageDecoder::DecodeResult result = OSCRawMessageDecoder::DecodePacket(buffer, static_cast<size_t>(size), [this, receiveTime](RemoteObjectMessageCopy& message)
+		{
+			// polls are value object messages without values
+			if (message.valCount == 0 && message.addrVal.first != INVALID_ADDRESS_VALUE)
+				HandlePoll(message.Id, message.addrVal);
+			else
+				HandleWrite(message, receiveTime);
+		});
+
+		if (result == OSCRawMessageDecoder::DR_Malformed || result == OSCRawMessageDecoder::DR_UnknownAddress)
+		{
+			++m_malformedCount;
+		}
+	}
+}
+
+/**
+ * Helper method to store a value written by the bridge and to measure its latency, if it was sent by a generator.
+ *
+ * @param message		The received message.
+ * @param receiveTime	The time in ms the message was received at.
+ */
+void DS100Emulator::HandleWrite(const RemoteObjectMessageCopy& message, double receiveTime)
+{
+	if (message.valCount == 0)
+		return;
+
+	m_values[GetRemoteObjectKey(message.Id, message.addrVal)] = message;
+
+	if (message.Id != ROI_SoundObject_Position_XY || message.valType != ROVT_FLOAT || message.valCount != 2)
+		return;
+
+	int streamIndex = 0;
+	int sequenceNumber = 0;
+	if (!ConsoleGenerator::DecodeValues(message.values.floatValues, streamIndex, sequenceNumber) || streamIndex >= m_generators.size())
+		return;
+
+	std::vector<bool>& received = m_received[static_cast<size_t>(streamIndex)];
+	if (sequenceNumber >= static_cast<int>(received.size()))
+		return;
+
+	if (received[static_cast<size_t>(sequenceNumber)])
+	{
+		++m_duplicateCount;
+		return;
+	}
+
+	received[static_cast<size_t>(sequenceNumber)] = true;
+
+	double sendTime = m_generators[streamIndex]->GetSendTime(sequenceNumber);
+	if (sendTime > 0.0)
+		m_latencies.push_back(static_cast<float>(receiveTime - sendTime));
+}
+
+/**
+ * Helper method to answer a poll of the bridge with the last written value of the object, or zero values if there is none.
+ *
+ * @param Id		The remote object id that was polled.
+ * @param addrVal	The addressing of the polled object.
+ */
+void DS100Emulator::HandlePoll(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal)
+{
+	RemoteObjectMessageCopy answer;
+	std::map<uint64, RemoteObjectMessageCopy>::const_iterator valueIter = m_values.find(GetRemoteObjectKey(Id, addrVal));
+	if (valueIter != m_values.end())
+	{
+		answer = valueIter->second;
+	}
+	else
+	{
+		const OSCAddressTable::Entry& entry = OSCAddressTable::Get(Id);
+		answer.Id = Id;
+		answer.addrVal = addrVal;
+		answer.valType = entry.ValType;
+		answer.valCount = entry.ValCount;
+		memset(&answer.values, 0, sizeof(answer.values));
+	}
+
+	char buffer[256];
+	size_t size = m_encoder.EncodeMessage(Id, answer.GetMessageData(), buffer, sizeof(buffer));
+	if (size > 0 && m_socket.write(m_bridgeAddress, m_replyPort, buffer, static_cast<int>(size)) > 0)
+		++m_pollCount;
+}
@@ -0,0 +1,93 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#pragma once
+
+#include "../../Source/RemoteProtocolBridgeCommon.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCMessageEncoder.h"
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <vector>
+
+// Fwd. declarations
+class ConsoleGenerator;
+
+
+/**
+ * Class DS100Emulator emulates a DS100 connected to a role B OSC protocol of the bridge.
+ * It accepts the values written by the bridge and answers its polls with the last written value.
+ * Values that were sent by a ConsoleGenerator are matched to their send time to measure the forwarding latency.
+ */
+class DS100Emulator : public Thread
+{
+public:
+	DS100Emulator(const String& bridgeAddress, int listenPort, int replyPort, const Array<ConsoleGenerator*>& generators);
+	~DS100Emulator() override;
+
+	bool Bind();
+
+	int GetReceivedCount() const;
+	int GetDuplicateCount() const;
+	int GetMissingCount() const;
+	int GetPollCount() const;
+	int GetMalformedCount() const;
+	std::vector<float> GetSortedLatencies() const;
+
+	//==============================================================================
+	void run() override;
+
+private:
+	void HandleWrite(const RemoteObjectMessageCopy& message, double receiveTime);
+	void HandlePoll(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal);
+
+
+	DatagramSocket							m_socket;			/**< The socket the bridge sends to and the poll answers are sent from. */
+	OSCMessageEncoder						m_encoder;			/**< The encoder for the poll answers. */
+	String									m_bridgeAddress;	/**< The ip address of the bridge to send poll answers to. */
+	int										m_listenPort;		/**< The port the bridge sends to. */
+	int										m_replyPort;		/**< The port the role B protocol of the bridge listens on. */
+	Array<ConsoleGenerator*>				m_generators;		/**< The generators that feed the bridge node, indexed by their stream index. */
+	std::vector<std::vector<bool>>			m_received;			/**< Flags per generator stream and sequence number, if the message was received already. */
+	std::map<uint64, RemoteObjectMessageCopy>	m_values;		/**< The last written value per object, to answer polls with. */
+	std::vector<float>						m_latencies;		/**< The forwarding latencies in ms of the received generator messages. */
+	int										m_duplicateCount;	/**< The number of generator messages that were received more than once. */
+	int										m_pollCount;		/**< The number of polls that were answered. */
+	int										m_malformedCount;	/**< The number of received packets that could not be decoded. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DS100Emulator)
+};
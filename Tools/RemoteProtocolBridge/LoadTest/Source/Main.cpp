@@ -0,0 +1,380 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include <JuceHeader.h>
+
+#include "ConsoleGenerator.h"
+#include "DS100Emulator.h"
+
+#include "../../Source/ProcessingEngine.h"
+#include "../../Source/ProcessingEngineConfig.h"
+
+#include <iostream>
+
+
+/**
+ * Class RemoteProtocolBridgeLoadTest is a console application to measure how much message traffic a bridge configuration sustains.
+ * It runs a ProcessingEngine with the given configuration and drives every node from both sides over loopback UDP:
+ * a ConsoleGenerator per role A OSC protocol sends source positions at a fixed rate, and a DS100Emulator per role B OSC protocol
+ * answers the polls of the bridge and measures the latency of the forwarded positions.
+ * The configuration has to use 127.0.0.1 as ip address for all OSC protocols.
+ * At the end, throughput, latency percentiles and drop counts are reported per node and protocol.
+ */
+class RemoteProtocolBridgeLoadTest : public JUCEApplicationBase, private Timer
+{
+public:
+	RemoteProtocolBridgeLoadTest() : m_startTime(0.0), m_drainStartTime(0.0) {}
+
+	const String getApplicationName() override       { return ProjectInfo::projectName; }	/**< JUCE default implementation to get project name from projucer configuration. */
+	const String getApplicationVersion() override    { return ProjectInfo::versionString; }	/**< JUCE default implementation to get version string from projucer configuration. */
+	bool moreThanOneInstanceAllowed() override       { return false; }						/**< Concurrent load tests would disturb each other. */
+
+	/**
+	 * Initialization of the load test. Parses the command line, sets up generators and emulators for all nodes and starts the engine.
+	 *
+	 * @param commandLine	The command line the load test was started with.
+	 */
+	void initialise(const String& commandLine) override
+	{
+		StringArray args = StringArray::fromTokens(commandLine, true);
+		args.trim();
+		args.removeEmptyStrings();
+
+		String configPath;
+		int rate = DefaultRate;
+		int duration = DefaultDuration;
+		int objectCount = DefaultObjectCount;
+		for (int i = 0; i < args.size(); ++i)
+		{
+			if (args[i] == "--rate" && i + 1 < args.size())
+				rate = args[++i].getIntValue();
+			else if (args[i] == "--duration" && i + 1 < args.size())
+				duration = args[++i].getIntValue();
+			else if (args[i] == "--objects" && i + 1 < args.size())
+				objectCount = args[++i].getIntValue();
+			else if (configPath.isEmpty() && !args[i].startsWith("-"))
+				configPath = args[i].unquoted();
+			else
+				configPath = String();
+		}
+
+		if (configPath.isEmpty() || rate <= 0 || duration <= 0 || objectCount <= 0 || int64(rate) * duration >= MaxMessageCount)
+		{
+			std::cout << "Usage: " << getApplicationName() << " <path to " << CONFIGURATION_FILE << "> [--rate <messages/s per role A protocol>] [--duration <s>] [--objects <source count>]" << std::endl;
+			setApplicationReturnValue(1);
+			quit();
+			return;
+		}
+
+		if (!SetupNodes(File::getCurrentWorkingDirectory().getChildFile(configPath), rate, rate * duration, objectCount))
+		{
+			setApplicationReturnValue(1);
+			quit();
+			return;
+		}
+
+		m_engine.SetConfig(m_config);
+		if (!m_engine.Start())
+		{
+			std::cerr << "Engine failed to start" << std::endl;
+			setApplicationReturnValue(1);
+			quit();
+			return;
+		}
+
+		m_startTime = Time::getMillisecondCounterHiRes();
+		std::cout << "Running " << duration << " s at " << rate << " messages/s per role A protocol over " << objectCount << " sources, "
+			<< ProcessingEngineConfig::EngineThreadingModeToString(m_config.GetEngineThreadingMode()) << std::endl;
+
+		for (auto& node : m_nodes)
+		{
+			for (auto& emulator : node.Emulators)
+				emulator.second->startThread(Thread::realtimeAudioPriority);
+			for (auto& generator : node.Generators)
+				generator.second->startThread(Thread::realtimeAudioPriority);
+		}
+
+		startTimer(ProgressInterval);
+	}
+
+	/**
+	 * Shutdown of the load test. Stops everything that may still run.
+	 */
+	void shutdown() override
+	{
+		stopTimer();
+		StopTraffic();
+
+		if (m_engine.IsRunning())
+			m_engine.Stop();
+	}
+
+	/**
+	 * Handling of system quit request
+	 */
+	void systemRequestedQuit() override
+	{
+		quit();
+	}
+
+	void anotherInstanceStarted(const String& commandLine) override { ignoreUnused(commandLine); }		/**< Not relevant for the load test. */
+	void suspended() override {}																		/**< Not relevant for the load test. */
+	void resumed() override {}																			/**< Not relevant for the load test. */
+
+	/**
+	 * Handling of unhandled exceptions. Logs the exception and quits with an error return value.
+	 *
+	 * @param e				The exception, if it is a std::exception.
+	 * @param sourceFilename	The source file the exception was thrown in.
+	 * @param lineNumber	The line the exception was thrown at.
+	 */
+	void unhandledException(const std::exception* e, const String& sourceFilename, int lineNumber) override
+	{
+		std::cerr << "Unhandled exception" << (e != nullptr ? String(": ") + e->what() : String()) << " (" << sourceFilename << ":" << lineNumber << ")" << std::endl;
+		setApplicationReturnValue(1);
+		quit();
+	}
+
+private:
+	static constexpr int	DefaultRate = 1000;			/**< Default send rate in messages per second per role A protocol. */
+	static constexpr int	DefaultDuration = 10;		/**< Default send duration in seconds. */
+	static constexpr int	DefaultObjectCount = 64;	/**< Default number of sources the messages cycle through. */
+	static constexpr int	ProgressInterval = 100;		/**< Interval in ms the generators are checked to be finished in. */
+	static constexpr int	DrainTime = 1000;			/**< Time in ms to wait for messages still in flight after the generators finished. */
+	static constexpr int	MaxMessageCount = 16777216;	/**< Max. number of messages per role A protocol, limited by the sequence number encoding of the ConsoleGenerator. */
+
+	/**
+	 * The generators and emulators that drive a single node.
+	 */
+	struct NodeTraffic
+	{
+		NodeId																Id;			/**< The id of the node. */
+		std::vector<std::pair<ProtocolId, std::unique_ptr<ConsoleGenerator>>>	Generators;	/**< The generator per role A OSC protocol. */
+		std::vector<std::pair<ProtocolId, std::unique_ptr<DS100Emulator>>>	Emulators;	/**< The emulator per role B OSC protocol. */
+	};
+
+	/**
+	 * Method to read the configuration and set up generators and emulators for all OSC protocols of all nodes.
+	 *
+	 * @param configFile	The configuration file to run the test with.
+	 * @param rate			The send rate in messages per second per role A protocol.
+	 * @param messageCount	The number of messages to send per role A protocol.
+	 * @param objectCount	The number of sources the messages cycle through.
+	 * @return	True if every node has at least one role A and one role B OSC protocol on the loopback address.
+	 */
+	bool SetupNodes(const File& configFile, int rate, int messageCount, int objectCount)
+	{
+		m_config.SetConfigFile(configFile);
+		m_config.Clear();
+		if (!configFile.existsAsFile() || !m_config.ReadConfiguration())
+		{
+			std::cerr << "Configuration file " << configFile.getFullPathName() << " could not be read" << std::endl;
+			return false;
+		}
+
+		for (NodeId NId : m_config.GetNodeIds())
+		{
+			NodeTraffic node;
+			node.Id = NId;
+
+			Array<ConsoleGenerator*> generators;
+			for (ProtocolId PId : m_config.GetProtocolAIds(NId))
+			{
+				ProcessingEngineConfig::ProtocolData protocolData = m_config.GetProtocolData(NId, PId);
+				if (protocolData.Type != PT_OSCProtocol || !IsLoopback(NId, protocolData))
+					continue;
+
+				node.Generators.push_back(std::make_pair(PId, std::make_unique<ConsoleGenerator>(generators.size(), protocolData.IpAddress, protocolData.HostPort, objectCount, rate, messageCount)));
+				generators.add(node.Generators.back().second.get());
+			}
+
+			for (ProtocolId PId : m_config.GetProtocolBIds(NId))
+			{
+				ProcessingEngineConfig::ProtocolData protocolData = m_config.GetProtocolData(NId, PId);
+				if (protocolData.Type != PT_OSCProtocol || !IsLoopback(NId, protocolData))
+					continue;
+
+				node.Emulators.push_back(std::make_pair(PId, std::make_unique<DS100Emulator>(protocolData.IpAddress, protocolData.ClientPort, protocolData.HostPort, generators)));
+				if (!node.Emulators.back().second->Bind())
+				{
+					std::cerr << "Node " << int(NId) << " protocol " << int(PId) << ": port " << protocolData.ClientPort << " is not available" << std::endl;
+					return false;
+				}
+			}
+
+			if (node.Generators.empty() || node.Emulators.empty())
+			{
+				std::cerr << "Node " << int(NId) << " needs at least one role A and one role B OSC protocol" << std::endl;
+				return false;
+			}
+
+			m_nodes.push_back(std::move(node));
+		}
+
+		return !m_nodes.empty();
+	}
+
+	/**
+	 * Helper method to check that a protocol talks to the loopback address, since the test must not send to real devices.
+	 *
+	 * @param NId			The id of the node the protocol belongs to.
+	 * @param protocolData	The configuration of the protocol.
+	 * @return	True if the protocol uses the loopback address.
+	 */
+	static bool IsLoopback(NodeId NId, const ProcessingEngineConfig::ProtocolData& protocolData)
+	{
+		if (protocolData.IpAddress == "127.0.0.1")
+			return true;
+
+		std::cerr << "Node " << int(NId) << " protocol " << int(protocolData.Id) << " is skipped, it does not use 127.0.0.1" << std::endl;
+		return false;
+	}
+
+	/**
+	 * Reimplemented from Timer to wait for the generators to finish and the messages in flight to arrive.
+	 */
+	void timerCallback() override
+	{
+		for (auto& node : m_nodes)
+			for (auto& generator : node.Generators)
+				if (generator.second->isThreadRunning())
+					return;
+
+		if (m_drainStartTime == 0.0)
+			m_drainStartTime = Time::getMillisecondCounterHiRes();
+		else if (Time::getMillisecondCounterHiRes() - m_drainStartTime >= DrainTime)
+			Finish();
+	}
+
+	/**
+	 * Method to stop all generator and emulator threads.
+	 */
+	void StopTraffic()
+	{
+		for (auto& node : m_nodes)
+		{
+			for (auto& generator : node.Generators)
+				generator.second->stopThread(1000);
+			for (auto& emulator : node.Emulators)
+				emulator.second->stopThread(1000);
+		}
+	}
+
+	/**
+	 * Method to stop the test, print the report and quit.
+	 */
+	void Finish()
+	{
+		stopTimer();
+		StopTraffic();
+		m_engine.Stop();
+
+		double sendDuration = GetSendDuration();
+		bool hasDrops = false;
+		for (auto& node : m_nodes)
+		{
+			std::cout << "Node " << int(node.Id) << std::endl;
+
+			for (auto& generator : node.Generators)
+			{
+				std::cout << "  A " << int(generator.first)
+					<< "  sent " << generator.second->GetSentCount()
+					<< "  (" << String(generator.second->GetSentCount() / sendDuration, 1) << " msg/s)" << std::endl;
+			}
+
+			for (auto& emulator : node.Emulators)
+			{
+				const DS100Emulator& e = *emulator.second;
+				std::vector<float> latencies = e.GetSortedLatencies();
+
+				std::cout << "  B " << int(emulator.first)
+					<< "  received " << e.GetReceivedCount()
+					<< "  (" << String(e.GetReceivedCount() / sendDuration, 1) << " msg/s)"
+					<< "  dropped " << e.GetMissingCount()
+					<< "  duplicates " << e.GetDuplicateCount()
+					<< "  latency p50 " << String(GetPercentile(latencies, 0.5), 3)
+					<< " ms  p99 " << String(GetPercentile(latencies, 0.99), 3)
+					<< " ms  p99.9 " << String(GetPercentile(latencies, 0.999), 3)
+					<< " ms  polls answered " << e.GetPollCount()
+					<< "  undecodable " << e.GetMalformedCount() << std::endl;
+
+				hasDrops = hasDrops || e.GetMissingCount() > 0;
+			}
+		}
+
+		setApplicationReturnValue(hasDrops ? 2 : 0);
+		quit();
+	}
+
+	/**
+	 * Helper method to get the time the generators needed to send all their messages.
+	 *
+	 * @return	The send duration in s, at least 1 ms.
+	 */
+	double GetSendDuration() const
+	{
+		double lastSendTime = m_startTime;
+		for (auto& node : m_nodes)
+			for (auto& generator : node.Generators)
+				lastSendTime = jmax(lastSendTime, generator.second->GetSendTime(generator.second->GetSentCount() - 1));
+
+		return jmax(0.001, (lastSendTime - m_startTime) / 1000.0);
+	}
+
+	/**
+	 * Helper method to read a percentile from sorted values.
+	 *
+	 * @param sortedValues	The values, sorted ascending.
+	 * @param percentile	The percentile to read, in [0, 1].
+	 * @return	The percentile value, 0 if there are no values.
+	 */
+	static float GetPercentile(const std::vector<float>& sortedValues, double percentile)
+	{
+		if (sortedValues.empty())
+			return 0.0f;
+
+		size_t index = static_cast<size_t>(std::ceil(percentile * sortedValues.size()));
+
+		return sortedValues[jlimit(size_t(1), sortedValues.size(), index) - 1];
+	}
+
+	ProcessingEngineConfig		m_config;					/**< The configuration the engine is run with. */
+	ProcessingEngine			m_engine;					/**< The engine under test. */
+	std::vector<NodeTraffic>	m_nodes;					/**< The generators and emulators per node. */
+	double						m_startTime;				/**< The time in ms the generators were started. */
+	double						m_drainStartTime;			/**< The time in ms all generators were found to be finished. */
+};
+
+START_JUCE_APPLICATION (RemoteProtocolBridgeLoadTest)
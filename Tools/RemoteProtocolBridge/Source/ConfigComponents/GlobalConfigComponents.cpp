@@ -65,6 +65,18 @@ GlobalConfigComponent::GlobalConfigComponent()
 	m_EnableEngineOnAppStartLabel->setText("Automatically start engine on app start", dontSendNotification);
 	m_EnableEngineOnAppStartLabel->attachToComponent(m_EnableEngineOnAppStartCheck.get(), true);
 
+	m_EngineThreadingModeDrop = std::make_unique<ComboBox>();
+	addAndMakeVisible(m_EngineThreadingModeDrop.get());
+	m_EngineThreadingModeDrop->addItem(ProcessingEngineConfig::EngineThreadingModeToString(ETM_MessageThread), ETM_MessageThread);
+	m_EngineThreadingModeDrop->addItem(ProcessingEngineConfig::EngineThreadingModeToString(ETM_EngineThread), ETM_EngineThread);
+	m_EngineThreadingModeDrop->addItem(ProcessingEngineConfig::EngineThreadingModeToString(ETM_ThreadPerNode), ETM_ThreadPerNode);
+	m_EngineThreadingModeDrop->setJustificationType(Justification::right);
+
+	m_EngineThreadingModeLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_EngineThreadingModeLabel.get());
+	m_EngineThreadingModeLabel->setText("Engine threading", dontSendNotification);
+	m_EngineThreadingModeLabel->attachToComponent(m_EngineThreadingModeDrop.get(), true);
+
 	m_applyConfigButton = std::make_unique <TextButton>("Ok");
 	addAndMakeVisible(m_applyConfigButton.get());
 	m_applyConfigButton->addListener(this);
@@ -102,6 +114,10 @@ void GlobalConfigComponent::resized()
 	yOffset += UIS_Margin_s + UIS_ElmSize;
 	m_EnableEngineOnAppStartCheck->setBounds(Rectangle<int>((int)usableWidth - UIS_ElmSize, yOffset, UIS_ElmSize + UIS_Margin_s, UIS_ElmSize));
 
+	// engine threading mode drop
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_EngineThreadingModeDrop->setBounds(Rectangle<int>(UIS_Margin_s + UIS_AttachedLabelWidth, yOffset, (int)usableWidth - UIS_AttachedLabelWidth, UIS_ElmSize));
+
 	// ok button
 	yOffset += UIS_Margin_s + UIS_ElmSize;
 	m_applyConfigButton->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
@@ -173,6 +189,19 @@ bool GlobalConfigComponent::DumpTrafficLoggingAllowed()
 		return false;
 }
 
+/**
+ * Method to trigger dumping of the selected engine threading mode
+ *
+ * @return	The selected engine threading mode.
+ */
+EngineThreadingMode GlobalConfigComponent::DumpEngineThreadingMode()
+{
+	if (m_EngineThreadingModeDrop && m_EngineThreadingModeDrop->getSelectedId() > ETM_Invalid)
+		return static_cast<EngineThreadingMode>(m_EngineThreadingModeDrop->getSelectedId());
+	else
+		return ETM_MessageThread;
+}
+
 /**
  * Setter of state of button for auto-engine-start on app start
  *
@@ -195,6 +224,17 @@ void GlobalConfigComponent::SetTrafficLoggingAllowed(bool allowed)
 		m_AllowTrafficLoggingCheck->setToggleState(allowed, dontSendNotification);
 }
 
+/**
+ * Setter of the selected engine threading mode
+ *
+ * @param mode	The engine threading mode to select.
+ */
+void GlobalConfigComponent::SetEngineThreadingMode(EngineThreadingMode mode)
+{
+	if (m_EngineThreadingModeDrop)
+		m_EngineThreadingModeDrop->setSelectedId(mode, dontSendNotification);
+}
+
 /**
  * Method to get the components' suggested size. This will be deprecated as soon as
  * the primitive UI is refactored and uses dynamic / proper layouting
@@ -210,6 +250,7 @@ const std::pair<int, int> GlobalConfigComponent::GetSuggestedSize()
 		UIS_ElmSize +
 		UIS_Margin_s + UIS_ElmSize +
 		UIS_ElmSize +
+		UIS_Margin_s + UIS_ElmSize +
 		UIS_Margin_s;
 
 	return std::pair<int, int>(width, height);
@@ -280,6 +321,7 @@ bool GlobalConfigWindow::DumpConfig(ProcessingEngineConfig& config)
 	//config.SetRemoteObjectsToActivate(m_configComponent->DumpActiveRemoteObjects());
 	config.SetEngineStartOnAppStart(m_configComponent->DumpEngineStartOnAppStart());
 	config.SetTrafficLoggingAllowed(m_configComponent->DumpTrafficLoggingAllowed());
+	config.SetEngineThreadingMode(m_configComponent->DumpEngineThreadingMode());
 
 	return true;
 }
@@ -295,6 +337,7 @@ void GlobalConfigWindow::SetConfig(const ProcessingEngineConfig& config)
 	//m_configComponent->FillActiveRemoteObjects(config.GetRemoteObjectsToActivate());
 	m_configComponent->SetEngineStartOnAppStart(config.IsEngineStartOnAppStart());
 	m_configComponent->SetTrafficLoggingAllowed(config.IsTrafficLoggingAllowed());
+	m_configComponent->SetEngineThreadingMode(config.GetEngineThreadingMode());
 }
 
 /**
@@ -57,8 +57,10 @@ public:
 	//==============================================================================
 	bool DumpEngineStartOnAppStart();
 	bool DumpTrafficLoggingAllowed();
+	EngineThreadingMode DumpEngineThreadingMode();
 	void SetEngineStartOnAppStart(bool start);
 	void SetTrafficLoggingAllowed(bool allowed);
+	void SetEngineThreadingMode(EngineThreadingMode mode);
 
 	//==============================================================================
 	const std::pair<int, int> GetSuggestedSize();
@@ -82,6 +84,8 @@ private:
 	std::unique_ptr<Label>			m_EnableEngineOnAppStartLabel;	/**< Enable checkbox for traffic logging. */
 	std::unique_ptr<ToggleButton>	m_AllowTrafficLoggingCheck;		/**< Name label for engine autostart check. */
 	std::unique_ptr<ToggleButton>	m_EnableEngineOnAppStartCheck;	/**< Enable checkbox for engine autostart. */
+	std::unique_ptr<Label>			m_EngineThreadingModeLabel;		/**< Name label for engine threading mode drop. */
+	std::unique_ptr<ComboBox>		m_EngineThreadingModeDrop;		/**< Drop to select the engine threading mode. */
 
 	std::unique_ptr<TextButton>		m_applyConfigButton;			/**< Button to apply edited values to configuration. */
 };
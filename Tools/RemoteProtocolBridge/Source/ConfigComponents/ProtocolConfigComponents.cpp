@@ -649,6 +649,42 @@ OSCProtocolConfigComponent::OSCProtocolConfigComponent()
 	m_PollingIntervalLabel->setText("Polling interval", dontSendNotification);
 	m_PollingIntervalEdit = std::make_unique<TextEditor>();
 	addAndMakeVisible(m_PollingIntervalEdit.get());
+
+	m_AdaptivePollingLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_AdaptivePollingLabel.get());
+	m_AdaptivePollingLabel->setText("Adaptive polling max (0 = off)", dontSendNotification);
+	m_AdaptivePollingEdit = std::make_unique<TextEditor>();
+	addAndMakeVisible(m_AdaptivePollingEdit.get());
+
+	m_BundleWindowLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_BundleWindowLabel.get());
+	m_BundleWindowLabel->setText("Bundling window (0 = off)", dontSendNotification);
+	m_BundleWindowEdit = std::make_unique<TextEditor>();
+	addAndMakeVisible(m_BundleWindowEdit.get());
+
+	m_BundleMTULabel = std::make_unique<Label>();
+	addAndMakeVisible(m_BundleMTULabel.get());
+	m_BundleMTULabel->setText("Bundle MTU", dontSendNotification);
+	m_BundleMTUEdit = std::make_unique<TextEditor>();
+	addAndMakeVisible(m_BundleMTUEdit.get());
+
+	m_CoalescingIntervalLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_CoalescingIntervalLabel.get());
+	m_CoalescingIntervalLabel->setText("Coalescing interval (0 = off)", dontSendNotification);
+	m_CoalescingIntervalEdit = std::make_unique<TextEditor>();
+	addAndMakeVisible(m_CoalescingIntervalEdit.get());
+
+	m_RateLimitLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_RateLimitLabel.get());
+	m_RateLimitLabel->setText("Rate limit (0 = off)", dontSendNotification);
+	m_RateLimitEdit = std::make_unique<TextEditor>();
+	addAndMakeVisible(m_RateLimitEdit.get());
+
+	m_RateBurstLabel = std::make_unique<Label>();
+	addAndMakeVisible(m_RateBurstLabel.get());
+	m_RateBurstLabel->setText("Rate burst", dontSendNotification);
+	m_RateBurstEdit = std::make_unique<TextEditor>();
+	addAndMakeVisible(m_RateBurstEdit.get());
 }
 
 /**
@@ -727,6 +763,34 @@ void OSCProtocolConfigComponent::resized()
 	m_PollingIntervalLabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
 	m_PollingIntervalEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
 
+	// adaptive polling max. interval edit/label
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_AdaptivePollingLabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
+	m_AdaptivePollingEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
+
+	// bundling window and mtu edits/labels
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_BundleWindowLabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
+	m_BundleWindowEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
+
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_BundleMTULabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
+	m_BundleMTUEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
+
+	// coalescing interval edit/label
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_CoalescingIntervalLabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
+	m_CoalescingIntervalEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
+
+	// rate limit and burst edits/labels
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_RateLimitLabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
+	m_RateLimitEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
+
+	yOffset += UIS_Margin_s + UIS_ElmSize;
+	m_RateBurstLabel->setBounds(Rectangle<int>(UIS_Margin_s, yOffset, remObjNameWidth - UIS_Margin_s, UIS_ElmSize));
+	m_RateBurstEdit->setBounds(Rectangle<int>(2 * UIS_Margin_s + remObjNameWidth, yOffset, remObjEnableWidth + remObjChRngeWidth - UIS_Margin_m, UIS_ElmSize));
+
 	// ok button
 	yOffset += UIS_Margin_s + UIS_ElmSize + UIS_Margin_s;
 	m_applyConfigButton->setBounds(Rectangle<int>((int)usableWidth - UIS_ButtonWidth, yOffset, UIS_ButtonWidth, UIS_ElmSize));
@@ -975,6 +1039,204 @@ void OSCProtocolConfigComponent::FillPollingInterval(int PollingInterval)
 	return;
 }
 
+/**
+ * Method to trigger dumping contents of configcomponent member
+ * to integer adaptive polling max. interval return value
+ *
+ * @return	Max. interval value adaptive polling backs off to, 0 if adaptive polling is disabled.
+ */
+int OSCProtocolConfigComponent::DumpAdaptivePollingMaxInterval()
+{
+	int AdaptivePollingMaxInterval = 0;
+
+	StringArray intervalStrings;
+	intervalStrings.addTokens(m_AdaptivePollingEdit->getText(), ";, ", "");
+	if (intervalStrings.size() == 1)
+	{
+		AdaptivePollingMaxInterval = intervalStrings[0].getIntValue();
+	}
+	else if (intervalStrings.size() == 2 && intervalStrings[1] == "ms")
+	{
+		AdaptivePollingMaxInterval = intervalStrings[0].getIntValue();
+	}
+
+	return jmax(0, AdaptivePollingMaxInterval);
+}
+
+/**
+ * Method to trigger filling contents of
+ * configcomponent member with adaptive polling max. interval value
+ *
+ * @param AdaptivePollingMaxInterval	The max. interval value
+ */
+void OSCProtocolConfigComponent::FillAdaptivePollingMaxInterval(int AdaptivePollingMaxInterval)
+{
+	if (m_AdaptivePollingEdit)
+		m_AdaptivePollingEdit->setText(String(AdaptivePollingMaxInterval) + String(" ms"));
+}
+
+/**
+ * Method to trigger dumping contents of configcomponent member
+ * to integer bundling window return value
+ *
+ * @return	Bundling window time value, 0 if bundling is disabled.
+ */
+int OSCProtocolConfigComponent::DumpBundleWindow()
+{
+	int BundleWindow = 0;
+
+	StringArray windowStrings;
+	windowStrings.addTokens(m_BundleWindowEdit->getText(), ";, ", "");
+	if (windowStrings.size() == 1)
+	{
+		BundleWindow = windowStrings[0].getIntValue();
+	}
+	else if (windowStrings.size() == 2 && windowStrings[1] == "ms")
+	{
+		BundleWindow = windowStrings[0].getIntValue();
+	}
+
+	return jmax(0, BundleWindow);
+}
+
+/**
+ * Method to trigger dumping contents of configcomponent member
+ * to integer bundle mtu return value
+ *
+ * @return	Max. bundle packet size value.
+ */
+int OSCProtocolConfigComponent::DumpBundleMTU()
+{
+	int BundleMTU = EBS_DefaultBundleMTU;
+
+	StringArray mtuStrings;
+	mtuStrings.addTokens(m_BundleMTUEdit->getText(), ";, ", "");
+	if (mtuStrings.size() == 1)
+	{
+		BundleMTU = mtuStrings[0].getIntValue();
+	}
+	else if (mtuStrings.size() == 2 && mtuStrings[1] == "bytes")
+	{
+		BundleMTU = mtuStrings[0].getIntValue();
+	}
+
+	return jlimit(int(EBS_MinBundleMTU), int(EBS_MaxBundleMTU), BundleMTU);
+}
+
+/**
+ * Method to trigger filling contents of
+ * configcomponent members with bundling values
+ *
+ * @param BundleWindow	The bundling window value
+ * @param BundleMTU		The max. bundle packet size value
+ */
+void OSCProtocolConfigComponent::FillBundling(int BundleWindow, int BundleMTU)
+{
+	if (m_BundleWindowEdit)
+		m_BundleWindowEdit->setText(String(BundleWindow) + String(" ms"));
+	if (m_BundleMTUEdit)
+		m_BundleMTUEdit->setText(String(BundleMTU) + String(" bytes"));
+}
+
+/**
+ * Method to trigger dumping contents of configcomponent member
+ * to integer coalescing interval return value
+ *
+ * @return	Coalescing interval time value, 0 if coalescing is disabled.
+ */
+int OSCProtocolConfigComponent::DumpCoalescingInterval()
+{
+	int CoalescingInterval = 0;
+
+	StringArray intervalStrings;
+	intervalStrings.addTokens(m_CoalescingIntervalEdit->getText(), ";, ", "");
+	if (intervalStrings.size() == 1)
+	{
+		CoalescingInterval = intervalStrings[0].getIntValue();
+	}
+	else if (intervalStrings.size() == 2 && intervalStrings[1] == "ms")
+	{
+		CoalescingInterval = intervalStrings[0].getIntValue();
+	}
+
+	return jmax(0, CoalescingInterval);
+}
+
+/**
+ * Method to trigger filling contents of
+ * configcomponent member with coalescing interval value
+ *
+ * @param CoalescingInterval	The coalescing interval value
+ */
+void OSCProtocolConfigComponent::FillCoalescingInterval(int CoalescingInterval)
+{
+	if (m_CoalescingIntervalEdit)
+		m_CoalescingIntervalEdit->setText(String(CoalescingInterval) + String(" ms"));
+}
+
+/**
+ * Method to trigger dumping contents of configcomponent member
+ * to integer rate limit return value
+ *
+ * @return	Rate limit value in messages per second, 0 if rate limiting is disabled.
+ */
+int OSCProtocolConfigComponent::DumpRateLimit()
+{
+	int RateLimit = 0;
+
+	StringArray rateStrings;
+	rateStrings.addTokens(m_RateLimitEdit->getText(), ";, ", "");
+	if (rateStrings.size() == 1)
+	{
+		RateLimit = rateStrings[0].getIntValue();
+	}
+	else if (rateStrings.size() == 2 && rateStrings[1] == "msg/s")
+	{
+		RateLimit = rateStrings[0].getIntValue();
+	}
+
+	return jmax(0, RateLimit);
+}
+
+/**
+ * Method to trigger dumping contents of configcomponent member
+ * to integer rate burst return value
+ *
+ * @return	Count of messages that may be sent in a burst.
+ */
+int OSCProtocolConfigComponent::DumpRateBurst()
+{
+	int RateBurst = EBS_DefaultRateBurst;
+
+	StringArray burstStrings;
+	burstStrings.addTokens(m_RateBurstEdit->getText(), ";, ", "");
+	if (burstStrings.size() == 1)
+	{
+		RateBurst = burstStrings[0].getIntValue();
+	}
+	else if (burstStrings.size() == 2 && burstStrings[1] == "msgs")
+	{
+		RateBurst = burstStrings[0].getIntValue();
+	}
+
+	return jmax(1, RateBurst);
+}
+
+/**
+ * Method to trigger filling contents of
+ * configcomponent members with rate limiting values
+ *
+ * @param RateLimit		The rate limit value
+ * @param RateBurst		The burst size value
+ */
+void OSCProtocolConfigComponent::FillRateLimit(int RateLimit, int RateBurst)
+{
+	if (m_RateLimitEdit)
+		m_RateLimitEdit->setText(String(RateLimit) + String(" msg/s"));
+	if (m_RateBurstEdit)
+		m_RateBurstEdit->setText(String(RateBurst) + String(" msgs"));
+}
+
 /**
  * Method to get the components' suggested size. This will be deprecated as soon as
  * the primitive UI is refactored and uses dynamic / proper layouting
@@ -990,6 +1252,7 @@ const std::pair<int, int> OSCProtocolConfigComponent::GetSuggestedSize()
 					UIS_ElmSize + 
 					((ROI_UserMAX - ROI_Invalid)*(UIS_Margin_s + UIS_ElmSize + UIS_Margin_s)) +
 					UIS_Margin_s + UIS_Margin_s + UIS_ElmSize +
+					6 * (UIS_Margin_s + UIS_ElmSize) +
 					UIS_Margin_s + UIS_ElmSize + UIS_Margin_s +
 					UIS_Margin_s;
 
@@ -1008,6 +1271,12 @@ const std::pair<int, int> OSCProtocolConfigComponent::GetSuggestedSize()
 bool OSCProtocolConfigComponent::DumpConfig(NodeId NId, ProtocolId PId, ProcessingEngineConfig& config)
 {
 	config.SetPollingInterval(NId, PId, DumpPollingInterval());
+	config.SetAdaptivePollingMaxInterval(NId, PId, DumpAdaptivePollingMaxInterval());
+	config.SetBundleWindow(NId, PId, DumpBundleWindow());
+	config.SetBundleMTU(NId, PId, DumpBundleMTU());
+	config.SetCoalescingInterval(NId, PId, DumpCoalescingInterval());
+	config.SetRateLimit(NId, PId, DumpRateLimit());
+	config.SetRateBurst(NId, PId, DumpRateBurst());
 
 	return ProtocolConfigComponent_Abstract::DumpConfig(NId, PId, config);
 }
@@ -1025,6 +1294,10 @@ void OSCProtocolConfigComponent::SetConfig(NodeId NId, ProtocolId PId, const Pro
 	ProtocolConfigComponent_Abstract::SetConfig(NId, PId, config);
 
 	FillPollingInterval(config.GetProtocolData(NId, PId).PollingInterval);
+	FillAdaptivePollingMaxInterval(config.GetProtocolData(NId, PId).AdaptivePollingMaxInterval);
+	FillBundling(config.GetProtocolData(NId, PId).BundleWindow, config.GetProtocolData(NId, PId).BundleMTU);
+	FillCoalescingInterval(config.GetProtocolData(NId, PId).CoalescingInterval);
+	FillRateLimit(config.GetProtocolData(NId, PId).RateLimit, config.GetProtocolData(NId, PId).RateBurst);
 }
 
 
@@ -173,6 +173,16 @@ private:
 
 	void FillPollingInterval(int PollingInterval);
 	int DumpPollingInterval();
+	void FillAdaptivePollingMaxInterval(int AdaptivePollingMaxInterval);
+	int DumpAdaptivePollingMaxInterval();
+	void FillBundling(int BundleWindow, int BundleMTU);
+	int DumpBundleWindow();
+	int DumpBundleMTU();
+	void FillCoalescingInterval(int CoalescingInterval);
+	int DumpCoalescingInterval();
+	void FillRateLimit(int RateLimit, int RateBurst);
+	int DumpRateLimit();
+	int DumpRateBurst();
 
 	std::map<int, std::unique_ptr<ToggleButton>>	m_RemObjEnableChecks;		/**< Enable checkboxes for all remote object to be configured/listed on ui. */
 	std::map<int, std::unique_ptr<Label>>			m_RemObjNameLabels;			/**< Name labels for all remote object to be configured/listed on ui. */
@@ -192,6 +202,18 @@ private:
 
 	std::unique_ptr<Label>		m_PollingIntervalLabel;		/**< Label as description of polling interval edit. */
 	std::unique_ptr<TextEditor> m_PollingIntervalEdit;		/**< Edit for editing of polling interval. */
+	std::unique_ptr<Label>		m_AdaptivePollingLabel;		/**< Label as description of adaptive polling max. interval edit. */
+	std::unique_ptr<TextEditor> m_AdaptivePollingEdit;		/**< Edit for editing of the max. interval adaptive polling backs off to. */
+	std::unique_ptr<Label>		m_BundleWindowLabel;		/**< Label as description of bundling window edit. */
+	std::unique_ptr<TextEditor> m_BundleWindowEdit;			/**< Edit for editing of the outgoing message bundling window. */
+	std::unique_ptr<Label>		m_BundleMTULabel;			/**< Label as description of bundle mtu edit. */
+	std::unique_ptr<TextEditor> m_BundleMTUEdit;			/**< Edit for editing of the max. outgoing bundle packet size. */
+	std::unique_ptr<Label>		m_CoalescingIntervalLabel;	/**< Label as description of coalescing interval edit. */
+	std::unique_ptr<TextEditor> m_CoalescingIntervalEdit;	/**< Edit for editing of the outgoing message coalescing interval. */
+	std::unique_ptr<Label>		m_RateLimitLabel;			/**< Label as description of rate limit edit. */
+	std::unique_ptr<TextEditor> m_RateLimitEdit;			/**< Edit for editing of the outgoing message rate limit. */
+	std::unique_ptr<Label>		m_RateBurstLabel;			/**< Label as description of rate burst edit. */
+	std::unique_ptr<TextEditor> m_RateBurstEdit;			/**< Edit for editing of the outgoing message burst size. */
 
 };
 
@@ -0,0 +1,182 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "EngineMetricsPublisher.h"
+
+#include "ProcessingEngine.h"
+
+
+// **************************************************************************************
+//    class EngineMetricsPublisher
+// **************************************************************************************
+/**
+ * Constructor
+ *
+ * @param engine		The engine whose metrics shall be published.
+ * @param port			The loopback tcp port to serve the metrics on, 0 to not serve them.
+ * @param dumpInterval	The interval in ms to write the metrics to the dump file in, 0 to disable the file dump.
+ * @param dumpFile		The file to write the metrics to.
+ */
+EngineMetricsPublisher::EngineMetricsPublisher(ProcessingEngine& engine, int port, int dumpInterval, const File& dumpFile)
+	: Thread("RemoteProtocolBridge Metrics"),
+	m_engine(engine),
+	m_port(port),
+	m_dumpInterval(dumpInterval),
+	m_dumpFile(dumpFile)
+{
+}
+
+/**
+ * Destructor. Makes sure the thread is shut down before the object is gone.
+ */
+EngineMetricsPublisher::~EngineMetricsPublisher()
+{
+	Stop();
+}
+
+/**
+ * Starts listening for metrics requests and the thread that serves them and writes the dump file.
+ *
+ * @return	True if the publisher was started, false if there is nothing to publish or the port could not be opened.
+ */
+bool EngineMetricsPublisher::Start()
+{
+	if (m_port > 0)
+	{
+		m_listener = std::make_unique<StreamingSocket>();
+		if (!m_listener->createListener(m_port, "127.0.0.1"))
+		{
+#ifdef DEBUG
+			DBG("Metrics port " + String(m_port) + " could not be opened");
+#endif
+			m_listener.reset();
+		}
+	}
+
+	if (!m_listener && m_dumpInterval <= 0)
+		return false;
+
+	startThread();
+
+	return true;
+}
+
+/**
+ * Stops the thread and closes the listening socket.
+ */
+void EngineMetricsPublisher::Stop()
+{
+	signalThreadShouldExit();
+	if (m_listener)
+		m_listener->close();
+
+	stopThread(2 * ET_MetricsServerPollInterval);
+
+	m_listener.reset();
+}
+
+/**
+ * Reimplemented thread loop. Serves incoming metrics requests one at a time
+ * and writes the dump file whenever the dump interval elapsed.
+ */
+void EngineMetricsPublisher::run()
+{
+	double nextDumpTime = Time::getMillisecondCounterHiRes() + m_dumpInterval;
+
+	while (!threadShouldExit())
+	{
+		if (m_listener)
+		{
+			if (m_listener->waitUntilReady(true, ET_MetricsServerPollInterval) == 1 && !threadShouldExit())
+			{
+				std::unique_ptr<StreamingSocket> connection(m_listener->waitForNextConnection());
+				if (connection)
+					ServeConnection(*connection);
+			}
+		}
+		else
+			wait(ET_MetricsServerPollInterval);
+
+		double now = Time::getMillisecondCounterHiRes();
+		if (m_dumpInterval > 0 && now >= nextDumpTime && !threadShouldExit())
+		{
+			WriteMetricsFile();
+			nextDumpTime = now + m_dumpInterval;
+		}
+	}
+}
+
+/**
+ * Helper method to answer a single http request with a metrics snapshot.
+ * Only GET requests are answered with the snapshot, regardless of the requested path.
+ *
+ * @param connection	The connected socket of the requesting client.
+ */
+void EngineMetricsPublisher::ServeConnection(StreamingSocket& connection)
+{
+	char request[1024];
+	int requestSize = 0;
+	if (connection.waitUntilReady(true, ET_MetricsServerPollInterval) == 1)
+		requestSize = connection.read(request, sizeof(request) - 1, false);
+
+	String status;
+	String body;
+	if (requestSize > 0 && String(CharPointer_UTF8(request), static_cast<size_t>(requestSize)).startsWith("GET "))
+	{
+		status = "200 OK";
+		body = m_engine.CreateMetricsSnapshot()->toString();
+	}
+	else
+		status = "405 Method Not Allowed";
+
+	String response = "HTTP/1.0 " + status + "\r\n"
+		"Content-Type: application/xml; charset=utf-8\r\n"
+		"Content-Length: " + String(body.getNumBytesAsUTF8()) + "\r\n"
+		"Connection: close\r\n"
+		"\r\n" + body;
+
+	connection.write(response.toRawUTF8(), static_cast<int>(response.getNumBytesAsUTF8()));
+	connection.close();
+}
+
+/**
+ * Helper method to write a metrics snapshot to the dump file.
+ *
+ * @return	True on success, false if the file could not be written.
+ */
+bool EngineMetricsPublisher::WriteMetricsFile()
+{
+	return m_engine.CreateMetricsSnapshot()->writeTo(m_dumpFile);
+}
@@ -0,0 +1,75 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+// Fwd. declarations
+class ProcessingEngine;
+
+
+/**
+ * Class EngineMetricsPublisher is a thread that publishes snapshots of the engine metrics,
+ * to watch the engine load on machines without user interface.
+ * Snapshots are served as xml to http GET requests on a loopback tcp port
+ * and periodically written to a file, each if configured.
+ */
+class EngineMetricsPublisher : public Thread
+{
+public:
+	EngineMetricsPublisher(ProcessingEngine& engine, int port, int dumpInterval, const File& dumpFile);
+	~EngineMetricsPublisher() override;
+
+	bool Start();
+	void Stop();
+
+	//==============================================================================
+	void run() override;
+
+private:
+	void ServeConnection(StreamingSocket& connection);
+	bool WriteMetricsFile();
+
+	ProcessingEngine&					m_engine;			/**< The engine whose metrics are published. */
+	int									m_port;				/**< The loopback tcp port the metrics are served on. 0 if the metrics are not served. */
+	int									m_dumpInterval;		/**< The interval in ms the metrics are written to the dump file. 0 if the file dump is disabled. */
+	File								m_dumpFile;			/**< The file the metrics are written to. */
+	std::unique_ptr<StreamingSocket>	m_listener;			/**< The socket listening for metrics requests. Only exists while the metrics are served. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineMetricsPublisher)
+};
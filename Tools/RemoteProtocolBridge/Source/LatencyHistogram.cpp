@@ -0,0 +1,177 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "LatencyHistogram.h"
+
+
+// **************************************************************************************
+//    class LatencyHistogram
+// **************************************************************************************
+/**
+ * Constructor
+ */
+LatencyHistogram::LatencyHistogram()
+{
+	Reset();
+}
+
+/**
+ * Destructor
+ */
+LatencyHistogram::~LatencyHistogram()
+{
+}
+
+/**
+ * Method to count a latency in its bucket. Can be called from any thread.
+ *
+ * @param latency	The latency to record, in ms.
+ */
+void LatencyHistogram::Record(double latency)
+{
+	uint64 value = latency > 0 ? static_cast<uint64>(latency * 1000.0 + 0.5) : 0;
+
+	++m_buckets[GetBucketIndex(value)];
+	++m_count;
+
+	uint64 max = m_max.get();
+	while (value > max && !m_max.compareAndSetBool(value, max))
+		max = m_max.get();
+}
+
+/**
+ * Method to discard all recorded values.
+ * Values recorded concurrently may be kept or discarded.
+ */
+void LatencyHistogram::Reset()
+{
+	for (int i = 0; i < HL_BucketCount; ++i)
+		m_buckets[i] = 0;
+
+	m_count = 0;
+	m_max = 0;
+}
+
+/**
+ * Getter for the count of recorded values.
+ *
+ * @return	The count of recorded values.
+ */
+uint64 LatencyHistogram::GetCount() const
+{
+	return m_count.get();
+}
+
+/**
+ * Getter for the latency the given share of the recorded values does not exceed.
+ * The result is the center of the bucket the percentile falls into, limited to the max. recorded value.
+ *
+ * @param percentile	The percentile to get, in the range 0 to 100.
+ * @return	The percentile latency in ms, 0 if no value was recorded.
+ */
+double LatencyHistogram::GetPercentile(double percentile) const
+{
+	uint64 count = 0;
+	for (int i = 0; i < HL_BucketCount; ++i)
+		count += m_buckets[i].get();
+
+	if (count == 0)
+		return 0;
+
+	uint64 rank = jmax(uint64(1), static_cast<uint64>(std::ceil(jlimit(0.0, 100.0, percentile) / 100.0 * static_cast<double>(count))));
+	uint64 value = m_max.get();
+
+	uint64 counted = 0;
+	for (int i = 0; i < HL_BucketCount; ++i)
+	{
+		counted += m_buckets[i].get();
+		if (counted >= rank)
+		{
+			uint64 lowerBound = GetBucketLowerBound(i);
+			uint64 upperBound = (i + 1 < HL_BucketCount) ? GetBucketLowerBound(i + 1) : lowerBound;
+			value = jmin(value, (lowerBound + upperBound) / 2);
+			break;
+		}
+	}
+
+	return static_cast<double>(value) / 1000.0;
+}
+
+/**
+ * Getter for the largest recorded latency.
+ *
+ * @return	The max. latency in ms, 0 if no value was recorded.
+ */
+double LatencyHistogram::GetMax() const
+{
+	return static_cast<double>(m_max.get()) / 1000.0;
+}
+
+/**
+ * Helper method to get the bucket a value is counted in.
+ *
+ * @param value	The value in us.
+ * @return	The index of the bucket.
+ */
+int LatencyHistogram::GetBucketIndex(uint64 value)
+{
+	if (value < HL_LinearCount)
+		return static_cast<int>(value);
+
+	int exponent = (value >> 32) != 0 ? 32 + findHighestSetBit(static_cast<uint32>(value >> 32)) : findHighestSetBit(static_cast<uint32>(value));
+	if (exponent > HL_MaxExponent)
+		return HL_BucketCount - 1;
+
+	int subBucket = static_cast<int>(value >> (exponent - HL_SubBucketBits)) & (HL_SubBucketCount - 1);
+
+	return HL_LinearCount + (exponent - HL_SubBucketBits - 1) * HL_SubBucketCount + subBucket;
+}
+
+/**
+ * Helper method to get the smallest value that is counted in a bucket.
+ *
+ * @param index	The index of the bucket.
+ * @return	The smallest value of the bucket in us.
+ */
+uint64 LatencyHistogram::GetBucketLowerBound(int index)
+{
+	if (index < HL_LinearCount)
+		return static_cast<uint64>(index);
+
+	int exponent = HL_SubBucketBits + 1 + (index - HL_LinearCount) / HL_SubBucketCount;
+	int subBucket = (index - HL_LinearCount) % HL_SubBucketCount;
+
+	return static_cast<uint64>(HL_SubBucketCount + subBucket) << (exponent - HL_SubBucketBits);
+}
@@ -0,0 +1,80 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class LatencyHistogram records latencies in log-linear buckets, similar to a HDR histogram.
+ * Latencies below 16 us are counted exactly, larger ones in eight linear sub-buckets per power of two,
+ * so every recorded value is resolved to about 12% of its magnitude up to several minutes.
+ * Recording is lock-free and does not allocate, so it can be done from any thread in the message path.
+ */
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+	~LatencyHistogram();
+
+	void Record(double latency);
+	void Reset();
+
+	uint64 GetCount() const;
+	double GetPercentile(double percentile) const;
+	double GetMax() const;
+
+private:
+	enum HistogramLayout
+	{
+		HL_SubBucketBits	= 3,	/**< Bits of a value below its highest set bit that select the linear sub-bucket. */
+		HL_SubBucketCount	= 1 << HL_SubBucketBits,	/**< Count of linear sub-buckets per power of two. */
+		HL_LinearCount		= 2 * HL_SubBucketCount,	/**< Count of values below the first sub-bucketed power of two, which are counted exactly. */
+		HL_MaxExponent		= 28,	/**< The highest power of two of recordable values, in us (about 4.5 min). Larger values are counted in the last bucket. */
+		HL_BucketCount		= HL_LinearCount + (HL_MaxExponent - HL_SubBucketBits) * HL_SubBucketCount	/**< Total count of buckets. */
+	};
+
+	static int GetBucketIndex(uint64 value);
+	static uint64 GetBucketLowerBound(int index);
+
+	Atomic<uint64>	m_buckets[HL_BucketCount];	/**< The count of recorded values per bucket. */
+	Atomic<uint64>	m_count;					/**< The total count of recorded values. */
+	Atomic<uint64>	m_max;						/**< The largest recorded value, in us. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyHistogram)
+};
@@ -75,7 +75,7 @@ PlotComponent::~PlotComponent()
 
 /**
  * Method to increase the received message counter per current interval for given Node and Protocol.
- * Currently we simply sum up all protocol traffic per node.
+ * Currently we simply sum up all protocol traffic per node. To be called on the message thread.
  *
  * @param NId	The node id the count shall be increased for
  * @param PId	The node protocol id the count shall be increased for
@@ -83,16 +83,8 @@ PlotComponent::~PlotComponent()
 void PlotComponent::IncreaseCount(NodeId NId, ProtocolId PId)
 {
 	ignoreUnused(NId);
-	m_currentMsgPerProtocol[PId]++;
 
-	if (!m_protocolPlotColours.count(int(PId)))
-	{
-		float r = float(rand()) / float(RAND_MAX);
-		float g = float(rand()) / float(RAND_MAX);
-		float b = float(rand()) / float(RAND_MAX);
-		float a = 170.0f;
-		m_protocolPlotColours[int(PId)] = Colour::fromFloatRGBA(r, g, b, a);
-	}
+	m_currentMsgPerProtocol[PId]++;
 }
 
 /**
@@ -103,8 +95,17 @@ void PlotComponent::timerCallback()
 {
 	// accumulate all protocol msgs as well as handle individual protocol msg counts
 	int msgCount = 0;
-	for (const std::pair<const ProtocolId, int> &msgCountPerProtocol : m_currentMsgPerProtocol)
+	for (std::pair<const ProtocolId, int> &msgCountPerProtocol : m_currentMsgPerProtocol)
 	{
+		if (!m_protocolPlotColours.count(int(msgCountPerProtocol.first)))
+		{
+			float r = float(rand()) / float(RAND_MAX);
+			float g = float(rand()) / float(RAND_MAX);
+			float b = float(rand()) / float(RAND_MAX);
+			float a = 170.0f;
+			m_protocolPlotColours[int(msgCountPerProtocol.first)] = Colour::fromFloatRGBA(r, g, b, a);
+		}
+
 		if (m_plotData[int(msgCountPerProtocol.first)].size() != m_plotData[NODE].size())
 			m_plotData[int(msgCountPerProtocol.first)].resize(m_plotData[NODE].size());
 
@@ -113,8 +114,7 @@ void PlotComponent::timerCallback()
 		m_plotData[int(msgCountPerProtocol.first)].push_back(float(msgCountPerProtocol.second));
 
 		msgCount += msgCountPerProtocol.second;
-
-		m_currentMsgPerProtocol[msgCountPerProtocol.first] = 0;
+		msgCountPerProtocol.second = 0;
 	}
 
 	std::vector<float> shiftedVector(m_plotData[NODE].begin() + 1, m_plotData[NODE].end());
@@ -241,6 +241,262 @@ void PlotComponent::resized()
 }
 
 
+//==============================================================================
+// Class TrafficLogView
+//==============================================================================
+/**
+ * Constructor of the filter, initialized to show all records.
+ */
+TrafficLogView::Filter::Filter()
+{
+	NId = -1;
+	PId = -1;
+	Id = ROI_Invalid;
+	Channel = -1;
+}
+
+/**
+ * Method to check if a record matches the filter criteria.
+ *
+ * @param record	The record to check
+ * @return	True if the record is to be shown, false if not
+ */
+bool TrafficLogView::Filter::Matches(const TrafficLogRecord& record) const
+{
+	if (NId >= 0 && record.NId != NodeId(NId))
+		return false;
+	if (PId >= 0 && record.Message.PId != ProtocolId(PId))
+		return false;
+	if (Id != ROI_Invalid && record.Message.Id != Id)
+		return false;
+	if (Channel >= 0 && record.Message.addrVal.first != Channel)
+		return false;
+
+	return true;
+}
+
+/**
+ * Class constructor. All storage for the history is allocated here.
+ *
+ * @param capacity	The count of the latest records to keep
+ */
+TrafficLogView::TrafficLogView(int capacity)
+	: m_records(static_cast<size_t>(jmax(1, capacity))),
+	m_rows(static_cast<size_t>(jmax(1, capacity)))
+{
+	m_recordCount = 0;
+	m_firstRow = 0;
+	m_rowCount = 0;
+
+	m_listBox = std::make_unique<ListBox>(String(), this);
+	m_listBox->setRowHeight(UIS_ElmSize - UIS_Margin_s);
+	m_listBox->setColour(ListBox::backgroundColourId, getLookAndFeel().findColour(CodeEditorComponent::ColourIds::backgroundColourId));
+	addAndMakeVisible(m_listBox.get());
+}
+
+/**
+ * Destructor
+ */
+TrafficLogView::~TrafficLogView()
+{
+	m_listBox.reset();
+}
+
+/**
+ * Method to append records to the history, overwriting the oldest ones if it is full.
+ * Only the list content size is updated, the rows are formatted when they are painted.
+ * If the end of the list was visible, the view follows it, else it stays at the records that are shown.
+ *
+ * @param records	The records to add, in the order they were logged
+ * @param count		The count of records to add
+ */
+void TrafficLogView::AddRecords(const TrafficLogRecord* records, int count)
+{
+	if (count <= 0)
+		return;
+
+	int capacity = static_cast<int>(m_records.size());
+	int rowHeight = m_listBox->getRowHeight();
+	Viewport* viewport = m_listBox->getViewport();
+	bool followEnd = viewport->getViewPositionY() + viewport->getViewHeight() >= m_rowCount * rowHeight;
+
+	int removedRows = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		// the record number that is overwritten by this one leaves the shown rows, if it is the first of them
+		if (m_recordCount >= uint64(capacity) && m_rowCount > 0 && m_rows[static_cast<size_t>(m_firstRow)] == m_recordCount - uint64(capacity))
+		{
+			m_firstRow = (m_firstRow + 1) % capacity;
+			--m_rowCount;
+			++removedRows;
+		}
+
+		TrafficLogRecord& record = m_records[static_cast<size_t>(m_recordCount % uint64(capacity))];
+		record = records[i];
+		if (m_filter.Matches(record))
+		{
+			m_rows[static_cast<size_t>((m_firstRow + m_rowCount) % capacity)] = m_recordCount;
+			++m_rowCount;
+		}
+
+		++m_recordCount;
+	}
+
+	m_listBox->updateContent();
+	if (followEnd && m_rowCount > 0)
+		m_listBox->scrollToEnsureRowIsOnscreen(m_rowCount - 1);
+	else if (removedRows > 0)
+		viewport->setViewPosition(viewport->getViewPositionX(), viewport->getViewPositionY() - removedRows * rowHeight);
+	m_listBox->repaint();
+}
+
+/**
+ * Method to set the criteria the shown records have to match.
+ * The shown rows are collected anew from the history.
+ *
+ * @param filter	The new filter criteria
+ */
+void TrafficLogView::SetFilter(const Filter& filter)
+{
+	m_filter = filter;
+
+	int capacity = static_cast<int>(m_records.size());
+	uint64 firstRecord = m_recordCount > uint64(capacity) ? m_recordCount - uint64(capacity) : 0;
+
+	m_firstRow = 0;
+	m_rowCount = 0;
+	for (uint64 n = firstRecord; n < m_recordCount; ++n)
+	{
+		if (m_filter.Matches(m_records[static_cast<size_t>(n % uint64(capacity))]))
+		{
+			m_rows[static_cast<size_t>(m_rowCount)] = n;
+			++m_rowCount;
+		}
+	}
+
+	m_listBox->updateContent();
+	if (m_rowCount > 0)
+		m_listBox->scrollToEnsureRowIsOnscreen(m_rowCount - 1);
+	m_listBox->repaint();
+}
+
+/**
+ * Getter for the count of records currently held in the history.
+ *
+ * @return	The count of records
+ */
+int TrafficLogView::GetRecordCount() const
+{
+	return static_cast<int>(jmin(m_recordCount, uint64(m_records.size())));
+}
+
+/**
+ * Getter for the count of records in the history that match the filter.
+ *
+ * @return	The count of shown records
+ */
+int TrafficLogView::GetShownCount() const
+{
+	return m_rowCount;
+}
+
+/**
+ * Helper method to format a traffic log record as a single log line.
+ *
+ * @param record	The record to format
+ * @return	The log line
+ */
+String TrafficLogView::FormatLogRecord(const TrafficLogRecord& record)
+{
+	const RemoteObjectMessageCopy& message = record.Message;
+
+	String objectString;
+	switch (record.SenderType)
+	{
+	case PT_OSCProtocol:
+		objectString += OSCProtocolProcessor::GetRemoteObjectString(message.Id) +
+			String::formatted(" | ch%d rec%d", message.addrVal.first, message.addrVal.second);
+		break;
+	case PT_OCAProtocol:
+		objectString += OCAProtocolProcessor::GetRemoteObjectString(message.Id) +
+			String::formatted(" | ch%d rec%d", message.addrVal.first, message.addrVal.second);
+		break;
+	default:
+		break;
+	}
+
+	if (message.valCount > 0)
+	{
+		objectString += " |";
+
+		if (message.valType == ROVT_FLOAT)
+		{
+			for (int i = 0; i < message.valCount; ++i)
+				objectString += String::formatted(" %f", message.values.floatValues[i]);
+		}
+		else if (message.valType == ROVT_INT)
+		{
+			for (int i = 0; i < message.valCount; ++i)
+				objectString += String::formatted(" %d", message.values.intValues[i]);
+		}
+	}
+
+	String SenderName = ProcessingEngineConfig::ProtocolTypeToString(record.SenderType);
+	String logString;
+	logString << Time(record.Time).formatted("%H:%M:%S") << String::formatted(".%03d ", static_cast<int>(record.Time % 1000));
+	logString << "Node" << (int)record.NId << "[In:" << SenderName << ":PId" << (int)message.PId << "]: " << objectString;
+
+	return logString;
+}
+
+/**
+ * Reimplemented from Component.
+ * The list box fills the whole view.
+ */
+void TrafficLogView::resized()
+{
+	Component::resized();
+
+	m_listBox->setBounds(getLocalBounds());
+}
+
+/**
+ * Reimplemented from ListBoxModel.
+ *
+ * @return	The count of shown records
+ */
+int TrafficLogView::getNumRows()
+{
+	return m_rowCount;
+}
+
+/**
+ * Reimplemented from ListBoxModel. Called for the visible rows only, so a record is formatted only when it is painted.
+ *
+ * @param rowNumber		The index of the row in the shown records
+ * @param g				The graphics object to use for painting
+ * @param width			The width of the row
+ * @param height		The height of the row
+ * @param rowIsSelected	Flag if the row is selected
+ */
+void TrafficLogView::paintListBoxItem(int rowNumber, Graphics& g, int width, int height, bool rowIsSelected)
+{
+	if (rowNumber < 0 || rowNumber >= m_rowCount)
+		return;
+
+	int capacity = static_cast<int>(m_records.size());
+	uint64 recordNumber = m_rows[static_cast<size_t>((m_firstRow + rowNumber) % capacity)];
+	const TrafficLogRecord& record = m_records[static_cast<size_t>(recordNumber % uint64(capacity))];
+
+	if (rowIsSelected)
+		g.fillAll(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::highlightColourId));
+
+	g.setColour(getLookAndFeel().findColour(CodeEditorComponent::ColourIds::defaultTextColourId));
+	g.setFont(Font(Font::getDefaultMonospacedFontName(), float(height) * 0.8f, Font::plain));
+	g.drawText(FormatLogRecord(record), UIS_Margin_s, 0, width - UIS_Margin_s, height, Justification::centredLeft, false);
+}
+
+
 //==============================================================================
 // Class LoggingComponent
 //==============================================================================
@@ -248,11 +504,56 @@ void PlotComponent::resized()
  * Class constructor.
  */
 LoggingComponent::LoggingComponent()
+	: m_flushRecords(static_cast<size_t>(m_trafficLog.GetCapacity()))
 {
 	m_parentListener = 0;
-
-	m_textBox = std::make_unique<CodeEditorComponent>(m_doc, nullptr);
-	addChildComponent(m_textBox.get());
+	m_shownDrops = 0;
+
+	m_logView = std::make_unique<TrafficLogView>();
+	addChildComponent(m_logView.get());
+
+	m_nodeFilterEdit = std::make_unique<TextEditor>();
+	m_nodeFilterEdit->setInputRestrictions(5, "0123456789");
+	m_nodeFilterEdit->addListener(this);
+	addChildComponent(m_nodeFilterEdit.get());
+	m_nodeFilterLabel = std::make_unique<Label>();
+	m_nodeFilterLabel->setText("Node", dontSendNotification);
+	m_nodeFilterLabel->setColour(Label::textColourId, Colours::white);
+	m_nodeFilterLabel->setJustificationType(Justification::right);
+	m_nodeFilterLabel->attachToComponent(m_nodeFilterEdit.get(), true);
+
+	m_protocolFilterEdit = std::make_unique<TextEditor>();
+	m_protocolFilterEdit->setInputRestrictions(5, "0123456789");
+	m_protocolFilterEdit->addListener(this);
+	addChildComponent(m_protocolFilterEdit.get());
+	m_protocolFilterLabel = std::make_unique<Label>();
+	m_protocolFilterLabel->setText("Protocol", dontSendNotification);
+	m_protocolFilterLabel->setColour(Label::textColourId, Colours::white);
+	m_protocolFilterLabel->setJustificationType(Justification::right);
+	m_protocolFilterLabel->attachToComponent(m_protocolFilterEdit.get(), true);
+
+	m_objectFilterDrop = std::make_unique<ComboBox>();
+	m_objectFilterDrop->addItem("All", ROI_Invalid);
+	for (int i = ROI_Invalid + 1; i < ROI_UserMAX; ++i)
+		m_objectFilterDrop->addItem(ProcessingEngineConfig::GetObjectDescription(RemoteObjectIdentifier(i)), i);
+	m_objectFilterDrop->setSelectedId(ROI_Invalid, dontSendNotification);
+	m_objectFilterDrop->addListener(this);
+	addChildComponent(m_objectFilterDrop.get());
+	m_objectFilterLabel = std::make_unique<Label>();
+	m_objectFilterLabel->setText("Object", dontSendNotification);
+	m_objectFilterLabel->setColour(Label::textColourId, Colours::white);
+	m_objectFilterLabel->setJustificationType(Justification::right);
+	m_objectFilterLabel->attachToComponent(m_objectFilterDrop.get(), true);
+
+	m_channelFilterEdit = std::make_unique<TextEditor>();
+	m_channelFilterEdit->setInputRestrictions(5, "0123456789");
+	m_channelFilterEdit->addListener(this);
+	addChildComponent(m_channelFilterEdit.get());
+	m_channelFilterLabel = std::make_unique<Label>();
+	m_channelFilterLabel->setText("Ch", dontSendNotification);
+	m_channelFilterLabel->setColour(Label::textColourId, Colours::white);
+	m_channelFilterLabel->setJustificationType(Justification::right);
+	m_channelFilterLabel->attachToComponent(m_channelFilterEdit.get(), true);
 
 	m_plotBox = std::make_unique<PlotComponent>();
 	addChildComponent(m_plotBox.get());
@@ -270,6 +571,11 @@ LoggingComponent::LoggingComponent()
 	addAndMakeVisible(m_closeButton.get());
 	m_closeButton->addListener(this);
 
+	m_statusLabel = std::make_unique<Label>();
+	m_statusLabel->setColour(Label::textColourId, Colours::white);
+	m_statusLabel->setJustificationType(Justification::centred);
+	addAndMakeVisible(m_statusLabel.get());
+
 	startTimer(ET_LoggingFlushRate);
 }
 
@@ -278,62 +584,81 @@ LoggingComponent::LoggingComponent()
  */
 LoggingComponent::~LoggingComponent()
 {
-	removeChildComponent(m_textBox.get());
-	m_textBox.reset();
+	removeChildComponent(m_logView.get());
+	m_logView.reset();
 }
 
 /**
- * Sets a logging message to logging queue
- *
- * @param messageString	The message text string to add to logging queue
+ * Reimplemented from Timer - called every timeout timer
+ * 
+ * Takes the records of all messages logged since the last call out of the ring.
+ * They are added to the message log history and, in graph mode, counted for the plot.
+ * Nothing is formatted here, the log view only formats the rows it paints.
  */
-void LoggingComponent::AddMessage(String messageString)
+void LoggingComponent::timerCallback()
 {
-	if (m_mode==LM_Text)
+	int recordCount = 0;
+	while (recordCount < static_cast<int>(m_flushRecords.size()) && m_trafficLog.Pop(m_flushRecords[static_cast<size_t>(recordCount)]))
+		++recordCount;
+
+	if (m_logView)
+		m_logView->AddRecords(m_flushRecords.data(), recordCount);
+
+	if (m_plotBox && m_mode == LM_Graph)
 	{
-		m_loggingQueue.push_back(messageString);
+		for (int i = 0; i < recordCount; ++i)
+			m_plotBox->IncreaseCount(m_flushRecords[static_cast<size_t>(i)].NId, m_flushRecords[static_cast<size_t>(i)].Message.PId);
 	}
+
+	if (recordCount > 0 || m_trafficLog.GetDroppedCount() != m_shownDrops)
+		UpdateStatus();
 }
 
 /**
- * Sets multiple logging messages to logging queue
- *
- * @param messageStrings	The message text strings to add to logging queue
+ * Helper method to set the filter of the log view from the current filter control values.
+ * Empty edits and the 'All' object entry match all records.
  */
-void LoggingComponent::AddMessages(const Array<String>& messageStrings)
+void LoggingComponent::ApplyFilter()
 {
-	if (m_mode == LM_Text)
-	{
-		for (const String& message : messageStrings)
-		{
-			m_loggingQueue.push_back(message);
-		}
-	}
+	if (!m_logView)
+		return;
+
+	TrafficLogView::Filter filter;
+	if (m_nodeFilterEdit && m_nodeFilterEdit->getText().isNotEmpty())
+		filter.NId = m_nodeFilterEdit->getText().getIntValue();
+	if (m_protocolFilterEdit && m_protocolFilterEdit->getText().isNotEmpty())
+		filter.PId = m_protocolFilterEdit->getText().getIntValue();
+	if (m_objectFilterDrop && m_objectFilterDrop->getSelectedId() > ROI_Invalid)
+		filter.Id = RemoteObjectIdentifier(m_objectFilterDrop->getSelectedId());
+	if (m_channelFilterEdit && m_channelFilterEdit->getText().isNotEmpty())
+		filter.Channel = m_channelFilterEdit->getText().getIntValue();
+
+	m_logView->SetFilter(filter);
+	UpdateStatus();
 }
 
 /**
- * Reimplemented from Timer - called every timeout timer
- * 
- * Iterates over logging queue and adds all queued messages
- * to end of text area and terminates with a newline
+ * Helper method to update the status label with the count of shown messages
+ * and the count of messages that were not logged because the traffic log ring was full.
  */
-void LoggingComponent::timerCallback()
+void LoggingComponent::UpdateStatus()
 {
-	if (m_textBox && m_mode == LM_Text)
-	{
-		m_textBox->moveCaretToEnd(false);
-		for (const String& message : m_loggingQueue)
-		{
-			m_textBox->insertTextAtCaret(message);
-			m_textBox->insertTextAtCaret("\n");
-		}
-	}
+	if (!m_statusLabel || !m_logView)
+		return;
+
+	m_shownDrops = m_trafficLog.GetDroppedCount();
+
+	String status = String(m_logView->GetShownCount()) + " of " + String(m_logView->GetRecordCount()) + " shown";
+	if (m_shownDrops > 0)
+		status << ", " << String(m_shownDrops) << " not logged";
 
-	m_loggingQueue.clear();
+	m_statusLabel->setText(status, dontSendNotification);
 }
 
 /**
- * Overloaded method to add logging entry data to componentn
+ * Overloaded method to add logging entry data to componentn.
+ * Only a binary record of the data is written to the traffic log ring, the record is formatted later on the message thread.
+ * This does not block or allocate, so it can be called from the engine threads without delaying the message processing.
  *
  * @param NId			The node id the logging data comes from
  * @param SenderPId		The protocol id of the protocol the data was received at
@@ -343,58 +668,7 @@ void LoggingComponent::timerCallback()
  */
 void LoggingComponent::AddLogData(NodeId NId, ProtocolId SenderPId, ProtocolType SenderType, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData)
 {
-	if (m_mode == LM_Text)
-	{
-		String objectString;
-		switch (SenderType)
-		{
-		case PT_OSCProtocol:
-			objectString += OSCProtocolProcessor::GetRemoteObjectString(Id) +
-				String::formatted(" | ch%d rec%d", msgData.addrVal.first, msgData.addrVal.second);
-			break;
-		case PT_OCAProtocol:
-			objectString += OCAProtocolProcessor::GetRemoteObjectString(Id) +
-				String::formatted(" | ch%d rec%d", msgData.addrVal.first, msgData.addrVal.second);
-			break;
-		default:
-			break;
-		}
-
-		if (msgData.payload != 0)
-		{
-			objectString += " |";
-
-			if (msgData.valType == ROVT_FLOAT)
-			{
-				float fvalue;
-				for (int i = 0; i < msgData.valCount; ++i)
-				{
-					fvalue = ((float*)msgData.payload)[i];
-					objectString += String::formatted(" %f", fvalue);
-				}
-			}
-			else if (msgData.valType == ROVT_INT)
-			{
-				int ivalue;
-				for (int i = 0; i < msgData.valCount; ++i)
-				{
-					ivalue = ((int*)msgData.payload)[i];
-					objectString += String::formatted(" %d", ivalue);
-				}
-			}
-		}
-
-		String SenderName = ProcessingEngineConfig::ProtocolTypeToString(SenderType);
-		String logString;
-		logString << "Node" << (int)NId << "[In:" << SenderName << ":PId" << (int)SenderPId << "]: " << objectString;
-
-		AddMessage(logString);
-	}
-	else if (m_mode == LM_Graph)
-	{
-		if (m_plotBox)
-			m_plotBox->IncreaseCount(NId, SenderPId);
-	}
+	m_trafficLog.Push(NId, SenderType, SenderPId, Id, msgData);
 }
 
 /**
@@ -412,25 +686,36 @@ void LoggingComponent::SetLoggingMode(LoggingMode mode)
 		switch (m_mode)
 		{
 		case LM_Text:
-			if (m_textBox)
-				m_textBox->setVisible(true);
+			if (m_logView)
+				m_logView->setVisible(true);
 			if (m_plotBox)
 				m_plotBox->setVisible(false);
 			break;
 		case LM_Graph:
-			if (m_textBox)
-				m_textBox->setVisible(false);
+			if (m_logView)
+				m_logView->setVisible(false);
 			if (m_plotBox)
 				m_plotBox->setVisible(true);
 			break;
 		case LM_INVALID:
 		default:
-			if (m_textBox)
-				m_textBox->setVisible(false);
+			if (m_logView)
+				m_logView->setVisible(false);
 			if (m_plotBox)
 				m_plotBox->setVisible(false);
 			break;
 		}
+
+		// the filter only applies to the message log
+		bool showFilter = (m_mode == LM_Text);
+		if (m_nodeFilterEdit)
+			m_nodeFilterEdit->setVisible(showFilter);
+		if (m_protocolFilterEdit)
+			m_protocolFilterEdit->setVisible(showFilter);
+		if (m_objectFilterDrop)
+			m_objectFilterDrop->setVisible(showFilter);
+		if (m_channelFilterEdit)
+			m_channelFilterEdit->setVisible(showFilter);
 	}
 }
 
@@ -476,9 +761,25 @@ void LoggingComponent::resized()
 	int yPositionCloseButton = yPositionModeDrop;
 	m_closeButton->setBounds(xPositionCloseButton, yPositionCloseButton, UIS_OpenConfigWidth, UIS_ElmSize);
 
+	/*Status Label*/
+	int xPositionStatusLabel = xPositionModeDrop + UIS_OpenConfigWidth + UIS_Margin_m;
+	m_statusLabel->setBounds(xPositionStatusLabel, yPositionModeDrop, xPositionCloseButton - UIS_Margin_m - xPositionStatusLabel, UIS_ElmSize);
+
+	/*Filter controls, each edit with its label attached on the left*/
+	int yPositionFilter = yPositionCloseButton - UIS_Margin_m - UIS_ElmSize;
+	int xPositionFilter = UIS_Margin_m + 40;
+	m_nodeFilterEdit->setBounds(xPositionFilter, yPositionFilter, 40, UIS_ElmSize);
+	xPositionFilter += 40 + UIS_Margin_m + 60;
+	m_protocolFilterEdit->setBounds(xPositionFilter, yPositionFilter, 40, UIS_ElmSize);
+	xPositionFilter += 40 + UIS_Margin_m + 50;
+	int objectFilterWidth = windowWidth - xPositionFilter - UIS_Margin_m - 30 - 40 - UIS_Margin_m;
+	m_objectFilterDrop->setBounds(xPositionFilter, yPositionFilter, objectFilterWidth, UIS_ElmSize);
+	xPositionFilter += objectFilterWidth + UIS_Margin_m + 30;
+	m_channelFilterEdit->setBounds(xPositionFilter, yPositionFilter, 40, UIS_ElmSize);
+
 	/*Logging Component*/
 	int loggingComponentHeight = yPositionCloseButton - UIS_Margin_m;
-	m_textBox->setBounds(Rectangle<int>(0, 0, windowWidth, loggingComponentHeight));
+	m_logView->setBounds(Rectangle<int>(0, 0, windowWidth, yPositionFilter - UIS_Margin_m));
 	m_plotBox->setBounds(Rectangle<int>(0, 0, windowWidth, loggingComponentHeight));
 }
 
@@ -505,6 +806,24 @@ void LoggingComponent::comboBoxChanged(ComboBox* comboBox)
 	{
 		SetLoggingMode((LoggingMode)m_LogModeDrop->getSelectedId());
 	}
+	else if (m_objectFilterDrop && (m_objectFilterDrop.get() == comboBox))
+	{
+		ApplyFilter();
+	}
+}
+
+/**
+ * Overloaded method called by TextEditor objects on textchange events.
+ * Every change of a filter edit is applied to the message log right away.
+ *
+ * @param textEdit	The TextEditor object whose text has been changed
+ */
+void LoggingComponent::textEditorTextChanged(TextEditor& textEdit)
+{
+	if (&textEdit == m_nodeFilterEdit.get() || &textEdit == m_protocolFilterEdit.get() || &textEdit == m_channelFilterEdit.get())
+	{
+		ApplyFilter();
+	}
 }
 
 /*
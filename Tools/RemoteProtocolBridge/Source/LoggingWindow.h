@@ -38,6 +38,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "LoggingTarget_Interface.h"
 #include "ProcessingEngine.h"
+#include "TrafficLogRing.h"
 
 // Fwd. Declarations
 class MainRemoteProtocolBridgeComponent;
@@ -86,6 +87,66 @@ private:
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlotComponent)
 };
 
+/**
+ * Class TrafficLogView shows the latest traffic log records as a scrollable list of log lines.
+ * The records are kept in a fixed-capacity history, the oldest are overwritten once it is full.
+ * Only the rows currently visible are formatted and painted, so memory and per-frame cost do not grow with the logging time.
+ */
+class TrafficLogView : public Component,
+	private ListBoxModel
+{
+public:
+	/**
+	 * Criteria the records have to match to be shown. Compared against the binary record fields.
+	 */
+	struct Filter
+	{
+		int						NId;		/**< The node id to show, or -1 for all nodes. */
+		int						PId;		/**< The protocol id to show, or -1 for all protocols. */
+		RemoteObjectIdentifier	Id;			/**< The remote object id to show, or ROI_Invalid for all objects. */
+		int						Channel;	/**< The channel (first address value) to show, or -1 for all channels. */
+
+		Filter();
+		bool Matches(const TrafficLogRecord& record) const;
+	};
+
+public:
+	TrafficLogView(int capacity = EBS_TrafficLogHistorySize);
+	~TrafficLogView();
+
+	//==============================================================================
+	void AddRecords(const TrafficLogRecord* records, int count);
+	void SetFilter(const Filter& filter);
+
+	int GetRecordCount() const;
+	int GetShownCount() const;
+
+	//==============================================================================
+	static String FormatLogRecord(const TrafficLogRecord& record);
+
+	//==============================================================================
+	void resized() override;
+
+private:
+	//==============================================================================
+	int getNumRows() override;
+	void paintListBoxItem(int rowNumber, Graphics& g, int width, int height, bool rowIsSelected) override;
+
+private:
+	std::unique_ptr<ListBox>		m_listBox;		/**< The list box that creates and paints rows only for the visible part of the list. */
+
+	std::vector<TrafficLogRecord>	m_records;		/**< The preallocated history of the latest records. Record number n is stored at n modulo capacity. */
+	uint64							m_recordCount;	/**< Count of records ever added. The history holds the last (up to capacity) of them. */
+
+	std::vector<uint64>				m_rows;			/**< Ring of the numbers of the records in the history that match the filter, in ascending order. */
+	int								m_firstRow;		/**< The position of the first shown record number in the rows ring. */
+	int								m_rowCount;		/**< Count of the shown record numbers in the rows ring. */
+
+	Filter							m_filter;		/**< The criteria the shown records match. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrafficLogView)
+};
+
 /**
  * Class GlobalConfigComponent is a container used to hold the GUI controls for modifying the app configuration.
  */
@@ -117,8 +178,8 @@ public:
 
 private:
 	//==============================================================================
-	void AddMessage(String messageString);
-	void AddMessages(const Array<String>& messageStrings);
+	void				ApplyFilter();
+	void				UpdateStatus();
 
 	//==============================================================================
 	static String		LogModeToString(LoggingMode lm);
@@ -130,14 +191,14 @@ private:
 
 	void buttonClicked(Button* button) override;
 	void comboBoxChanged(ComboBox* comboBox) override;
+	void textEditorTextChanged(TextEditor& textEdit) override;
 
 	void timerCallback() override;
 
 private:
 	LoggingWindow*							m_parentListener;	/**< Parent that needs to be notified when this window self-destroys. */
 
-	std::unique_ptr<CodeEditorComponent>	m_textBox;			/**< The actual component to show log text within window. */
-	CodeDocument							m_doc;				/**< Document object used by codeeditorcomponent for content. */
+	std::unique_ptr<TrafficLogView>			m_logView;			/**< The actual component to show the message log within window. */
 
 	std::unique_ptr<PlotComponent>			m_plotBox;			/**< The actual component to show logging graph plot. */
 
@@ -145,8 +206,20 @@ private:
 
 	std::unique_ptr<ComboBox>				m_LogModeDrop;		/**< Dropdown for logging mode selection. */
 	std::unique_ptr<TextButton>				m_closeButton;		/**< Button to close the window - identical to Windows titlebar close functionality. */
-
-	std::vector<String>						m_loggingQueue;		/**< List of message strings to be printed on next flush timer callback. */
+	std::unique_ptr<Label>					m_statusLabel;		/**< Label to show the count of shown and not logged messages. */
+
+	std::unique_ptr<TextEditor>				m_nodeFilterEdit;		/**< Edit for the node id the message log is filtered by. Empty for all nodes. */
+	std::unique_ptr<Label>					m_nodeFilterLabel;		/**< Label for the node filter edit. */
+	std::unique_ptr<TextEditor>				m_protocolFilterEdit;	/**< Edit for the protocol id the message log is filtered by. Empty for all protocols. */
+	std::unique_ptr<Label>					m_protocolFilterLabel;	/**< Label for the protocol filter edit. */
+	std::unique_ptr<ComboBox>				m_objectFilterDrop;		/**< Dropdown for the remote object the message log is filtered by. */
+	std::unique_ptr<Label>					m_objectFilterLabel;	/**< Label for the object filter dropdown. */
+	std::unique_ptr<TextEditor>				m_channelFilterEdit;	/**< Edit for the channel the message log is filtered by. Empty for all channels. */
+	std::unique_ptr<Label>					m_channelFilterLabel;	/**< Label for the channel filter edit. */
+
+	TrafficLogRing							m_trafficLog;		/**< Ring of binary records of the logged messages, written by the engine threads and formatted on next flush timer callback. */
+	std::vector<TrafficLogRecord>			m_flushRecords;		/**< Preallocated buffer to take the records out of the ring on flush. */
+	uint32									m_shownDrops;		/**< The count of records dropped by the full ring that is currently shown in the status. */
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoggingComponent)
 };
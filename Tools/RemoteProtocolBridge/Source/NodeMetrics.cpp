@@ -0,0 +1,194 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "NodeMetrics.h"
+
+
+// **************************************************************************************
+//    class NodeMetrics
+// **************************************************************************************
+/**
+ * Constructor
+ */
+NodeMetrics::NodeMetrics()
+{
+}
+
+/**
+ * Destructor
+ */
+NodeMetrics::~NodeMetrics()
+{
+}
+
+/**
+ * Method to register a protocol of the node to be counted separately.
+ * Must not be called while messages are counted.
+ *
+ * @param PId	The id of the protocol.
+ */
+void NodeMetrics::AddProtocol(ProtocolId PId)
+{
+	if (m_protocolCounters.count(PId) == 0)
+		m_protocolCounters[PId] = std::make_unique<MessageCounters>();
+}
+
+/**
+ * Method to reset all counters and recorded latencies.
+ * Must not be called while messages are counted.
+ */
+void NodeMetrics::Clear()
+{
+	for (int i = 0; i < MC_UserMAX; ++i)
+	{
+		m_nodeCounters.Counts[i] = 0;
+		for (int j = 0; j < ROI_UserMAX; ++j)
+			m_objectCounters[j].Counts[i] = 0;
+	}
+
+	m_protocolCounters.clear();
+	m_latencies.Reset();
+}
+
+/**
+ * Method to count a message. Can be called from any thread.
+ *
+ * @param counter	The counter to increment.
+ * @param PId		The id of the protocol the message was received by or sent to.
+ * @param Id		The remote object id of the message.
+ */
+void NodeMetrics::Count(MetricsCounter counter, ProtocolId PId, RemoteObjectIdentifier Id)
+{
+	if (counter < 0 || counter >= MC_UserMAX)
+		return;
+
+	++m_nodeCounters.Counts[counter];
+
+	std::map<ProtocolId, std::unique_ptr<MessageCounters>>::const_iterator piter = m_protocolCounters.find(PId);
+	if (piter != m_protocolCounters.end())
+		++piter->second->Counts[counter];
+
+	if (Id >= 0 && Id < ROI_UserMAX)
+		++m_objectCounters[Id].Counts[counter];
+}
+
+/**
+ * Method to record the latency from receiving a message to forwarding it. Can be called from any thread.
+ *
+ * @param latency	The latency in ms.
+ */
+void NodeMetrics::RecordLatency(double latency)
+{
+	m_latencies.Record(latency);
+}
+
+/**
+ * Getter for a counter of all messages of the node.
+ *
+ * @param counter	The counter to get.
+ * @return	The count of messages.
+ */
+uint64 NodeMetrics::GetCount(MetricsCounter counter) const
+{
+	if (counter < 0 || counter >= MC_UserMAX)
+		return 0;
+
+	return m_nodeCounters.Counts[counter].get();
+}
+
+/**
+ * Getter for a counter of the messages of a protocol.
+ *
+ * @param counter	The counter to get.
+ * @param PId		The id of the protocol.
+ * @return	The count of messages, 0 if the protocol is not known.
+ */
+uint64 NodeMetrics::GetProtocolCount(MetricsCounter counter, ProtocolId PId) const
+{
+	std::map<ProtocolId, std::unique_ptr<MessageCounters>>::const_iterator piter = m_protocolCounters.find(PId);
+	if (counter < 0 || counter >= MC_UserMAX || piter == m_protocolCounters.end())
+		return 0;
+
+	return piter->second->Counts[counter].get();
+}
+
+/**
+ * Getter for a counter of the messages of a remote object id.
+ *
+ * @param counter	The counter to get.
+ * @param Id		The remote object id.
+ * @return	The count of messages.
+ */
+uint64 NodeMetrics::GetObjectCount(MetricsCounter counter, RemoteObjectIdentifier Id) const
+{
+	if (counter < 0 || counter >= MC_UserMAX || Id < 0 || Id >= ROI_UserMAX)
+		return 0;
+
+	return m_objectCounters[Id].Counts[counter].get();
+}
+
+/**
+ * Getter for the recorded latencies from receiving a message to forwarding it.
+ *
+ * @return	The latency histogram.
+ */
+const LatencyHistogram& NodeMetrics::GetLatencyHistogram() const
+{
+	return m_latencies;
+}
+
+/**
+ * Helper to resolve a counter to the name it is published with.
+ *
+ * @param counter	The counter to get the name for.
+ * @return	The name of the counter.
+ */
+String NodeMetrics::GetCounterName(MetricsCounter counter)
+{
+	switch (counter)
+	{
+	case MC_Received:
+		return "Received";
+	case MC_Sent:
+		return "Sent";
+	case MC_Filtered:
+		return "Filtered";
+	case MC_Dropped:
+		return "Dropped";
+	case MC_UserMAX:
+	default:
+		return "";
+	}
+}
@@ -0,0 +1,86 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+#include "LatencyHistogram.h"
+
+#include <JuceHeader.h>
+
+#include <map>
+
+
+/**
+ * Class NodeMetrics counts the message traffic of a processing node, per node, per protocol and per remote object id,
+ * and records the latency from receiving a message to forwarding it.
+ * The protocols are registered while the node is configured. Counting afterwards is lock-free and does not allocate,
+ * so it can be done from the network, worker and timer threads of the node while the metrics are read concurrently.
+ */
+class NodeMetrics
+{
+public:
+	NodeMetrics();
+	~NodeMetrics();
+
+	void AddProtocol(ProtocolId PId);
+	void Clear();
+
+	void Count(MetricsCounter counter, ProtocolId PId, RemoteObjectIdentifier Id);
+	void RecordLatency(double latency);
+
+	uint64 GetCount(MetricsCounter counter) const;
+	uint64 GetProtocolCount(MetricsCounter counter, ProtocolId PId) const;
+	uint64 GetObjectCount(MetricsCounter counter, RemoteObjectIdentifier Id) const;
+	const LatencyHistogram& GetLatencyHistogram() const;
+
+	static String GetCounterName(MetricsCounter counter);
+
+private:
+	/**
+	 * The message counters of a single node, protocol or remote object id.
+	 */
+	struct MessageCounters
+	{
+		Atomic<uint64>	Counts[MC_UserMAX];	/**< The message count per counter type. */
+	};
+
+	MessageCounters												m_nodeCounters;					/**< The counters of all messages of the node. */
+	std::map<ProtocolId, std::unique_ptr<MessageCounters>>		m_protocolCounters;				/**< The counters per protocol. Only modified while the node is configured. */
+	MessageCounters												m_objectCounters[ROI_UserMAX];	/**< The counters per remote object id. */
+	LatencyHistogram											m_latencies;					/**< The latencies from receiving a message to forwarding it, in ms. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NodeMetrics)
+};
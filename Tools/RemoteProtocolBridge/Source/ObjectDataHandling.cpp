@@ -523,6 +523,9 @@ Forward_only_valueChanges::Forward_only_valueChanges(ProcessingEngineNode* paren
 {
 	SetMode(ObjectHandlingMode::OHM_Forward_only_valueChanges);
 	m_precision = 0.001f;
+	m_valueStoreChannels = 0;
+
+	ResizeValueStore(EBS_ValueStoreChannels);
 }
 
 /**
@@ -530,19 +533,6 @@ Forward_only_valueChanges::Forward_only_valueChanges(ProcessingEngineNode* paren
  */
 Forward_only_valueChanges::~Forward_only_valueChanges()
 {
-	for (std::pair<RemoteObjectIdentifier, std::map<RemoteObjectAddressing, RemoteObjectMessageData>> roi : m_currentValues)
-	{
-		for (std::pair<RemoteObjectAddressing, RemoteObjectMessageData> val : roi.second)
-		{
-			delete val.second.payload;
-	
-			val.second.payload = nullptr;
-			val.second.payloadSize = 0;
-			val.second.valCount = 0;
-		}
-	}
-	
-	m_currentValues.clear();
 }
 
 /**
@@ -556,6 +546,48 @@ void Forward_only_valueChanges::SetObjectHandlingConfiguration(const ProcessingE
 	ObjectDataHandling_Abstract::SetObjectHandlingConfiguration(config, NId);
 
 	m_precision = static_cast<float>(config.GetObjectHandlingData(NId).Prec);
+
+	// Size the value store to hold all channels the node's protocols can address,
+	// incl. the absolute channel numbers that multiplexing modes map to.
+	int channelCount = EBS_ValueStoreChannels;
+	channelCount = jmax(channelCount, config.GetObjectHandlingData(NId).ACnt * config.GetProtocolAIds(NId).size());
+	channelCount = jmax(channelCount, config.GetObjectHandlingData(NId).BCnt * config.GetProtocolBIds(NId).size());
+
+	ResizeValueStore(channelCount);
+}
+
+/**
+ * Helper method to (re-)allocate the value store for the given count of channels.
+ * All previously stored values are discarded.
+ *
+ * @param channelCount	The highest channel number that values shall be stored for.
+ */
+void Forward_only_valueChanges::ResizeValueStore(int channelCount)
+{
+	// Channel slots cover the invalid addressing value (-1) and 0 as well
+	m_valueStoreChannels = jlimit(0, static_cast<int>(std::numeric_limits<int16>::max()), channelCount) + 2;
+
+	m_currentValues.calloc(static_cast<size_t>(ROI_UserMAX) * EBS_ValueStoreRecords * m_valueStoreChannels);
+}
+
+/**
+ * Helper method to look up the value store entry for the given object and addressing.
+ *
+ * @param Id		The ROI to get the stored value for
+ * @param roAddr	The remote object addressing to get the stored value for
+ * @return			The pointer to the stored value, or nullptr if the object or addressing is out of the value store range
+ */
+Forward_only_valueChanges::StoredValue* Forward_only_valueChanges::GetStoredValue(const RemoteObjectIdentifier Id, const RemoteObjectAddressing& roAddr)
+{
+	int channelIdx = roAddr.first + 1;
+	int recordIdx = roAddr.second + 1;
+
+	if (Id < 0 || Id >= ROI_UserMAX
+		|| channelIdx < 0 || channelIdx >= m_valueStoreChannels
+		|| recordIdx < 0 || recordIdx >= EBS_ValueStoreRecords)
+		return nullptr;
+
+	return m_currentValues + ((static_cast<size_t>(Id) * EBS_ValueStoreRecords + recordIdx) * m_valueStoreChannels + channelIdx);
 }
 
 /**
@@ -620,125 +652,44 @@ bool Forward_only_valueChanges::IsChangedDataValue(const RemoteObjectIdentifier
 	if (m_precision == 0)
 		return true;
 
-	bool isChangedDataValue = false;
-
-	// if our hash does not yet contain our ROI, initialize it
-	if ((m_currentValues.count(Id) == 0) || (m_currentValues.at(Id).count(roAddr) == 0))
+	// Values that cannot be held inline are not filtered and always forwarded
+	if (msgData.valCount > MAX_REMOTE_OBJECT_VALUE_COUNT || msgData.valType == ROVT_STRING || msgData.payloadSize > sizeof(StoredValue::values))
 	{
-		isChangedDataValue = true;
+		jassert(msgData.valType != ROVT_STRING); // String not (yet?) supported
+		return true;
 	}
-	else
-	{
-		const RemoteObjectMessageData& currentVal = m_currentValues.at(Id).at(roAddr);
-		if ((currentVal.valType != msgData.valType) || (currentVal.valCount != msgData.valCount) || (currentVal.payloadSize != msgData.payloadSize))
-		{
-			isChangedDataValue = true;
-		}
-		else
-		{
-			uint16 valCount = currentVal.valCount;
-			RemoteObjectValueType valType = currentVal.valType;
-			void *refData = currentVal.payload;
-			void *newData = msgData.payload;
-	
-			int referencePrecisionValue = 0;
-			int newPrecisionValue = 0;
-	
-			bool changeFound = false;
-			for (int i = 0; i < valCount; ++i)
-			{
-				switch (valType)
-				{
-				case ROVT_INT:
-				{
-					// convert payload to correct pointer type
-					int *refVal = static_cast<int*>(refData);
-					int *newVal = static_cast<int*>(newData);
-					// grab actual value
-					referencePrecisionValue = *refVal;
-					newPrecisionValue = *newVal;
-					// increase pointer to next value (to access it in next valCount loop iteration)
-					refData = refVal + 1;
-					newData = newVal + 1;
-				}
-				break;
-				case ROVT_FLOAT:
-				{
-					// convert payload to correct pointer type
-					float *refVal = static_cast<float*>(refData);
-					float *newVal = static_cast<float *>(newData);
-					// grab actual value and apply precision to get a comparable value
-					referencePrecisionValue = static_cast<int>(std::roundf(*refVal / m_precision));
-					newPrecisionValue = static_cast<int>(std::roundf(*newVal / m_precision));
-					// increase pointer to next value (to access it in next valCount loop iteration)
-					refData = refVal + 1;
-					newData = newVal + 1;
-				}
-				break;
-				case ROVT_STRING:
-					jassertfalse; // String not (yet?) supported
-					changeFound = true;
-					break;
-				case ROVT_NONE:
-				default:
-					changeFound = true;
-					break;
-				}
-
 
-				if (referencePrecisionValue != newPrecisionValue)
-					changeFound = true;
-			}
+	StoredValue* currentVal = GetStoredValue(Id, roAddr);
+	if (currentVal == nullptr)
+		return true;
 
-			isChangedDataValue = changeFound;
-		}
-	}
+	bool isChangedDataValue = !currentVal->valid
+		|| ProcessingEngineConfig::IsChangedValue(currentVal->valType, currentVal->valCount, &currentVal->values, msgData, m_precision);
 
 	if (isChangedDataValue && setAsNewCurrentData)
-		SetCurrentDataValue(Id, roAddr, msgData);
+		currentVal->Set(msgData);
 
 	return isChangedDataValue;
 }
 
 /**
- * Helper method to set a new RemoteObjectMessageData obj. to internal map of current values.
- * Takes care of cleaning up previously stored data if required.
+ * Helper method to set a new RemoteObjectMessageData obj. to internal store of current values.
+ * Data that cannot be held inline or addressing out of the store range is ignored.
  *
- * @param Id	The ROI that shall be stored
+ * @param Id		The ROI that shall be stored
+ * @param roAddr	The remote object addressing the data shall be stored for
  * @param msgData	The message data that shall be stored
  */
 void Forward_only_valueChanges::SetCurrentDataValue(const RemoteObjectIdentifier Id, const RemoteObjectAddressing& roAddr, const RemoteObjectMessageData& msgData)
 {
-	// Check if the new data value addressing is currently not present in internal hash
-	// or if it differs in its value size and needs to be reinitialized
-	if ((m_currentValues.count(Id) == 0) || (m_currentValues.at(Id).count(roAddr) == 0) ||
-		(m_currentValues.at(Id).at(roAddr).payloadSize != msgData.payloadSize))
-	{
-		// If the data value exists, but has wrong size, reinitialize it
-		if ((m_currentValues.count(Id) != 0) && (m_currentValues.at(Id).count(roAddr) != 0) &&
-			(m_currentValues.at(Id).at(roAddr).payloadSize != msgData.payloadSize))
-		{
-			delete m_currentValues.at(Id).at(roAddr).payload;
-			m_currentValues.at(Id).at(roAddr).payload = nullptr;
-			m_currentValues.at(Id).at(roAddr).payloadSize = 0;
-			m_currentValues.at(Id).at(roAddr).valCount = 0;
-		}
-	
-		RemoteObjectMessageData dataCopy = msgData;
-	
-		dataCopy.payload = new unsigned char[msgData.payloadSize];
-		memcpy(dataCopy.payload, msgData.payload, msgData.payloadSize);
-	
-		m_currentValues[Id][roAddr] = dataCopy;
-	}
-	else
-	{
-		// do not copy entire data struct, since we need to keep our payload ptr
-		m_currentValues.at(Id).at(roAddr).addrVal = roAddr;
-		m_currentValues.at(Id).at(roAddr).valCount = msgData.valCount;
-		m_currentValues.at(Id).at(roAddr).valType = msgData.valType;
-		memcpy(m_currentValues.at(Id).at(roAddr).payload, msgData.payload, msgData.payloadSize);
-	}
+	if (msgData.valCount > MAX_REMOTE_OBJECT_VALUE_COUNT || msgData.valType == ROVT_STRING || msgData.payloadSize > sizeof(StoredValue::values))
+		return;
+
+	StoredValue* currentVal = GetStoredValue(Id, roAddr);
+	if (currentVal == nullptr)
+		return;
+
+	currentVal->Set(msgData);
 }
 
 
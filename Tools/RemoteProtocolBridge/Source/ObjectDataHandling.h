@@ -168,8 +168,42 @@ protected:
 	void SetCurrentDataValue(const RemoteObjectIdentifier Id, const RemoteObjectAddressing& roAddr, const RemoteObjectMessageData& msgData);
 
 private:
-	std::map<RemoteObjectIdentifier, std::map<RemoteObjectAddressing, RemoteObjectMessageData>>	m_currentValues;	/**< Hash of current value data to use to compare to incoming data regarding value changes. */
-	float m_precision;																								/**< Value precision to use for processing. */
+	/**
+	 * Dataset holding the current value of a single remote object in the value store, with its payload held inline.
+	 */
+	struct StoredValue
+	{
+		bool					valid;		/**< Indication if a value has been stored yet. */
+		RemoteObjectValueType	valType;	/**< Datatype of the stored values. */
+		uint16					valCount;	/**< Count of the stored values. */
+		union
+		{
+			int		intValues[MAX_REMOTE_OBJECT_VALUE_COUNT];	/**< Value storage for ROVT_INT data. */
+			float	floatValues[MAX_REMOTE_OBJECT_VALUE_COUNT];	/**< Value storage for ROVT_FLOAT data. */
+		}						values;		/**< Inline copy of the payload data. */
+
+		/**
+		 * Method to copy the contents of given message data into this object.
+		 * The caller has to ensure that the payload fits the inline value storage.
+		 *
+		 * @param msgData	The message data to copy.
+		 */
+		void Set(const RemoteObjectMessageData& msgData)
+		{
+			valid = true;
+			valType = msgData.valType;
+			valCount = msgData.valCount;
+			if (msgData.payload != nullptr && msgData.payloadSize > 0)
+				memcpy(&values, msgData.payload, static_cast<size_t>(msgData.payloadSize));
+		}
+	};
+
+	void			ResizeValueStore(int channelCount);
+	StoredValue*	GetStoredValue(const RemoteObjectIdentifier Id, const RemoteObjectAddressing& roAddr);
+
+	HeapBlock<StoredValue>	m_currentValues;		/**< Dense store of current value data to use to compare to incoming data regarding value changes, indexed by object id, record and channel. */
+	int						m_valueStoreChannels;	/**< Count of channel slots per object id and record in the value store. */
+	float					m_precision;			/**< Value precision to use for processing. */
 };
 
 /**
@@ -49,7 +49,8 @@ ProcessingEngine::ProcessingEngine()
 {
 	m_IsRunning = false;
 	m_LoggingEnabled = false;
-	m_logTarget = 0;
+	m_logTarget = nullptr;
+	m_logCallsInFlight = 0;
 }
 
 /**
@@ -57,6 +58,7 @@ ProcessingEngine::ProcessingEngine()
  */
 ProcessingEngine::~ProcessingEngine()
 {
+	Stop();
 }
 
 /**
@@ -70,19 +72,57 @@ bool ProcessingEngine::Start()
 {
 	bool startSuccess = true;
 
+	// in engine thread mode, all node message traffic is processed by a dedicated worker
+	// thread that is fed by the network threads instead of the application message loop
+	EngineThreadingMode threadingMode = m_configuration.GetEngineThreadingMode();
+	if (threadingMode == ETM_EngineThread)
+		m_engineWorkers.push_back(std::make_unique<ProcessingEngineWorker>("RemoteProtocolBridge Engine"));
+
 	Array<unsigned int> NodeIds = m_configuration.GetNodeIds();
 	for (int i = 0; i < NodeIds.size(); ++i)
 	{
+		// in thread per node mode, every node gets a worker of its own, so a busy node does not delay the others.
+		// The messages of a node are still processed by a single thread, which keeps them in order.
+		if (threadingMode == ETM_ThreadPerNode)
+			m_engineWorkers.push_back(std::make_unique<ProcessingEngineWorker>("RemoteProtocolBridge Node " + String(NodeIds[i])));
+
 		ProcessingEngineNode* node = new ProcessingEngineNode(this);
 		node->SetNodeConfiguration(m_configuration, NodeIds[i]);
+		if (!m_engineWorkers.empty())
+		{
+			node->SetProcessingWorker(m_engineWorkers.back().get());
+			m_engineWorkers.back()->AddNode(node);
+		}
 		startSuccess = startSuccess && node->Start();
 
 		m_ProcessingNodes[NodeIds[i]] = std::unique_ptr<ProcessingEngineNode>(node);
 	}
 
+	// if configured, node workers are spread across the available cores, to not have the scheduler move them around.
+	// Otherwise their placement is left to the OS, that knows about the other load on the machine.
+	int numCpus = SystemStats::getNumCpus();
+	bool pinWorkers = m_configuration.IsWorkerCpuPinning();
+	for (size_t i = 0; i < m_engineWorkers.size(); ++i)
+	{
+		if (threadingMode == ETM_ThreadPerNode && pinWorkers && numCpus > 1)
+			m_engineWorkers[i]->setAffinityMask(uint32(1) << (i % static_cast<size_t>(jmin(numCpus, 32))));
+
+		// high priority within the regular 0-10 range, above the message thread but below realtime audio.
+		// Values outside of that range, except for the realtime audio priority itself, are clamped to the lowest priority.
+		m_engineWorkers[i]->startThread(8);
+	}
+
 	if (startSuccess)
 		m_IsRunning = true;
 
+	// metrics are published as long as the engine runs, a port that cannot be opened does not keep the engine from running
+	if (m_configuration.GetMetricsPort() > 0 || m_configuration.GetMetricsDumpInterval() > 0)
+	{
+		m_metricsPublisher = std::make_unique<EngineMetricsPublisher>(*this, m_configuration.GetMetricsPort(), m_configuration.GetMetricsDumpInterval(), m_configuration.GetMetricsFile());
+		if (!m_metricsPublisher->Start())
+			m_metricsPublisher.reset();
+	}
+
 	return startSuccess;
 }
 
@@ -92,7 +132,18 @@ bool ProcessingEngine::Start()
  */
 void ProcessingEngine::Stop()
 {
+	// the metrics publisher reads from the nodes, so it has to be finished first
+	m_metricsPublisher.reset();
+
+	// the workers have to be finished before the nodes they process are gone,
+	// but must still exist as long as the nodes' network threads might notify them
+	for (auto& worker : m_engineWorkers)
+		worker->signalThreadShouldExit();
+	for (auto& worker : m_engineWorkers)
+		worker->stopThread(2 * ET_WorkerIdleTimeout);
+
 	m_ProcessingNodes.clear();
+	m_engineWorkers.clear();
 
 	m_IsRunning = false;
 }
@@ -134,17 +185,77 @@ void ProcessingEngine::SetLoggingEnabled(bool enable)
  */
 bool ProcessingEngine::IsLoggingEnabled()
 {
-	return m_LoggingEnabled;
+	return m_LoggingEnabled.get();
+}
+
+/**
+ * Method to inject a message into a running node, as if it was received by one of the node's protocols.
+ * This allows an application embedding the engine to feed it values without a network hop.
+ * In engine thread mode, it can be called from any thread while the protocols are receiving, since injected messages
+ * are handed to the worker through a queue of their own. In message thread mode, it has to be called on the message thread.
+ * Must not be called concurrently with Start or Stop.
+ *
+ * @param NId		The id of the node to inject the message into
+ * @param PId		The id of the protocol the message shall appear to be received by
+ * @param Id		The remote object id of the message
+ * @param msgData	The message data
+ * @return	True if the message was injected, false if the engine is not running or the ids are not valid
+ */
+bool ProcessingEngine::InjectMessage(NodeId NId, ProtocolId PId, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData)
+{
+	if (!m_IsRunning || m_ProcessingNodes.count(NId) == 0)
+		return false;
+
+	return m_ProcessingNodes.at(NId)->InjectMessage(PId, Id, msgData);
+}
+
+/**
+ * Getter for the message counters and latencies of a node, to be read while the engine is running.
+ * Must not be called concurrently with Start or Stop.
+ *
+ * @param NId	The id of the node to get the metrics of
+ * @return	The metrics of the node, nullptr if the engine has no node with the given id
+ */
+const NodeMetrics* ProcessingEngine::GetNodeMetrics(NodeId NId) const
+{
+	if (m_ProcessingNodes.count(NId) == 0)
+		return nullptr;
+
+	return &m_ProcessingNodes.at(NId)->GetMetrics();
+}
+
+/**
+ * Method to create an xml snapshot of the metrics of all nodes, incl. their message counters, latencies,
+ * queue depths, state cache, rate limiter, polling and subscription statistics.
+ * Safe to be called from any thread, but not concurrently with Start or Stop.
+ *
+ * @return	The metrics snapshot
+ */
+std::unique_ptr<XmlElement> ProcessingEngine::CreateMetricsSnapshot() const
+{
+	std::unique_ptr<XmlElement> MetricsElement = std::make_unique<XmlElement>("RemoteProtocolBridgeMetrics");
+	MetricsElement->setAttribute("Time", Time::getCurrentTime().toISO8601(true));
+	MetricsElement->setAttribute("Running", m_IsRunning);
+
+	for (std::map<unsigned int, std::unique_ptr<ProcessingEngineNode>>::const_iterator niter = m_ProcessingNodes.begin(); niter != m_ProcessingNodes.end(); ++niter)
+		niter->second->WriteMetrics(MetricsElement->createNewChildElement("Node"));
+
+	return MetricsElement;
 }
 
 /**
-* Setter for logging target object to be used to push messages to
+* Setter for logging target object to be used to push messages to.
+* Waits for the logging calls to the previous target that are in progress on the engine worker threads,
+* so the previous target can be destroyed once this returns.
 *
 * @param logTarget	The target object for logging data
 */
 void ProcessingEngine::SetLoggingTarget(LoggingTarget_Interface* logTarget)
 {
 	m_logTarget = logTarget;
+
+	while (m_logCallsInFlight.get() > 0)
+		Thread::yield();
 }
 
 /**
@@ -158,11 +269,14 @@ void ProcessingEngine::SetLoggingTarget(LoggingTarget_Interface* logTarget)
  */
 void ProcessingEngine::HandleNodeData(NodeId nodeId, ProtocolId senderProtocolId, ProtocolType senderProtocolType, RemoteObjectIdentifier objectId, RemoteObjectMessageData& msgData)
 {
-	if (!IsLoggingEnabled())
+	if (!m_LoggingEnabled.get())
 		return;
 
-	if (m_logTarget)
-	{
-		m_logTarget->AddLogData(nodeId, senderProtocolId, senderProtocolType, objectId, msgData);
-	}
+	// the target is read without a lock, to not serialize the node workers while logging.
+	// The in flight count lets SetLoggingTarget wait for this call before the target may be destroyed.
+	++m_logCallsInFlight;
+	LoggingTarget_Interface* logTarget = m_logTarget.get();
+	if (logTarget)
+		logTarget->AddLogData(nodeId, senderProtocolId, senderProtocolType, objectId, msgData);
+	--m_logCallsInFlight;
 }
\ No newline at end of file
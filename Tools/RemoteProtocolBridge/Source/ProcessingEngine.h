@@ -36,6 +36,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ProcessingEngineConfig.h"
 #include "ProcessingEngineNode.h"
+#include "ProcessingEngineWorker.h"
+#include "EngineMetricsPublisher.h"
 #include "RemoteProtocolBridgeCommon.h"
 
 #include <JuceHeader.h>
@@ -63,6 +65,9 @@ public:
 	void SetLoggingTarget(LoggingTarget_Interface* logTarget);
 	bool Start();
 	void Stop();
+	bool InjectMessage(NodeId NId, ProtocolId PId, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData);
+	const NodeMetrics* GetNodeMetrics(NodeId NId) const;
+	std::unique_ptr<XmlElement> CreateMetricsSnapshot() const;
 
 	// ============================================================
 	void HandleNodeData(NodeId nodeId, ProtocolId senderProtocolId, ProtocolType senderProtocolType, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData) override;
@@ -72,8 +77,11 @@ private:
 	ProcessingEngineConfig											m_configuration;	/**< Internal configuration object to hold runtime config and to be passed around for anyone to extract desired config info from. */
 	std::map<unsigned int, std::unique_ptr<ProcessingEngineNode>>	m_ProcessingNodes;	/**< Hash table to hold all node objects currently active as define by config. */
 	bool															m_IsRunning;		/**< Running state flag. */
-	bool															m_LoggingEnabled;	/**< Logging state flag. */
-	LoggingTarget_Interface*										m_logTarget;		/**< Pointer to the object that shall receive logging data from the engine. */
+	Atomic<bool>													m_LoggingEnabled;	/**< Logging state flag. Atomic, since it is read by the engine worker threads. */
+	Atomic<LoggingTarget_Interface*>								m_logTarget;		/**< Pointer to the object that shall receive logging data from the engine. Atomic, to be read by the engine worker threads without a lock. */
+	Atomic<int>														m_logCallsInFlight;	/**< Count of logging calls currently made to the logging target, to let resetting the target wait for them to finish. */
+	std::vector<std::unique_ptr<ProcessingEngineWorker>>			m_engineWorkers;	/**< The worker threads that process node message traffic in engine thread (single worker) and thread per node mode. */
+	std::unique_ptr<EngineMetricsPublisher>							m_metricsPublisher;	/**< The thread that serves the engine metrics and writes them to file, if configured. */
 	Array<String>													m_loggingQueue;		/**< Array queue with messages to be logged. */
 
 };
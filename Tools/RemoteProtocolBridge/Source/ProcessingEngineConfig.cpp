@@ -45,9 +45,15 @@ ProcessingEngineConfig::ProcessingEngineConfig()
 {
 	m_TrafficLoggingAllowed = true;
 	m_EngineStartOnAppStart = false;
-
-	m_configFilePath = File::getSpecialLocation(File::SpecialLocationType::userApplicationDataDirectory).getFullPathName() + "/RemoteProtocolBridge/";
-	File(m_configFilePath).createDirectory();
+	m_EngineThreadingMode = ETM_MessageThread;
+	m_WorkerCpuPinning = false;
+	m_MetricsPort = 0;
+	m_MetricsDumpInterval = ET_DefaultMetricsDumpInterval;
+
+	File configDirectory = File::getSpecialLocation(File::SpecialLocationType::userApplicationDataDirectory).getChildFile("RemoteProtocolBridge");
+	configDirectory.createDirectory();
+	m_configFile = configDirectory.getChildFile(CONFIGURATION_FILE);
+	m_metricsFile = configDirectory.getChildFile(METRICS_FILE);
 }
 
 /**
@@ -82,6 +88,14 @@ ProcessingEngineConfig& ProcessingEngineConfig::operator=(const ProcessingEngine
 	for (HashMap<ProtocolId, ProtocolData>::Iterator ProtocolIter = r.m_protocolData.begin(); ProtocolIter != r.m_protocolData.end(); ++ProtocolIter)
 		m_protocolData.set(ProtocolIter.getKey(), ProtocolIter.getValue());
 
+	m_TrafficLoggingAllowed = r.m_TrafficLoggingAllowed;
+	m_EngineStartOnAppStart = r.m_EngineStartOnAppStart;
+	m_EngineThreadingMode = r.m_EngineThreadingMode;
+	m_WorkerCpuPinning = r.m_WorkerCpuPinning;
+	m_MetricsPort = r.m_MetricsPort;
+	m_MetricsDumpInterval = r.m_MetricsDumpInterval;
+	m_metricsFile = r.m_metricsFile;
+
 	return *this;
 }
 
@@ -116,6 +130,37 @@ bool ProcessingEngineConfig::SetObjectHandlingData(NodeId NId, const ProcessingE
 	return true;
 }
 
+/**
+ * Getter for the max. age of cached object values to answer role A polls with for a given node
+ *
+ * @param NId	The node id to get the max. age for
+ * @return		The max. age in ms, 0 if the state cache is disabled
+ */
+int ProcessingEngineConfig::GetStateCacheMaxAge(NodeId NId) const
+{
+	return GetNodeData(NId).StateCacheMaxAge;
+}
+
+/**
+ * Setter for the max. age of cached object values to answer role A polls with for a given node
+ *
+ * @param NId		The node id to set the max. age for
+ * @param maxAge	The max. age in ms, 0 to disable the state cache
+ * @return	True on success, false if the given NId is not valid
+ */
+bool ProcessingEngineConfig::SetStateCacheMaxAge(NodeId NId, int maxAge)
+{
+	if (!m_nodeIds.contains(NId))
+		return false;
+
+	NodeData nd = m_nodeData[NId];
+
+	nd.StateCacheMaxAge = jmax(0, maxAge);
+	m_nodeData.set(NId, nd);
+
+	return true;
+}
+
 /**
  * Getter for the list of node ids of current configuration
  *
@@ -140,6 +185,7 @@ ProcessingEngineConfig::NodeData ProcessingEngineConfig::GetNodeData(NodeId NId)
 	node.ObjectHandling.Mode = OHM_Invalid;
 	node.ObjectHandling.ACnt = 0;
 	node.ObjectHandling.BCnt = 0;
+	node.StateCacheMaxAge = ET_DefaultStateCacheMaxAge;
 
 	if (m_nodeData.contains(NId))
 		node = m_nodeData[NId];
@@ -252,6 +298,324 @@ bool ProcessingEngineConfig::SetPollingInterval(NodeId NId, ProtocolId PId, int
 	return false;
 }
 
+/**
+ * Getter for the max. adaptive polling interval in ms for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The max. interval in ms objects with unchanging values are polled at, 0 if adaptive polling is disabled
+ */
+int ProcessingEngineConfig::GetAdaptivePollingMaxInterval(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).AdaptivePollingMaxInterval;
+}
+
+/**
+ * Setter for the max. adaptive polling interval in ms for a given nodes protocol
+ *
+ * @param NId		The node id to use to get objectdata for
+ * @param PId		The protocol id to use to get objectdata for
+ * @param interval	The max. interval to set for the given protocol, 0 to disable adaptive polling
+ * @return			True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetAdaptivePollingMaxInterval(NodeId NId, ProtocolId PId, int interval)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.AdaptivePollingMaxInterval = jmax(0, interval);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the individual polling intervals per remote object id for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The polling intervals in ms per remote object id
+ */
+std::map<RemoteObjectIdentifier, int> ProcessingEngineConfig::GetPollingTiers(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).PollingTiers;
+}
+
+/**
+ * Setter for the individual polling intervals per remote object id for a given nodes protocol
+ *
+ * @param NId		The node id to use to get objectdata for
+ * @param PId		The protocol id to use to get objectdata for
+ * @param tiers		The polling intervals in ms per remote object id to set for the given protocol
+ * @return			True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetPollingTiers(NodeId NId, ProtocolId PId, const std::map<RemoteObjectIdentifier, int>& tiers)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.PollingTiers.clear();
+		for (auto const& tier : tiers)
+			if (tier.second > 0)
+				protocol.PollingTiers[tier.first] = tier.second;
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the outgoing message bundling window in ms for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The bundling window in ms, 0 if bundling is disabled
+ */
+int ProcessingEngineConfig::GetBundleWindow(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).BundleWindow;
+}
+
+/**
+ * Setter for the outgoing message bundling window in ms for a given nodes protocol
+ *
+ * @param NId		The node id to use to get objectdata for
+ * @param PId		The protocol id to use to get objectdata for
+ * @param window	The bundling window to set for the given protocol, 0 to disable bundling
+ * @return			True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetBundleWindow(NodeId NId, ProtocolId PId, int window)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.BundleWindow = jmax(0, window);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the max. outgoing bundle packet size in bytes for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The max. bundle packet size in bytes
+ */
+int ProcessingEngineConfig::GetBundleMTU(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).BundleMTU;
+}
+
+/**
+ * Setter for the max. outgoing bundle packet size in bytes for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @param mtu	The max. bundle packet size to set for the given protocol
+ * @return		True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetBundleMTU(NodeId NId, ProtocolId PId, int mtu)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.BundleMTU = jlimit(int(EBS_MinBundleMTU), int(EBS_MaxBundleMTU), mtu);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the outgoing message coalescing interval in ms for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The coalescing interval in ms, 0 if coalescing is disabled
+ */
+int ProcessingEngineConfig::GetCoalescingInterval(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).CoalescingInterval;
+}
+
+/**
+ * Setter for the outgoing message coalescing interval in ms for a given nodes protocol
+ *
+ * @param NId		The node id to use to get objectdata for
+ * @param PId		The protocol id to use to get objectdata for
+ * @param interval	The coalescing interval to set for the given protocol, 0 to disable coalescing
+ * @return			True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetCoalescingInterval(NodeId NId, ProtocolId PId, int interval)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.CoalescingInterval = jmax(0, interval);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the outgoing message rate limit for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The rate limit in messages per second, 0 if rate limiting is disabled
+ */
+int ProcessingEngineConfig::GetRateLimit(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).RateLimit;
+}
+
+/**
+ * Setter for the outgoing message rate limit for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @param rate	The rate limit in messages per second to set for the given protocol, 0 to disable rate limiting
+ * @return		True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetRateLimit(NodeId NId, ProtocolId PId, int rate)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.RateLimit = jmax(0, rate);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the outgoing message burst size for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The count of messages that may be sent in a burst when rate limiting is enabled
+ */
+int ProcessingEngineConfig::GetRateBurst(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).RateBurst;
+}
+
+/**
+ * Setter for the outgoing message burst size for a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @param burst	The count of messages that may be sent in a burst to set for the given protocol
+ * @return		True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetRateBurst(NodeId NId, ProtocolId PId, int burst)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.RateBurst = jmax(1, burst);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the remote objects whose changed values are pushed to the client of a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The subscribed remote objects, empty if the client is not subscribed
+ */
+Array<RemoteObject> ProcessingEngineConfig::GetSubscriptions(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).Subscriptions;
+}
+
+/**
+ * Setter for the remote objects whose changed values are pushed to the client of a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @param Objs	The remote objects to subscribe the client to, empty to push every value as before
+ * @return		True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetSubscriptions(NodeId NId, ProtocolId PId, const Array<RemoteObject>& Objs)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.Subscriptions = Objs;
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Getter for the max. rate subscribed objects' changed values are pushed to the client of a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @return		The max. rate in updates per second, 0 if every change is pushed
+ */
+int ProcessingEngineConfig::GetSubscriptionMaxRate(NodeId NId, ProtocolId PId) const
+{
+	return GetProtocolData(NId, PId).SubscriptionMaxRate;
+}
+
+/**
+ * Setter for the max. rate subscribed objects' changed values are pushed to the client of a given nodes protocol
+ *
+ * @param NId	The node id to use to get objectdata for
+ * @param PId	The protocol id to use to get objectdata for
+ * @param rate	The max. rate in updates per second to set for the given protocol, 0 to push every change
+ * @return		True on success, false if given NId/PId are not valid
+ */
+bool ProcessingEngineConfig::SetSubscriptionMaxRate(NodeId NId, ProtocolId PId, int rate)
+{
+	if (m_nodeData.contains(NId) && m_protocolData.contains(PId))
+	{
+		ProtocolData protocol = m_protocolData[PId];
+
+		protocol.SubscriptionMaxRate = jmax(0, rate);
+		m_protocolData.set(PId, protocol);
+
+		return true;
+	}
+
+	return false;
+}
+
 /**
  * Setter for the protocol ports for a given node/protocol
  *
@@ -316,6 +680,128 @@ void ProcessingEngineConfig::SetEngineStartOnAppStart(bool start)
 	m_EngineStartOnAppStart = start;
 }
 
+/**
+ * Getter for the threading mode the engine shall use to process protocol message traffic
+ *
+ * @return	The engine threading mode
+ */
+EngineThreadingMode ProcessingEngineConfig::GetEngineThreadingMode() const
+{
+	return m_EngineThreadingMode;
+}
+
+/**
+ * Setter for the threading mode the engine shall use to process protocol message traffic
+ *
+ * @param mode	The engine threading mode to use
+ */
+void ProcessingEngineConfig::SetEngineThreadingMode(EngineThreadingMode mode)
+{
+	m_EngineThreadingMode = mode;
+}
+
+/**
+ * Getter for the flag if the node workers shall be pinned to a cpu each in thread per node mode
+ *
+ * @return	True if the workers are pinned, false if their placement is left to the OS
+ */
+bool ProcessingEngineConfig::IsWorkerCpuPinning() const
+{
+	return m_WorkerCpuPinning;
+}
+
+/**
+ * Setter for the flag if the node workers shall be pinned to a cpu each in thread per node mode
+ *
+ * @param pin	True to pin the workers, false to leave their placement to the OS
+ */
+void ProcessingEngineConfig::SetWorkerCpuPinning(bool pin)
+{
+	m_WorkerCpuPinning = pin;
+}
+
+/**
+ * Getter for the loopback tcp port the engine metrics are served on
+ *
+ * @return	The metrics port, 0 if the metrics are not served
+ */
+int ProcessingEngineConfig::GetMetricsPort() const
+{
+	return m_MetricsPort;
+}
+
+/**
+ * Setter for the loopback tcp port the engine metrics are served on
+ *
+ * @param port	The metrics port to use, 0 to not serve the metrics
+ */
+void ProcessingEngineConfig::SetMetricsPort(int port)
+{
+	m_MetricsPort = jlimit(0, 65535, port);
+}
+
+/**
+ * Getter for the interval the engine metrics are written to the metrics file in
+ *
+ * @return	The dump interval in ms, 0 if the file dump is disabled
+ */
+int ProcessingEngineConfig::GetMetricsDumpInterval() const
+{
+	return m_MetricsDumpInterval;
+}
+
+/**
+ * Setter for the interval the engine metrics are written to the metrics file in
+ *
+ * @param interval	The dump interval in ms, 0 to disable the file dump
+ */
+void ProcessingEngineConfig::SetMetricsDumpInterval(int interval)
+{
+	m_MetricsDumpInterval = jmax(0, interval);
+}
+
+/**
+ * Getter for the file the engine metrics are periodically written to
+ *
+ * @return	The metrics file
+ */
+const File& ProcessingEngineConfig::GetMetricsFile() const
+{
+	return m_metricsFile;
+}
+
+/**
+ * Setter for the file the engine metrics are periodically written to.
+ * Defaults to the metrics file in the user application data directory.
+ *
+ * @param metricsFile	The metrics file to use
+ */
+void ProcessingEngineConfig::SetMetricsFile(const File& metricsFile)
+{
+	m_metricsFile = metricsFile;
+}
+
+/**
+ * Getter for the config file the configuration is read from and written to
+ *
+ * @return	The config file
+ */
+const File& ProcessingEngineConfig::GetConfigFile() const
+{
+	return m_configFile;
+}
+
+/**
+ * Setter for the config file the configuration is read from and written to.
+ * Defaults to the config file in the user application data directory.
+ *
+ * @param configFile	The config file to use
+ */
+void ProcessingEngineConfig::SetConfigFile(const File& configFile)
+{
+	m_configFile = configFile;
+}
+
 /**
  * Getter for the typeA protocol ids used in a given node
  *
@@ -383,7 +869,7 @@ bool ProcessingEngineConfig::SetProtocolData(NodeId NId, ProtocolId PId, const P
  */
 bool ProcessingEngineConfig::InitConfiguration()
 {
-	if (XmlDocument::parse(File(m_configFilePath + CONFIGURATION_FILE)))
+	if (XmlDocument::parse(m_configFile))
 	{
 		return ReadConfiguration();
 	}
@@ -403,7 +889,7 @@ bool ProcessingEngineConfig::InitConfiguration()
 */
 bool ProcessingEngineConfig::ReadConfiguration()
 {
-    if (std::unique_ptr<XmlElement> elm = std::unique_ptr<XmlElement>(XmlDocument::parse(File(m_configFilePath + CONFIGURATION_FILE))))
+    if (std::unique_ptr<XmlElement> elm = std::unique_ptr<XmlElement>(XmlDocument::parse(m_configFile)))
 	{
 		XmlElement* rootChild = elm->getFirstChildElement();
 		while (rootChild !=nullptr)
@@ -412,6 +898,7 @@ bool ProcessingEngineConfig::ReadConfiguration()
 			{
 				NodeData node;
 				node.Id = NodeId(ValidateUniqueId(rootChild->getAttributeValue(0).getIntValue()));
+				node.StateCacheMaxAge = ET_DefaultStateCacheMaxAge;
 
 				XmlElement* nodeChild = rootChild->getFirstChildElement();
 				while (nodeChild != nullptr)
@@ -432,12 +919,23 @@ bool ProcessingEngineConfig::ReadConfiguration()
 							nodeDataChild = nodeDataChild->getNextElement();
 						}
 					}
+					else if (nodeChild->getTagName() == "StateCache")
+					{
+						node.StateCacheMaxAge = jmax(0, nodeChild->getIntAttribute("MaxAge", ET_DefaultStateCacheMaxAge));
+					}
 					else if (nodeChild->getTagName() == "ProtocolA")
 					{
 						ProtocolData protocol;
 						protocol.Id = ProtocolId(ValidateUniqueId(nodeChild->getAttributeValue(0).getIntValue()));
 						protocol.Type = ProtocolTypeFromString(nodeChild->getAttributeValue(1));
 						protocol.PollingInterval = ET_DefaultPollingRate;
+						protocol.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+						protocol.BundleWindow = ET_DefaultBundleWindow;
+						protocol.BundleMTU = EBS_DefaultBundleMTU;
+						protocol.CoalescingInterval = ET_DefaultCoalescingInterval;
+						protocol.RateLimit = ET_DefaultRateLimit;
+						protocol.RateBurst = EBS_DefaultRateBurst;
+						protocol.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
 						protocol.UsesActiveRemoteObjects = nodeChild->getAttributeValue(2).getIntValue()>0;
 
 						XmlElement* nodeDataChild = nodeChild->getFirstChildElement();
@@ -451,8 +949,29 @@ bool ProcessingEngineConfig::ReadConfiguration()
 								protocol.HostPort = nodeDataChild->getAttributeValue(0).getIntValue();
 							else if (nodeDataChild->getTagName() == "PollingInterval")
 								protocol.PollingInterval = nodeDataChild->getAttributeValue(0).getIntValue();
+							else if (nodeDataChild->getTagName() == "AdaptivePolling")
+								protocol.AdaptivePollingMaxInterval = jmax(0, nodeDataChild->getIntAttribute("MaxInterval", ET_DefaultAdaptivePollingMaxInterval));
+							else if (nodeDataChild->getTagName() == "PollingTiers")
+								ReadPollingTiers(nodeDataChild->getFirstChildElement(), protocol.PollingTiers);
+							else if (nodeDataChild->getTagName() == "Bundling")
+							{
+								protocol.BundleWindow = jmax(0, nodeDataChild->getIntAttribute("Window", ET_DefaultBundleWindow));
+								protocol.BundleMTU = jlimit(int(EBS_MinBundleMTU), int(EBS_MaxBundleMTU), nodeDataChild->getIntAttribute("MTU", EBS_DefaultBundleMTU));
+							}
+							else if (nodeDataChild->getTagName() == "Coalescing")
+								protocol.CoalescingInterval = jmax(0, nodeDataChild->getIntAttribute("Interval", ET_DefaultCoalescingInterval));
+							else if (nodeDataChild->getTagName() == "RateLimit")
+							{
+								protocol.RateLimit = jmax(0, nodeDataChild->getIntAttribute("Rate", ET_DefaultRateLimit));
+								protocol.RateBurst = jmax(1, nodeDataChild->getIntAttribute("Burst", EBS_DefaultRateBurst));
+							}
 							else if (nodeDataChild->getTagName() == "ActiveObjects")
 								ReadActiveObjects(nodeDataChild->getFirstChildElement(), protocol.RemoteObjects);
+							else if (nodeDataChild->getTagName() == "Subscriptions")
+							{
+								protocol.SubscriptionMaxRate = jmax(0, nodeDataChild->getIntAttribute("MaxRate", ET_DefaultSubscriptionMaxRate));
+								ReadActiveObjects(nodeDataChild->getFirstChildElement(), protocol.Subscriptions);
+							}
 
 							nodeDataChild = nodeDataChild->getNextElement();
 						}
@@ -475,6 +994,13 @@ bool ProcessingEngineConfig::ReadConfiguration()
 						protocol.Id = ProtocolId(ValidateUniqueId(nodeChild->getAttributeValue(0).getIntValue()));
 						protocol.Type = ProtocolTypeFromString(nodeChild->getAttributeValue(1));
 						protocol.PollingInterval = ET_DefaultPollingRate;
+						protocol.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+						protocol.BundleWindow = ET_DefaultBundleWindow;
+						protocol.BundleMTU = EBS_DefaultBundleMTU;
+						protocol.CoalescingInterval = ET_DefaultCoalescingInterval;
+						protocol.RateLimit = ET_DefaultRateLimit;
+						protocol.RateBurst = EBS_DefaultRateBurst;
+						protocol.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
 						protocol.UsesActiveRemoteObjects = nodeChild->getAttributeValue(2).getIntValue()>0;
 
 						XmlElement* nodeDataChild = nodeChild->getFirstChildElement();
@@ -488,6 +1014,22 @@ bool ProcessingEngineConfig::ReadConfiguration()
 								protocol.HostPort = nodeDataChild->getAttributeValue(0).getIntValue();
 							else if (nodeDataChild->getTagName() == "PollingInterval")
 								protocol.PollingInterval = nodeDataChild->getAttributeValue(0).getIntValue();
+							else if (nodeDataChild->getTagName() == "AdaptivePolling")
+								protocol.AdaptivePollingMaxInterval = jmax(0, nodeDataChild->getIntAttribute("MaxInterval", ET_DefaultAdaptivePollingMaxInterval));
+							else if (nodeDataChild->getTagName() == "PollingTiers")
+								ReadPollingTiers(nodeDataChild->getFirstChildElement(), protocol.PollingTiers);
+							else if (nodeDataChild->getTagName() == "Bundling")
+							{
+								protocol.BundleWindow = jmax(0, nodeDataChild->getIntAttribute("Window", ET_DefaultBundleWindow));
+								protocol.BundleMTU = jlimit(int(EBS_MinBundleMTU), int(EBS_MaxBundleMTU), nodeDataChild->getIntAttribute("MTU", EBS_DefaultBundleMTU));
+							}
+							else if (nodeDataChild->getTagName() == "Coalescing")
+								protocol.CoalescingInterval = jmax(0, nodeDataChild->getIntAttribute("Interval", ET_DefaultCoalescingInterval));
+							else if (nodeDataChild->getTagName() == "RateLimit")
+							{
+								protocol.RateLimit = jmax(0, nodeDataChild->getIntAttribute("Rate", ET_DefaultRateLimit));
+								protocol.RateBurst = jmax(1, nodeDataChild->getIntAttribute("Burst", EBS_DefaultRateBurst));
+							}
 							else if (nodeDataChild->getTagName() == "ActiveObjects")
 								ReadActiveObjects(nodeDataChild->getFirstChildElement(), protocol.RemoteObjects);
 
@@ -525,6 +1067,20 @@ bool ProcessingEngineConfig::ReadConfiguration()
 					{
 						m_EngineStartOnAppStart = globalConfigChild->getAttributeValue(0).getIntValue() > 0;
 					}
+					else if (globalConfigChild->getTagName() == "EngineThreading")
+					{
+						m_EngineThreadingMode = EngineThreadingModeFromString(globalConfigChild->getAttributeValue(0));
+						if (m_EngineThreadingMode == ETM_Invalid)
+							m_EngineThreadingMode = ETM_MessageThread;
+						m_WorkerCpuPinning = globalConfigChild->getBoolAttribute("PinWorkers", false);
+					}
+					else if (globalConfigChild->getTagName() == "Metrics")
+					{
+						SetMetricsPort(globalConfigChild->getIntAttribute("Port", 0));
+						SetMetricsDumpInterval(globalConfigChild->getIntAttribute("DumpInterval", ET_DefaultMetricsDumpInterval));
+						if (globalConfigChild->getStringAttribute("DumpFile").isNotEmpty())
+							m_metricsFile = m_configFile.getParentDirectory().getChildFile(globalConfigChild->getStringAttribute("DumpFile"));
+					}
 
 					globalConfigChild = globalConfigChild->getNextElement();
 				}
@@ -638,6 +1194,35 @@ bool ProcessingEngineConfig::ReadPollingInterval(XmlElement* PollingIntervalElem
 		return false;
 }
 
+/**
+ * Method to read the node configuration part regarding individual polling intervals per remote object id.
+ * Every child element is named after a remote object and holds its polling interval, e.g. <SoundObjectPositionXY Interval="20"/>.
+ *
+ * @param PollingTiersElement	The first xml element of the nodes' protocols' polling tiers in the DOM
+ * @param PollingTiers			The polling intervals per remote object id to fill according config contents
+ * @return	True if polling intervals were inserted, false if empty map is returned
+ */
+bool ProcessingEngineConfig::ReadPollingTiers(XmlElement* PollingTiersElement, std::map<RemoteObjectIdentifier, int>& PollingTiers)
+{
+	PollingTiers.clear();
+
+	XmlElement* objectChild = PollingTiersElement;
+	while (objectChild != nullptr)
+	{
+		int interval = objectChild->getIntAttribute("Interval", 0);
+		for (int i = ROI_Invalid + 1; i < ROI_UserMAX; ++i)
+		{
+			RemoteObjectIdentifier ROId = (RemoteObjectIdentifier)i;
+			if (objectChild->getTagName() == GetObjectDescription(ROId).removeCharacters(" ") && interval > 0)
+				PollingTiers[ROId] = interval;
+		}
+
+		objectChild = objectChild->getNextElement();
+	}
+
+	return !PollingTiers.empty();
+}
+
 /**
  * Writes the configuration data from object into xml file
  *
@@ -668,6 +1253,9 @@ bool ProcessingEngineConfig::WriteConfiguration()
 					}
 				}
 
+				if (XmlElement* StateCacheElement = NodeElement->createNewChildElement("StateCache"))
+					StateCacheElement->setAttribute("MaxAge", m_nodeData[m_nodeIds[i]].StateCacheMaxAge);
+
 				for (int j = 0; j < m_nodeData[m_nodeIds[i]].RoleAProtocols.size(); ++j)
 				{
 					if (XmlElement* ProtocolAElement = NodeElement->createNewChildElement("ProtocolA"))
@@ -686,8 +1274,29 @@ bool ProcessingEngineConfig::WriteConfiguration()
 							HostPortElement->setAttribute("Port", m_protocolData[PAId].HostPort);
 						if (XmlElement* PollingIntervalElement = ProtocolAElement->createNewChildElement("PollingInterval"))
 							PollingIntervalElement->setAttribute("Interval", m_protocolData[PAId].PollingInterval);
+						if (XmlElement* AdaptivePollingElement = ProtocolAElement->createNewChildElement("AdaptivePolling"))
+							AdaptivePollingElement->setAttribute("MaxInterval", m_protocolData[PAId].AdaptivePollingMaxInterval);
+						if (XmlElement* PollingTiersElement = ProtocolAElement->createNewChildElement("PollingTiers"))
+							WritePollingTiers(PollingTiersElement, m_protocolData[PAId].PollingTiers);
+						if (XmlElement* BundlingElement = ProtocolAElement->createNewChildElement("Bundling"))
+						{
+							BundlingElement->setAttribute("Window", m_protocolData[PAId].BundleWindow);
+							BundlingElement->setAttribute("MTU", m_protocolData[PAId].BundleMTU);
+						}
+						if (XmlElement* CoalescingElement = ProtocolAElement->createNewChildElement("Coalescing"))
+							CoalescingElement->setAttribute("Interval", m_protocolData[PAId].CoalescingInterval);
+						if (XmlElement* RateLimitElement = ProtocolAElement->createNewChildElement("RateLimit"))
+						{
+							RateLimitElement->setAttribute("Rate", m_protocolData[PAId].RateLimit);
+							RateLimitElement->setAttribute("Burst", m_protocolData[PAId].RateBurst);
+						}
 						if (XmlElement* ActiveObjectsElement = ProtocolAElement->createNewChildElement("ActiveObjects"))
 							WriteActiveObjects(ActiveObjectsElement, m_protocolData[PAId].RemoteObjects);
+						if (XmlElement* SubscriptionsElement = ProtocolAElement->createNewChildElement("Subscriptions"))
+						{
+							SubscriptionsElement->setAttribute("MaxRate", m_protocolData[PAId].SubscriptionMaxRate);
+							WriteActiveObjects(SubscriptionsElement, m_protocolData[PAId].Subscriptions);
+						}
 					}
 				}
 
@@ -709,6 +1318,22 @@ bool ProcessingEngineConfig::WriteConfiguration()
 							HostPortElement->setAttribute("Port", m_protocolData[PBId].HostPort);
 						if (XmlElement* PollingIntervalElement = ProtocolBElement->createNewChildElement("PollingInterval"))
 							PollingIntervalElement->setAttribute("Interval", m_protocolData[PBId].PollingInterval);
+						if (XmlElement* AdaptivePollingElement = ProtocolBElement->createNewChildElement("AdaptivePolling"))
+							AdaptivePollingElement->setAttribute("MaxInterval", m_protocolData[PBId].AdaptivePollingMaxInterval);
+						if (XmlElement* PollingTiersElement = ProtocolBElement->createNewChildElement("PollingTiers"))
+							WritePollingTiers(PollingTiersElement, m_protocolData[PBId].PollingTiers);
+						if (XmlElement* BundlingElement = ProtocolBElement->createNewChildElement("Bundling"))
+						{
+							BundlingElement->setAttribute("Window", m_protocolData[PBId].BundleWindow);
+							BundlingElement->setAttribute("MTU", m_protocolData[PBId].BundleMTU);
+						}
+						if (XmlElement* CoalescingElement = ProtocolBElement->createNewChildElement("Coalescing"))
+							CoalescingElement->setAttribute("Interval", m_protocolData[PBId].CoalescingInterval);
+						if (XmlElement* RateLimitElement = ProtocolBElement->createNewChildElement("RateLimit"))
+						{
+							RateLimitElement->setAttribute("Rate", m_protocolData[PBId].RateLimit);
+							RateLimitElement->setAttribute("Burst", m_protocolData[PBId].RateBurst);
+						}
 						if (XmlElement* ActiveObjectsElement = ProtocolBElement->createNewChildElement("ActiveObjects"))
 							WriteActiveObjects(ActiveObjectsElement, m_protocolData[PBId].RemoteObjects);
 					}
@@ -727,13 +1352,45 @@ bool ProcessingEngineConfig::WriteConfiguration()
 		{
 			EngineElement->setAttribute("AutoStart", m_EngineStartOnAppStart);
 		}
+		if (XmlElement* EngineThreadingElement = GlobalConfigElement->createNewChildElement("EngineThreading"))
+		{
+			EngineThreadingElement->setAttribute("Mode", EngineThreadingModeToString(m_EngineThreadingMode));
+			EngineThreadingElement->setAttribute("PinWorkers", m_WorkerCpuPinning);
+		}
+		if (XmlElement* MetricsElement = GlobalConfigElement->createNewChildElement("Metrics"))
+		{
+			MetricsElement->setAttribute("Port", m_MetricsPort);
+			MetricsElement->setAttribute("DumpInterval", m_MetricsDumpInterval);
+			MetricsElement->setAttribute("DumpFile", m_metricsFile.getFullPathName());
+		}
 	}
 
-	bool success = XmlConfig->writeTo(File(m_configFilePath + CONFIGURATION_FILE));
+	bool success = XmlConfig->writeTo(m_configFile);
 
 	return success;
 }
 
+/**
+ * Method to write the node configuration part regarding individual polling intervals per remote object id
+ *
+ * @param PollingTiersElement	The xml element for the nodes' protocols' polling tiers in the DOM
+ * @param PollingTiers			The polling intervals per remote object id to set in config
+ * @return	True on success, false on failure
+ */
+bool ProcessingEngineConfig::WritePollingTiers(XmlElement* PollingTiersElement, std::map<RemoteObjectIdentifier, int> const& PollingTiers)
+{
+	if (!PollingTiersElement)
+		return false;
+
+	for (auto const& tier : PollingTiers)
+	{
+		if (XmlElement* ObjectElement = PollingTiersElement->createNewChildElement(GetObjectDescription(tier.first).removeCharacters(" ")))
+			ObjectElement->setAttribute("Interval", tier.second);
+	}
+
+	return true;
+}
+
 /**
  * Method to write the node configuration part regarding active objects per protocol
  *
@@ -879,6 +1536,7 @@ void ProcessingEngineConfig::AddDefaultNode()
 	node.ObjectHandling.ACnt = 0;
 	node.ObjectHandling.BCnt = 0;
 	node.ObjectHandling.Prec = 0.001;
+	node.StateCacheMaxAge = ET_DefaultStateCacheMaxAge;
 
 	ProtocolData ProtocolA;
 	ProtocolA.Id = GetNextUniqueId();
@@ -888,6 +1546,13 @@ void ProcessingEngineConfig::AddDefaultNode()
 	ProtocolA.IpAddress = "10.255.0.100";
 	ProtocolA.UsesActiveRemoteObjects = false;
 	ProtocolA.PollingInterval = ET_DefaultPollingRate;
+	ProtocolA.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+	ProtocolA.BundleWindow = ET_DefaultBundleWindow;
+	ProtocolA.BundleMTU = EBS_DefaultBundleMTU;
+	ProtocolA.CoalescingInterval = ET_DefaultCoalescingInterval;
+	ProtocolA.RateLimit = ET_DefaultRateLimit;
+	ProtocolA.RateBurst = EBS_DefaultRateBurst;
+	ProtocolA.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
 	ProtocolA.RemoteObjects = remoteObjects;
 
 	m_protocolData.set(ProtocolA.Id, ProtocolA);
@@ -901,6 +1566,13 @@ void ProcessingEngineConfig::AddDefaultNode()
 	ProtocolB.IpAddress = "127.0.0.1";
 	ProtocolB.UsesActiveRemoteObjects = false;
 	ProtocolB.PollingInterval = ET_DefaultPollingRate;
+	ProtocolB.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+	ProtocolB.BundleWindow = ET_DefaultBundleWindow;
+	ProtocolB.BundleMTU = EBS_DefaultBundleMTU;
+	ProtocolB.CoalescingInterval = ET_DefaultCoalescingInterval;
+	ProtocolB.RateLimit = ET_DefaultRateLimit;
+	ProtocolB.RateBurst = EBS_DefaultRateBurst;
+	ProtocolB.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
 	ProtocolB.RemoteObjects = remoteObjects;
 
 	m_protocolData.set(ProtocolB.Id, ProtocolB);
@@ -947,6 +1619,13 @@ void ProcessingEngineConfig::AddDefaultProtocolB(NodeId NId)
 	ProtocolB.IpAddress = "127.0.0.1";
 	ProtocolB.UsesActiveRemoteObjects = false;
 	ProtocolB.PollingInterval = ET_DefaultPollingRate;
+	ProtocolB.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+	ProtocolB.BundleWindow = ET_DefaultBundleWindow;
+	ProtocolB.BundleMTU = EBS_DefaultBundleMTU;
+	ProtocolB.CoalescingInterval = ET_DefaultCoalescingInterval;
+	ProtocolB.RateLimit = ET_DefaultRateLimit;
+	ProtocolB.RateBurst = EBS_DefaultRateBurst;
+	ProtocolB.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
 	ProtocolB.RemoteObjects = remoteObjects;
 	
 	m_protocolData.set(ProtocolB.Id, ProtocolB);
@@ -992,6 +1671,13 @@ void ProcessingEngineConfig::AddDefaultProtocolA(NodeId NId)
 	ProtocolA.IpAddress = "10.255.0.100";
 	ProtocolA.UsesActiveRemoteObjects = false;
 	ProtocolA.PollingInterval = ET_DefaultPollingRate;
+	ProtocolA.AdaptivePollingMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+	ProtocolA.BundleWindow = ET_DefaultBundleWindow;
+	ProtocolA.BundleMTU = EBS_DefaultBundleMTU;
+	ProtocolA.CoalescingInterval = ET_DefaultCoalescingInterval;
+	ProtocolA.RateLimit = ET_DefaultRateLimit;
+	ProtocolA.RateBurst = EBS_DefaultRateBurst;
+	ProtocolA.SubscriptionMaxRate = ET_DefaultSubscriptionMaxRate;
 	ProtocolA.RemoteObjects = remoteObjects;
 	
 	m_protocolData.set(ProtocolA.Id, ProtocolA);
@@ -1101,6 +1787,59 @@ bool ProcessingEngineConfig::IsKeepaliveObject(RemoteObjectIdentifier objectId)
 	}
 }
 
+/**
+ * Helper method to check if the values of given message data differ from the given reference values.
+ * Float values are compared after being rounded to the given precision, int values are compared exactly.
+ *
+ * @param valType	The datatype of the reference values.
+ * @param valCount	The count of the reference values.
+ * @param values	The reference values.
+ * @param msgData	The message data to compare with the reference values.
+ * @param precision	The precision float values are compared with. Compared exactly if 0.
+ * @return True if the message data differs from the reference values, false if not.
+ */
+bool ProcessingEngineConfig::IsChangedValue(RemoteObjectValueType valType, uint16 valCount, const void* values, const RemoteObjectMessageData& msgData, float precision)
+{
+	if ((valType != msgData.valType) || (valCount != msgData.valCount))
+		return true;
+
+	for (int i = 0; i < valCount; ++i)
+	{
+		switch (valType)
+		{
+		case ROVT_INT:
+			if (static_cast<const int*>(values)[i] != static_cast<const int*>(msgData.payload)[i])
+				return true;
+			break;
+		case ROVT_FLOAT:
+			{
+				float referenceValue = static_cast<const float*>(values)[i];
+				float newValue = static_cast<const float*>(msgData.payload)[i];
+				if (precision == 0)
+				{
+					if (referenceValue != newValue)
+						return true;
+				}
+				else
+				{
+					// apply precision to get comparable values
+					int referencePrecisionValue = static_cast<int>(std::roundf(referenceValue / precision));
+					int newPrecisionValue = static_cast<int>(std::roundf(newValue / precision));
+					if (referencePrecisionValue != newPrecisionValue)
+						return true;
+				}
+			}
+			break;
+		case ROVT_STRING:
+		case ROVT_NONE:
+		default:
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /**
 * Convenience function to resolve enum to sth. human readable (e.g. in config file)
 */
@@ -1188,3 +1927,36 @@ ObjectHandlingMode ProcessingEngineConfig::ObjectHandlingModeFromString(String m
 
 	return OHM_Invalid;
 }
+
+/**
+* Convenience function to resolve enum to sth. human readable (e.g. in config file)
+*/
+String ProcessingEngineConfig::EngineThreadingModeToString(EngineThreadingMode etm)
+{
+	switch (etm)
+	{
+	case ETM_MessageThread:
+		return "Application message thread";
+	case ETM_EngineThread:
+		return "Dedicated engine thread";
+	case ETM_ThreadPerNode:
+		return "Dedicated thread per node";
+	default:
+		return "";
+	}
+}
+
+/**
+* Convenience function to resolve string to enum
+*/
+EngineThreadingMode ProcessingEngineConfig::EngineThreadingModeFromString(String mode)
+{
+	if (mode == EngineThreadingModeToString(ETM_MessageThread))
+		return ETM_MessageThread;
+	if (mode == EngineThreadingModeToString(ETM_EngineThread))
+		return ETM_EngineThread;
+	if (mode == EngineThreadingModeToString(ETM_ThreadPerNode))
+		return ETM_ThreadPerNode;
+
+	return ETM_Invalid;
+}
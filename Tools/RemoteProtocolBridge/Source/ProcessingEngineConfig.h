@@ -38,6 +38,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <JuceHeader.h>
 
+#include <map>
+
 /**
  * Class ProcessingEngineConfig is class for managing application runtime configuration.
  * It is used to be passed to different object wihtin application, that can then access it to
@@ -60,6 +62,15 @@ public:
 		bool				UsesActiveRemoteObjects;    /**< Flag specifying if this protocol is supposed to activly handle specified remote objects. */
 		Array<RemoteObject>	RemoteObjects;				/**< The remote objects actively used by a protocol instance. */
 		int					PollingInterval;			/**< The polling interval in ms. */
+		int					AdaptivePollingMaxInterval;	/**< The max. polling interval in ms objects with unchanging values back off to. 0 if adaptive polling is disabled. */
+		std::map<RemoteObjectIdentifier, int>	PollingTiers;	/**< Individual polling intervals in ms per remote object id, overriding the polling interval for these objects. */
+		int					BundleWindow;				/**< The time window in ms outgoing messages are accumulated in bundles. 0 if bundling is disabled. */
+		int					BundleMTU;					/**< The max. size in bytes of outgoing bundle packets. */
+		int					CoalescingInterval;			/**< The interval in ms outgoing messages are coalesced to their latest value per object before being sent. 0 if coalescing is disabled. */
+		int					RateLimit;					/**< The max. rate of outgoing messages in messages per second. 0 if rate limiting is disabled. */
+		int					RateBurst;					/**< The max. count of outgoing messages that may be sent in a burst when rate limiting is enabled. */
+		Array<RemoteObject>	Subscriptions;				/**< The remote objects whose changed values are pushed to the client of a role A protocol. Empty if the client is not subscribed. */
+		int					SubscriptionMaxRate;		/**< The max. rate in updates per second a subscribed objects' changed values are pushed in. 0 to push every change. */
 	};
 
 	/**
@@ -82,6 +93,7 @@ public:
 		ObjectHandlingData	ObjectHandling;				/**< The mode the node should operate in to handl msg data (defines what internal handling object is created). */
 		Array<ProtocolId>	RoleAProtocols;				/**< The role A protocol ids per node. */
 		Array<ProtocolId>	RoleBProtocols;				/**< The role B protocol ids per node. */
+		int					StateCacheMaxAge;			/**< The max. age in ms of a cached object value to answer role A polls with. 0 if the state cache is disabled. */
 	};
 
 public:
@@ -95,8 +107,28 @@ public:
 	Array<NodeId>		GetNodeIds() const;
 	ObjectHandlingData	GetObjectHandlingData(NodeId NId) const;
 	bool				SetObjectHandlingData(NodeId NId, const ObjectHandlingData& ohData);
+	int					GetStateCacheMaxAge(NodeId NId) const;
+	bool				SetStateCacheMaxAge(NodeId NId, int maxAge);
 	int					GetPollingInterval(NodeId NId, ProtocolId PId) const;
 	bool				SetPollingInterval(NodeId NId, ProtocolId PId, int interval);
+	int					GetAdaptivePollingMaxInterval(NodeId NId, ProtocolId PId) const;
+	bool				SetAdaptivePollingMaxInterval(NodeId NId, ProtocolId PId, int interval);
+	std::map<RemoteObjectIdentifier, int>	GetPollingTiers(NodeId NId, ProtocolId PId) const;
+	bool				SetPollingTiers(NodeId NId, ProtocolId PId, const std::map<RemoteObjectIdentifier, int>& tiers);
+	int					GetBundleWindow(NodeId NId, ProtocolId PId) const;
+	bool				SetBundleWindow(NodeId NId, ProtocolId PId, int window);
+	int					GetBundleMTU(NodeId NId, ProtocolId PId) const;
+	bool				SetBundleMTU(NodeId NId, ProtocolId PId, int mtu);
+	int					GetCoalescingInterval(NodeId NId, ProtocolId PId) const;
+	bool				SetCoalescingInterval(NodeId NId, ProtocolId PId, int interval);
+	int					GetRateLimit(NodeId NId, ProtocolId PId) const;
+	bool				SetRateLimit(NodeId NId, ProtocolId PId, int rate);
+	int					GetRateBurst(NodeId NId, ProtocolId PId) const;
+	bool				SetRateBurst(NodeId NId, ProtocolId PId, int burst);
+	Array<RemoteObject>	GetSubscriptions(NodeId NId, ProtocolId PId) const;
+	bool				SetSubscriptions(NodeId NId, ProtocolId PId, const Array<RemoteObject>& Objs);
+	int					GetSubscriptionMaxRate(NodeId NId, ProtocolId PId) const;
+	bool				SetSubscriptionMaxRate(NodeId NId, ProtocolId PId, int rate);
 	ProtocolData		GetProtocolData(NodeId NId, ProtocolId PId) const;
 	bool				SetProtocolData(NodeId NId, ProtocolId PId, const ProtocolData& data);
 	Array<ProtocolId>	GetProtocolAIds(NodeId NId) const;
@@ -111,13 +143,27 @@ public:
 	void				SetTrafficLoggingAllowed(bool allowed = true);
 	bool				IsEngineStartOnAppStart() const;
 	void				SetEngineStartOnAppStart(bool start = true);
+	EngineThreadingMode	GetEngineThreadingMode() const;
+	void				SetEngineThreadingMode(EngineThreadingMode mode);
+	bool				IsWorkerCpuPinning() const;
+	void				SetWorkerCpuPinning(bool pin = true);
+	int					GetMetricsPort() const;
+	void				SetMetricsPort(int port);
+	int					GetMetricsDumpInterval() const;
+	void				SetMetricsDumpInterval(int interval);
+	const File&			GetMetricsFile() const;
+	void				SetMetricsFile(const File& metricsFile);
+	const File&			GetConfigFile() const;
+	void				SetConfigFile(const File& configFile);
     
     bool				InitConfiguration();
 	bool				ReadConfiguration();
 	bool				ReadActiveObjects(XmlElement* ActiveObjectsElement, Array<RemoteObject>& RemoteObjects);
 	bool				ReadPollingInterval(XmlElement* ActiveObjectsElement, int& PollingInterval);
+	bool				ReadPollingTiers(XmlElement* PollingTiersElement, std::map<RemoteObjectIdentifier, int>& PollingTiers);
 	bool				WriteConfiguration();
 	bool				WriteActiveObjects(XmlElement* ActiveObjectsElement, Array<RemoteObject> const& RemoteObjects);
+	bool				WritePollingTiers(XmlElement* PollingTiersElement, std::map<RemoteObjectIdentifier, int> const& PollingTiers);
 
 	void				SetNode(NodeId NId, NodeData& node);
 	void				AddDefaultNode();
@@ -133,9 +179,12 @@ public:
 	static ProtocolType			ProtocolTypeFromString(String type);
 	static String				ObjectHandlingModeToString(ObjectHandlingMode ohm);
 	static ObjectHandlingMode	ObjectHandlingModeFromString(String mode);
+	static String				EngineThreadingModeToString(EngineThreadingMode etm);
+	static EngineThreadingMode	EngineThreadingModeFromString(String mode);
 
 	static String GetObjectDescription(RemoteObjectIdentifier Id);
 	static bool IsKeepaliveObject(RemoteObjectIdentifier Id);
+	static bool IsChangedValue(RemoteObjectValueType valType, uint16 valCount, const void* values, const RemoteObjectMessageData& msgData, float precision);
 
 
 private:
@@ -148,7 +197,12 @@ private:
 	
 	bool								m_TrafficLoggingAllowed;/**< Flag defining if the TrafficLogging togglebutton should be available. */
 	bool								m_EngineStartOnAppStart;/**< Flag defining if the engine should be automatically started on app start. */
+	EngineThreadingMode					m_EngineThreadingMode;	/**< The threading mode the engine shall use to process protocol message traffic. */
+	bool								m_WorkerCpuPinning;		/**< Flag defining if the node workers are pinned to a cpu each in thread per node mode, instead of leaving their placement to the OS. */
+	int									m_MetricsPort;			/**< The loopback tcp port the engine metrics are served on. 0 if the metrics are not served. */
+	int									m_MetricsDumpInterval;	/**< The interval in ms the engine metrics are written to the metrics file. 0 if the file dump is disabled. */
+	File								m_metricsFile;			/**< The file the engine metrics are periodically written to. */
 
-	String								m_configFilePath;		/**< The path string where the config file should be read from / written to. */
+	File								m_configFile;			/**< The config file that should be read from / written to. */
 
 };
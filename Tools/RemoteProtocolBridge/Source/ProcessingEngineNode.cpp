@@ -37,6 +37,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjectDataHandling.h"
 #include "ProcessingEngine.h"
 #include "ProcessingEngineConfig.h"
+#include "ProcessingEngineWorker.h"
 
 #include "ProtocolProcessor/OCAProtocolProcessor/OCAProtocolProcessor.h"
 #include "ProtocolProcessor/OSCProtocolProcessor/OSCProtocolProcessor.h"
@@ -49,8 +50,14 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Constructor
  */
 ProcessingEngineNode::ProcessingEngineNode()
+	: m_sendStageTimer(*this)
 {
 	m_dataHandling	= 0;
+	m_threadingMode	= ETM_MessageThread;
+	m_worker		= 0;
+	m_receiveTime	= 0;
+	m_forwardCount	= 0;
+	m_sendStageTickInterval	= 0;
 }
 
 /**
@@ -114,6 +121,22 @@ bool ProcessingEngineNode::Start()
 	{
 		Stop();
 	}
+	else
+	{
+		// all send stages are driven by a single timer, ticking at the shortest stage interval
+		m_sendStageTickInterval = 0;
+		for (std::map<ProtocolId, std::unique_ptr<CoalescingSendStage>>::iterator siter = m_sendStages.begin(); siter != m_sendStages.end(); ++siter)
+		{
+			siter->second->Start();
+
+			int interval = siter->second->GetInterval();
+			if (interval > 0 && (m_sendStageTickInterval == 0 || interval < m_sendStageTickInterval))
+				m_sendStageTickInterval = interval;
+		}
+
+		if (m_sendStageTickInterval > 0)
+			m_sendStageTimer.startTimer(m_sendStageTickInterval);
+	}
 
 	return (successfullyStartedA && successfullyStartedB);
 }
@@ -128,10 +151,17 @@ bool ProcessingEngineNode::Stop()
 	bool successfullyStoppedA = true;
 	bool successfullyStoppedB = true;
 
+	// send the last pending values before the protocols are stopped
+	m_sendStageTimer.stopTimer();
+	for (std::map<ProtocolId, std::unique_ptr<CoalescingSendStage>>::iterator siter = m_sendStages.begin(); siter != m_sendStages.end(); ++siter)
+		siter->second->Stop();
+
+	m_stateCache.Clear();
+
 	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator paiter = m_typeAProtocols.begin(); paiter != m_typeAProtocols.end(); ++paiter)
 		successfullyStoppedA = successfullyStoppedA && paiter->second->Stop();
 
-	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator pbiter = m_typeAProtocols.begin(); pbiter != m_typeAProtocols.end(); ++pbiter)
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator pbiter = m_typeBProtocols.begin(); pbiter != m_typeBProtocols.end(); ++pbiter)
 		successfullyStoppedB = successfullyStoppedB && pbiter->second->Stop();
 
 	return (successfullyStoppedA && successfullyStoppedB);
@@ -147,24 +177,41 @@ bool ProcessingEngineNode::Stop()
 void ProcessingEngineNode::SetNodeConfiguration(const ProcessingEngineConfig& config, NodeId NId)
 {
 	m_nodeId = NId;
+	m_threadingMode = config.GetEngineThreadingMode();
+	m_stateCache.SetMaxAge(config.GetStateCacheMaxAge(m_nodeId));
 
 	m_dataHandling = std::unique_ptr<ObjectDataHandling_Abstract>(CreateObjectDataHandling(config.GetObjectHandlingData(m_nodeId).Mode));
 	if (m_dataHandling)
 		m_dataHandling->SetObjectHandlingConfiguration(config, m_nodeId);
 
+	if (m_threadingMode != ETM_MessageThread)
+		m_injectQueue = std::make_unique<RemoteObjectMessageQueue>();
+	else
+		m_injectQueue.reset();
+
 	Array<ProtocolId> PAIds = config.GetProtocolAIds(m_nodeId);
 	for (ProtocolId* PAId = PAIds.begin(); PAId != PAIds.end(); ++PAId)
 	{
 		// create the protocol processing objects of correct type as defined in config
 		ProcessingEngineConfig::ProtocolData pdA = config.GetProtocolData(NId, *PAId);
 		ProtocolProcessor_Abstract* protocolA = CreateProtocolProcessor(pdA.Type, pdA.HostPort);
+		if (m_threadingMode != ETM_MessageThread)
+			m_messageQueues[*PAId] = std::make_unique<RemoteObjectMessageQueue>();
 
 		// set up the protocol processing objects of correct type as defined in config
 		if (protocolA)
 		{
 			protocolA->AddListener(this);
+			protocolA->SetDataPrecision(static_cast<float>(config.GetObjectHandlingData(m_nodeId).Prec));
 			protocolA->SetProtocolConfigurationData(pdA, config.GetRemoteObjectsToActivate(NId, *PAId), m_nodeId, *PAId);
 			m_typeAProtocols[*PAId] = std::unique_ptr<ProtocolProcessor_Abstract>(protocolA);
+			m_metrics.AddProtocol(*PAId);
+
+			// set up the coalescing output stage for the protocol, if configured
+			if (pdA.CoalescingInterval > 0)
+				m_sendStages[*PAId] = std::make_unique<CoalescingSendStage>(*this, *PAId, pdA.CoalescingInterval);
+			else
+				m_sendStages.erase(*PAId);
 
 			// add the protocolnodetype A to datahandlings' list of ProtocolIds for A protocols
 			if (m_dataHandling)
@@ -178,13 +225,23 @@ void ProcessingEngineNode::SetNodeConfiguration(const ProcessingEngineConfig& co
 		// create the protocol processing objects of correct type as defined in config
 		ProcessingEngineConfig::ProtocolData pdB = config.GetProtocolData(NId, *PBId);
 		ProtocolProcessor_Abstract* protocolB = CreateProtocolProcessor(pdB.Type, pdB.HostPort);
+		if (m_threadingMode != ETM_MessageThread)
+			m_messageQueues[*PBId] = std::make_unique<RemoteObjectMessageQueue>();
 
 		// set up the protocol processing objects of correct type as defined in config
 		if (protocolB)
 		{
 			protocolB->AddListener(this);
+			protocolB->SetDataPrecision(static_cast<float>(config.GetObjectHandlingData(m_nodeId).Prec));
 			protocolB->SetProtocolConfigurationData(pdB, config.GetRemoteObjectsToActivate(NId, *PBId), m_nodeId, *PBId);
 			m_typeBProtocols[*PBId] = std::unique_ptr<ProtocolProcessor_Abstract>(protocolB);
+			m_metrics.AddProtocol(*PBId);
+
+			// set up the coalescing output stage for the protocol, if configured
+			if (pdB.CoalescingInterval > 0)
+				m_sendStages[*PBId] = std::make_unique<CoalescingSendStage>(*this, *PBId, pdB.CoalescingInterval);
+			else
+				m_sendStages.erase(*PBId);
 
 			// add the protocolnodetype A to datahandlings' list of ProtocolIds for A protocols
 			if (m_dataHandling)
@@ -193,6 +250,17 @@ void ProcessingEngineNode::SetNodeConfiguration(const ProcessingEngineConfig& co
 	}
 }
 
+/**
+ * Setter for the worker thread object that processes the messages received by this node,
+ * if the node is configured for engine thread mode. Must be set before the node is started.
+ *
+ * @param worker	The worker object to notify of newly queued messages.
+ */
+void ProcessingEngineNode::SetProcessingWorker(ProcessingEngineWorker* worker)
+{
+	m_worker = worker;
+}
+
 /**
  * Method that creates the protocol processing object corresponding to the given type.
  *
@@ -205,7 +273,7 @@ ProtocolProcessor_Abstract *ProcessingEngineNode::CreateProtocolProcessor(Protoc
 	switch(type)
 	{
 		case PT_OSCProtocol:
-			return new OSCProtocolProcessor(listenerPortNumber);
+			return new OSCProtocolProcessor(listenerPortNumber, m_threadingMode != ETM_MessageThread);
 		case PT_OCAProtocol:
 			return new OCAProtocolProcessor();
 		case PT_DummyMidiProtocol:
@@ -252,34 +320,625 @@ ObjectDataHandling_Abstract* ProcessingEngineNode::CreateObjectDataHandling(Obje
 /**
  * Method to handle incoming message data from the processing protocol objects (they are members of the node object).
  * This is achieved by the member processing protocol objects accessing their parent with this handling method.
+ * In engine thread mode, this is called on the network thread and the message is only queued
+ * to be processed by the worker thread, otherwise it is processed right away.
+ * The message is counted as received, or as dropped if the queue is full.
  *
  * @param receiver	The protocol processing object that has received the message
  * @param id		The message object id that corresponds to the received message
  * @param msgData	The actual message data that was received
  */
 void ProcessingEngineNode::OnProtocolMessageReceived(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData)
+{
+	double receiveTime = Time::getMillisecondCounterHiRes();
+	m_metrics.Count(MC_Received, receiver->GetId(), id);
+
+	if (m_worker && m_messageQueues.count(receiver->GetId()))
+	{
+		if (m_messageQueues.at(receiver->GetId())->Push(receiver->GetId(), id, msgData, receiveTime))
+			m_worker->Notify();
+		else
+			m_metrics.Count(MC_Dropped, receiver->GetId(), id);
+	}
+	else
+	{
+		ProcessReceivedMessage(receiver, id, msgData, receiveTime);
+		FlushPendingMessages();
+	}
+}
+
+/**
+ * Method to inject a message into the node as if it was received by one of its protocols.
+ * In engine thread mode, the message is queued to be processed by the worker thread. Injected messages have
+ * their own queue, since the receive queue of a protocol must only be filled by the network thread of the protocol.
+ * Injecting threads are serialized, so this can be called from any thread while the protocols are receiving.
+ * In message thread mode, this has to be called on the message thread.
+ * The message is counted as received, or as dropped if the queue is full.
+ *
+ * @param PId		The id of the protocol the message shall appear to be received by
+ * @param id		The message object id
+ * @param msgData	The message data
+ * @return	True if the node has a protocol with the given id, false if not
+ */
+bool ProcessingEngineNode::InjectMessage(ProtocolId PId, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData)
+{
+	ProtocolProcessor_Abstract* receiver = GetProtocol(PId);
+	if (!receiver)
+		return false;
+
+	double receiveTime = Time::getMillisecondCounterHiRes();
+	m_metrics.Count(MC_Received, PId, id);
+
+	if (m_worker && m_injectQueue)
+	{
+		bool pushSuccess = false;
+		{
+			const ScopedLock l(m_injectLock);
+			pushSuccess = m_injectQueue->Push(PId, id, msgData, receiveTime);
+		}
+
+		if (pushSuccess)
+			m_worker->Notify();
+		else
+			m_metrics.Count(MC_Dropped, PId, id);
+	}
+	else
+	{
+		ProcessReceivedMessage(receiver, id, msgData, receiveTime);
+		FlushPendingMessages();
+	}
+
+	return true;
+}
+
+/**
+ * Method to process all messages that were queued for this node since the last call.
+ * To be called by the worker thread the node was assigned to.
+ */
+void ProcessingEngineNode::ProcessQueuedMessages()
+{
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator paiter = m_typeAProtocols.begin(); paiter != m_typeAProtocols.end(); ++paiter)
+		ProcessMessageQueue(paiter->second.get());
+
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator pbiter = m_typeBProtocols.begin(); pbiter != m_typeBProtocols.end(); ++pbiter)
+		ProcessMessageQueue(pbiter->second.get());
+
+	ProcessInjectedMessages();
+
+	FlushPendingMessages();
+}
+
+/**
+ * Helper method to let all protocols send the messages they queued while processing received messages.
+ */
+void ProcessingEngineNode::FlushPendingMessages()
+{
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator paiter = m_typeAProtocols.begin(); paiter != m_typeAProtocols.end(); ++paiter)
+		paiter->second->FlushPendingMessages();
+
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::iterator pbiter = m_typeBProtocols.begin(); pbiter != m_typeBProtocols.end(); ++pbiter)
+		pbiter->second->FlushPendingMessages();
+}
+
+/**
+ * Helper method to process the messages queued for a single protocol.
+ *
+ * @param receiver	The protocol processing object whose queued messages shall be processed
+ */
+void ProcessingEngineNode::ProcessMessageQueue(ProtocolProcessor_Abstract* receiver)
+{
+	if (!receiver || !m_messageQueues.count(receiver->GetId()))
+		return;
+
+	RemoteObjectMessageQueue* queue = m_messageQueues.at(receiver->GetId()).get();
+	RemoteObjectMessageCopy message;
+	double receiveTime = 0;
+	while (queue->Pop(message, receiveTime))
+	{
+		RemoteObjectMessageData msgData = message.GetMessageData();
+		ProcessReceivedMessage(receiver, message.Id, msgData, receiveTime);
+	}
+}
+
+/**
+ * Helper method to process the messages injected into the node, each as if it was received by the protocol it was injected for.
+ */
+void ProcessingEngineNode::ProcessInjectedMessages()
+{
+	if (!m_injectQueue)
+		return;
+
+	RemoteObjectMessageCopy message;
+	double receiveTime = 0;
+	while (m_injectQueue->Pop(message, receiveTime))
+	{
+		ProtocolProcessor_Abstract* receiver = GetProtocol(message.PId);
+		if (!receiver)
+			continue;
+
+		RemoteObjectMessageData msgData = message.GetMessageData();
+		ProcessReceivedMessage(receiver, message.Id, msgData, receiveTime);
+	}
+}
+
+/**
+ * Method to process a received message by passing it to the node listeners, the state cache and the data handling object.
+ * A message the data handling does not forward to any protocol is counted as filtered.
+ *
+ * @param receiver		The protocol processing object that has received the message
+ * @param id			The message object id that corresponds to the received message
+ * @param msgData		The actual message data that was received
+ * @param receiveTime	The time in ms the message was received at, to measure the latency until it is forwarded
+ */
+void ProcessingEngineNode::ProcessReceivedMessage(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData, double receiveTime)
 {
 	// broadcast received data to all listeners
 	for (auto listener : m_listeners)
 		listener->HandleNodeData(this->GetId(), receiver->GetId(), receiver->GetType(), id, msgData);
+
+	if (AnswerFromStateCache(receiver, id, msgData))
+		return;
 	
 	if (m_dataHandling)
+	{
+		m_receiveTime = receiveTime;
+		m_forwardCount = 0;
+
 		m_dataHandling->OnReceivedMessageFromProtocol(receiver->GetId(), id, msgData);
+
+		if (m_forwardCount == 0)
+			m_metrics.Count(MC_Filtered, receiver->GetId(), id);
+		m_receiveTime = 0;
+	}
+}
+
+/**
+ * Helper method to feed the state cache with a received message and to answer it from the cache, if it is a role A poll.
+ * Values received by role B protocols answer their pending polls, values received by role A protocols are
+ * client writes and cached as such. A poll received by a role A protocol is answered with the cached value
+ * right away, if the cache holds one that is not older than the configured max. age.
+ *
+ * @param receiver	The protocol processing object that has received the message
+ * @param id		The message object id that corresponds to the received message
+ * @param msgData	The actual message data that was received
+ * @return	True if the message was answered from the cache and must not be passed to the data handling, false otherwise.
+ */
+bool ProcessingEngineNode::AnswerFromStateCache(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData)
+{
+	if (!m_stateCache.IsEnabled() || id == ROI_Invalid || ProcessingEngineConfig::IsKeepaliveObject(id))
+		return false;
+
+	ProtocolId PId = receiver->GetId();
+	if (m_typeBProtocols.count(PId))
+	{
+		if (msgData.valCount > 0)
+			m_stateCache.EndUpstreamPoll(PId, id, msgData.addrVal);
+
+		return false;
+	}
+
+	if (!m_typeAProtocols.count(PId))
+		return false;
+
+	if (msgData.valCount > 0)
+	{
+		m_stateCache.OnValueWrittenByA(PId, id, msgData, Time::getMillisecondCounterHiRes());
+		return false;
+	}
+
+	RemoteObjectMessageCopy cachedValue;
+	if (!m_stateCache.GetCachedValue(PId, id, msgData.addrVal, Time::getMillisecondCounterHiRes(), cachedValue))
+		return false;
+
+	// answer the poll right away, bypassing the coalescing stage to not delay the response
+	RemoteObjectMessageData cachedMsgData = cachedValue.GetMessageData();
+	SendMessageToProtocol(PId, id, cachedMsgData);
+
+	return true;
+}
+
+/**
+ * Getter for the state cache of the node, e.g. to query how many polls it answered.
+ *
+ * @return	The state cache of the node.
+ */
+const RemoteObjectStateCache& ProcessingEngineNode::GetStateCache() const
+{
+	return m_stateCache;
+}
+
+/**
+ * Getter for the message counters and latencies of the node.
+ *
+ * @return	The metrics of the node.
+ */
+const NodeMetrics& ProcessingEngineNode::GetMetrics() const
+{
+	return m_metrics;
+}
+
+/**
+ * Method to write a snapshot of the node metrics into an xml element. Besides the message counters and latencies,
+ * this includes the queue depths, state cache, rate limiter, polling and subscription statistics of the node and its protocols.
+ * Can be called from any thread while the node is running, but not concurrently with configuring it.
+ *
+ * @param NodeElement	The xml element to write the metrics of the node into
+ * @return	True on success, false on failure
+ */
+bool ProcessingEngineNode::WriteMetrics(XmlElement* NodeElement) const
+{
+	if (!NodeElement)
+		return false;
+
+	NodeElement->setAttribute("Id", static_cast<int>(m_nodeId));
+	for (int i = 0; i < MC_UserMAX; ++i)
+		NodeElement->setAttribute(NodeMetrics::GetCounterName(static_cast<MetricsCounter>(i)), String(m_metrics.GetCount(static_cast<MetricsCounter>(i))));
+
+	if (XmlElement* LatencyElement = NodeElement->createNewChildElement("Latency"))
+	{
+		const LatencyHistogram& latencies = m_metrics.GetLatencyHistogram();
+		LatencyElement->setAttribute("Count", String(latencies.GetCount()));
+		LatencyElement->setAttribute("P50", latencies.GetPercentile(50));
+		LatencyElement->setAttribute("P99", latencies.GetPercentile(99));
+		LatencyElement->setAttribute("P999", latencies.GetPercentile(99.9));
+		LatencyElement->setAttribute("Max", latencies.GetMax());
+	}
+
+	if (m_injectQueue)
+	{
+		if (XmlElement* InjectQueueElement = NodeElement->createNewChildElement("InjectQueue"))
+		{
+			InjectQueueElement->setAttribute("Depth", m_injectQueue->GetNumQueued());
+			InjectQueueElement->setAttribute("Dropped", String(m_injectQueue->GetDroppedCount()));
+		}
+	}
+
+	if (m_stateCache.IsEnabled())
+	{
+		if (XmlElement* StateCacheElement = NodeElement->createNewChildElement("StateCache"))
+		{
+			StateCacheElement->setAttribute("Answered", String(m_stateCache.GetAnsweredCount()));
+			StateCacheElement->setAttribute("Deduplicated", String(m_stateCache.GetDeduplicatedCount()));
+		}
+	}
+
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::const_iterator paiter = m_typeAProtocols.begin(); paiter != m_typeAProtocols.end(); ++paiter)
+		WriteProtocolMetrics(NodeElement->createNewChildElement("ProtocolA"), paiter->second.get());
+
+	for (std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>::const_iterator pbiter = m_typeBProtocols.begin(); pbiter != m_typeBProtocols.end(); ++pbiter)
+		WriteProtocolMetrics(NodeElement->createNewChildElement("ProtocolB"), pbiter->second.get());
+
+	// only the objects that had traffic are listed, to keep the snapshot short
+	for (int i = 0; i < ROI_UserMAX; ++i)
+	{
+		RemoteObjectIdentifier ROId = static_cast<RemoteObjectIdentifier>(i);
+		if (m_metrics.GetObjectCount(MC_Received, ROId) == 0 && m_metrics.GetObjectCount(MC_Sent, ROId) == 0)
+			continue;
+
+		if (XmlElement* ObjectElement = NodeElement->createNewChildElement("Object"))
+		{
+			ObjectElement->setAttribute("Name", ProcessingEngineConfig::GetObjectDescription(ROId).removeCharacters(" "));
+			for (int j = 0; j < MC_UserMAX; ++j)
+				ObjectElement->setAttribute(NodeMetrics::GetCounterName(static_cast<MetricsCounter>(j)), String(m_metrics.GetObjectCount(static_cast<MetricsCounter>(j), ROId)));
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Helper method to write a snapshot of the metrics of a single protocol into an xml element.
+ *
+ * @param ProtocolElement	The xml element to write the metrics of the protocol into
+ * @param protocol			The protocol processing object to write the metrics of
+ * @return	True on success, false on failure
+ */
+bool ProcessingEngineNode::WriteProtocolMetrics(XmlElement* ProtocolElement, ProtocolProcessor_Abstract* protocol) const
+{
+	if (!ProtocolElement || !protocol)
+		return false;
+
+	ProtocolId PId = protocol->GetId();
+	ProtocolElement->setAttribute("Id", static_cast<int>(PId));
+	ProtocolElement->setAttribute("Type", ProcessingEngineConfig::ProtocolTypeToString(protocol->GetType()));
+	for (int i = 0; i < MC_UserMAX; ++i)
+		ProtocolElement->setAttribute(NodeMetrics::GetCounterName(static_cast<MetricsCounter>(i)), String(m_metrics.GetProtocolCount(static_cast<MetricsCounter>(i), PId)));
+
+	if (m_messageQueues.count(PId))
+	{
+		if (XmlElement* ReceiveQueueElement = ProtocolElement->createNewChildElement("ReceiveQueue"))
+		{
+			ReceiveQueueElement->setAttribute("Depth", m_messageQueues.at(PId)->GetNumQueued());
+			ReceiveQueueElement->setAttribute("Dropped", String(m_messageQueues.at(PId)->GetDroppedCount()));
+		}
+	}
+
+	if (m_sendStages.count(PId))
+	{
+		if (XmlElement* CoalescingElement = ProtocolElement->createNewChildElement("Coalescing"))
+		{
+			const RemoteObjectCoalescingQueue& queue = m_sendStages.at(PId)->GetQueue();
+			CoalescingElement->setAttribute("Depth", queue.GetNumQueued());
+			CoalescingElement->setAttribute("Coalesced", String(queue.GetCoalescedCount()));
+			CoalescingElement->setAttribute("Dropped", String(queue.GetDroppedCount()));
+		}
+	}
+
+	const ProtocolRateLimiter& rateLimiter = protocol->GetRateLimiter();
+	if (rateLimiter.IsEnabled())
+	{
+		if (XmlElement* RateLimiterElement = ProtocolElement->createNewChildElement("RateLimiter"))
+		{
+			const char* laneNames[RLL_UserMAX] = { "Position", "Parameter", "Polling" };
+			for (int i = 0; i < RLL_UserMAX; ++i)
+			{
+				RateLimiterElement->setAttribute(String(laneNames[i]) + "Depth", rateLimiter.GetQueueDepth(static_cast<RateLimiterLane>(i)));
+				RateLimiterElement->setAttribute(String(laneNames[i]) + "Dropped", String(rateLimiter.GetDroppedCount(static_cast<RateLimiterLane>(i))));
+			}
+		}
+	}
+
+	if (protocol->GetType() == PT_OSCProtocol)
+	{
+		OSCProtocolProcessor* oscProtocol = static_cast<OSCProtocolProcessor*>(protocol);
+		ProtocolElement->setAttribute("Subscriptions", oscProtocol->GetSubscriptionCount());
+
+		// the polling statistics are summed up over all polled objects
+		Array<OSCPollingScheduler::PollStatistics> pollStatistics = oscProtocol->GetPollStatistics();
+		if (!pollStatistics.isEmpty())
+		{
+			if (XmlElement* PollingElement = ProtocolElement->createNewChildElement("Polling"))
+			{
+				double rate = 0;
+				uint64 pollCount = 0;
+				uint64 responseCount = 0;
+				uint64 lostCount = 0;
+				double roundTripTime = 0;
+				int answeredObjects = 0;
+				for (const OSCPollingScheduler::PollStatistics& statistics : pollStatistics)
+				{
+					rate += statistics.CurrentRate;
+					pollCount += statistics.PollCount;
+					responseCount += statistics.ResponseCount;
+					lostCount += statistics.LostCount;
+					if (statistics.ResponseCount > 0)
+					{
+						roundTripTime += statistics.RoundTripTime;
+						++answeredObjects;
+					}
+				}
+
+				PollingElement->setAttribute("Objects", pollStatistics.size());
+				PollingElement->setAttribute("Rate", rate);
+				PollingElement->setAttribute("Polls", String(pollCount));
+				PollingElement->setAttribute("Responses", String(responseCount));
+				PollingElement->setAttribute("Lost", String(lostCount));
+				PollingElement->setAttribute("RoundTripTime", answeredObjects > 0 ? roundTripTime / answeredObjects : 0.0);
+				PollingElement->setAttribute("Responsive", oscProtocol->IsPolledDeviceResponsive());
+			}
+		}
+	}
+
+	return true;
 }
 
 /**
- * Method to forward a message to member protocol with given id
+ * Method to forward a message to member protocol with given id.
+ * The message is counted as sent once it was handed to the protocol, or as dropped if that failed.
+ * A message queued in the coalescing output stage of the protocol is only counted when the stage sends it,
+ * since it may still be replaced by a newer value of the same object.
  *
  * @param PId		The id of the protocol to send the RemoteObject to
  * @param Id		The message object id that corresponds to the message to be sent
  * @param msgData	The actual message data that was received
  */
 bool ProcessingEngineNode::SendMessageTo(ProtocolId PId, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData) const
+{
+	++m_forwardCount;
+
+	// values sent to role A protocols are cached to answer their polls, identical polls sent to role B protocols are only sent once
+	if (m_stateCache.IsEnabled() && Id != ROI_Invalid && !ProcessingEngineConfig::IsKeepaliveObject(Id))
+	{
+		if (m_typeAProtocols.count(PId))
+			m_stateCache.OnValueSentToA(PId, Id, msgData, Time::getMillisecondCounterHiRes());
+		else if (msgData.valCount == 0 && m_typeBProtocols.count(PId) && !m_stateCache.BeginUpstreamPoll(PId, Id, msgData.addrVal, Time::getMillisecondCounterHiRes()))
+			return true;
+	}
+
+	// if the protocol has a coalescing output stage, only the latest value per object is sent in the stages' interval.
+	// Messages the stage cannot hold are sent right away.
+	if (m_sendStages.count(PId) && m_sendStages.at(PId)->Push(Id, msgData, m_receiveTime))
+		return true;
+
+	bool sendSuccess = SendMessageToProtocol(PId, Id, msgData);
+	CountSentMessage(PId, Id, sendSuccess, m_receiveTime);
+
+	return sendSuccess;
+}
+
+/**
+ * Helper method to count a message that was handed to a protocol as sent or dropped,
+ * and to record its latency from being received until being sent.
+ *
+ * @param PId			The id of the protocol the message was handed to
+ * @param Id			The message object id
+ * @param sendSuccess	True if the protocol sent the message, false if it was dropped
+ * @param receiveTime	The time in ms the message was received at, 0 if not known
+ */
+void ProcessingEngineNode::CountSentMessage(ProtocolId PId, RemoteObjectIdentifier Id, bool sendSuccess, double receiveTime) const
+{
+	m_metrics.Count(sendSuccess ? MC_Sent : MC_Dropped, PId, Id);
+	if (sendSuccess && receiveTime > 0)
+		m_metrics.RecordLatency(Time::getMillisecondCounterHiRes() - receiveTime);
+}
+
+/**
+ * Method to send a message to member protocol with given id right away, bypassing its coalescing output stage
+ *
+ * @param PId		The id of the protocol to send the RemoteObject to
+ * @param Id		The message object id that corresponds to the message to be sent
+ * @param msgData	The actual message data that shall be sent
+ */
+bool ProcessingEngineNode::SendMessageToProtocol(ProtocolId PId, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData) const
+{
+	ProtocolProcessor_Abstract* protocol = GetProtocol(PId);
+	if (protocol)
+		return protocol->SendMessage(Id, msgData);
+	else
+		return false;
+}
+
+/**
+ * Getter for the member protocol with given id
+ *
+ * @param PId	The id of the protocol to get
+ * @return	The protocol processing object, nullptr if the node has no protocol with the given id
+ */
+ProtocolProcessor_Abstract* ProcessingEngineNode::GetProtocol(ProtocolId PId) const
 {
 	if (m_typeAProtocols.count(PId))
-		return m_typeAProtocols.at(PId)->SendMessage(Id, msgData);
+		return m_typeAProtocols.at(PId).get();
 	else if (m_typeBProtocols.count(PId))
-		return m_typeBProtocols.at(PId)->SendMessage(Id, msgData);
+		return m_typeBProtocols.at(PId).get();
 	else
-		return false;
+		return nullptr;
+}
+
+/**
+ * Called by the send stage timer to send the pending messages of the stages whose interval elapsed.
+ */
+void ProcessingEngineNode::OnSendStageTimer()
+{
+	double now = Time::getMillisecondCounterHiRes();
+	double tolerance = 0.5 * m_sendStageTickInterval;
+
+	for (std::map<ProtocolId, std::unique_ptr<CoalescingSendStage>>::iterator siter = m_sendStages.begin(); siter != m_sendStages.end(); ++siter)
+		siter->second->DrainIfDue(now, tolerance);
+}
+
+
+// **************************************************************************************
+//    class ProcessingEngineNode::CoalescingSendStage
+// **************************************************************************************
+/**
+ * Constructor
+ *
+ * @param parentNode	The node that owns the protocol the messages are sent to.
+ * @param PId			The id of the protocol the messages are sent to.
+ * @param interval		The interval in ms the pending messages are sent in.
+ */
+ProcessingEngineNode::CoalescingSendStage::CoalescingSendStage(const ProcessingEngineNode& parentNode, ProtocolId PId, int interval)
+	: m_parentNode(parentNode),
+	m_protocolId(PId),
+	m_interval(interval),
+	m_drainBuffer(static_cast<size_t>(m_queue.GetCapacity()))
+{
+	m_nextDrainTime = 0;
+}
+
+/**
+ * Destructor
+ */
+ProcessingEngineNode::CoalescingSendStage::~CoalescingSendStage()
+{
+}
+
+/**
+ * Starts sending the pending messages in the configured interval, counted from now.
+ */
+void ProcessingEngineNode::CoalescingSendStage::Start()
+{
+	const ScopedLock l(m_drainLock);
+
+	m_nextDrainTime = Time::getMillisecondCounterHiRes() + m_interval;
+}
+
+/**
+ * Sends the messages that are still pending. To be called after the node's send stage timer was stopped.
+ */
+void ProcessingEngineNode::CoalescingSendStage::Stop()
+{
+	Drain();
+}
+
+/**
+ * Method to queue a message to be sent with the next interval.
+ * Replaces a pending message for the same object id and addressing.
+ *
+ * @param Id			The message object id that corresponds to the message to be sent
+ * @param msgData		The actual message data that shall be sent
+ * @param receiveTime	The time in ms the message was received at, to record its latency once it is sent. 0 if not known.
+ * @return	True if the message was queued, false if it has to be sent right away.
+ */
+bool ProcessingEngineNode::CoalescingSendStage::Push(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double receiveTime)
+{
+	return m_queue.Push(m_protocolId, Id, msgData, receiveTime);
+}
+
+/**
+ * Method to send all pending messages to the protocol. The messages are counted as sent or dropped here,
+ * with their latency measured from being received until being sent.
+ */
+void ProcessingEngineNode::CoalescingSendStage::Drain()
+{
+	const ScopedLock l(m_drainLock);
+
+	int count = m_queue.TakeAll(m_drainBuffer.data(), static_cast<int>(m_drainBuffer.size()));
+	if (count == 0)
+		return;
+
+	for (int i = 0; i < count; ++i)
+	{
+		RemoteObjectMessageCopy& message = m_drainBuffer[static_cast<size_t>(i)];
+		RemoteObjectMessageData msgData = message.GetMessageData();
+		bool sendSuccess = m_parentNode.SendMessageToProtocol(m_protocolId, message.Id, msgData);
+		m_parentNode.CountSentMessage(m_protocolId, message.Id, sendSuccess, message.receiveTime);
+	}
+
+	ProtocolProcessor_Abstract* protocol = m_parentNode.GetProtocol(m_protocolId);
+	if (protocol)
+		protocol->FlushPendingMessages();
+}
+
+/**
+ * Method to send all pending messages to the protocol, if the interval elapsed.
+ * Called by the node's send stage timer, that may tick in a shorter interval than the one of this stage.
+ *
+ * @param now		The current time in ms.
+ * @param tolerance	The time in ms the interval may be short of elapsed, to not skip a timer tick that arrives a little early.
+ */
+void ProcessingEngineNode::CoalescingSendStage::DrainIfDue(double now, double tolerance)
+{
+	{
+		const ScopedLock l(m_drainLock);
+
+		if (m_interval <= 0 || now + tolerance < m_nextDrainTime)
+			return;
+
+		m_nextDrainTime += m_interval;
+		if (m_nextDrainTime + tolerance <= now)
+			m_nextDrainTime = now + m_interval;
+	}
+
+	Drain();
+}
+
+/**
+ * Getter for the interval the pending messages are sent in.
+ *
+ * @return	The interval in ms.
+ */
+int ProcessingEngineNode::CoalescingSendStage::GetInterval() const
+{
+	return m_interval;
+}
+
+/**
+ * Getter for the queue of pending messages, e.g. to query its depth.
+ *
+ * @return	The queue of pending messages.
+ */
+const RemoteObjectCoalescingQueue& ProcessingEngineNode::CoalescingSendStage::GetQueue() const
+{
+	return m_queue;
 }
@@ -37,11 +37,16 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "RemoteProtocolBridgeCommon.h"
 
 #include "ProtocolProcessor/ProtocolProcessor_Abstract.h"
+#include "RemoteObjectMessageQueue.h"
+#include "RemoteObjectCoalescingQueue.h"
+#include "RemoteObjectStateCache.h"
+#include "NodeMetrics.h"
 
 // Fwd. declarations
 class ObjectDataHandling_Abstract;
 class ProcessingEngineConfig;
 class ProcessingEngine;
+class ProcessingEngineWorker;
 
 /**
  * Class ProcessingEngineNode is a class to hold a processing element handled by engine class.
@@ -79,10 +84,76 @@ public:
 	bool Start();
 	bool Stop();
 	void SetNodeConfiguration(const ProcessingEngineConfig& config, NodeId NId);
+	void SetProcessingWorker(ProcessingEngineWorker* worker);
 
 	void OnProtocolMessageReceived(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData) override;
+	bool InjectMessage(ProtocolId PId, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData);
+	void ProcessQueuedMessages();
+
+	const RemoteObjectStateCache& GetStateCache() const;
+	const NodeMetrics& GetMetrics() const;
+	bool WriteMetrics(XmlElement* NodeElement) const;
 
 private:
+	/**
+	 * Output stage that coalesces the messages sent to a protocol to their latest value per object
+	 * and sends them to the protocol in a fixed interval. The stages of a node are driven by the node's send stage timer.
+	 */
+	class CoalescingSendStage
+	{
+	public:
+		CoalescingSendStage(const ProcessingEngineNode& parentNode, ProtocolId PId, int interval);
+		~CoalescingSendStage();
+
+		void Start();
+		void Stop();
+
+		bool Push(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double receiveTime);
+		void Drain();
+		void DrainIfDue(double now, double tolerance);
+
+		int GetInterval() const;
+		const RemoteObjectCoalescingQueue& GetQueue() const;
+
+	private:
+		const ProcessingEngineNode&				m_parentNode;	/**< The node that owns the target protocol. */
+		ProtocolId								m_protocolId;	/**< The id of the protocol the messages are sent to. */
+		int										m_interval;		/**< The interval in ms the pending messages are sent in. */
+		double									m_nextDrainTime;	/**< The time in ms the pending messages are sent next. */
+		RemoteObjectCoalescingQueue				m_queue;		/**< The queue of pending messages. */
+		std::vector<RemoteObjectMessageCopy>	m_drainBuffer;	/**< Preallocated buffer to take the pending messages out of the queue for sending. */
+		CriticalSection							m_drainLock;	/**< Lock to serialize draining from the timer and from stopping the node. */
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CoalescingSendStage)
+	};
+
+	/**
+	 * Timer driving all coalescing send stages of the node on a single thread,
+	 * instead of a timer thread per stage.
+	 */
+	class SendStageTimer : public HighResolutionTimer
+	{
+	public:
+		SendStageTimer(ProcessingEngineNode& parentNode) : m_parentNode(parentNode) {}
+		void hiResTimerCallback() override { m_parentNode.OnSendStageTimer(); }
+
+	private:
+		ProcessingEngineNode& m_parentNode;	/**< The node to drain the due send stages of. */
+	};
+
+	void OnSendStageTimer();
+
+	bool SendMessageToProtocol(ProtocolId PId, RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData) const;
+	void CountSentMessage(ProtocolId PId, RemoteObjectIdentifier Id, bool sendSuccess, double receiveTime) const;
+	ProtocolProcessor_Abstract* GetProtocol(ProtocolId PId) const;
+
+	void ProcessReceivedMessage(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData, double receiveTime);
+	bool AnswerFromStateCache(ProtocolProcessor_Abstract* receiver, RemoteObjectIdentifier id, RemoteObjectMessageData& msgData);
+	void ProcessMessageQueue(ProtocolProcessor_Abstract* receiver);
+	void ProcessInjectedMessages();
+	void FlushPendingMessages();
+	bool WriteProtocolMetrics(XmlElement* ProtocolElement, ProtocolProcessor_Abstract* protocol) const;
+
 	ProtocolProcessor_Abstract* CreateProtocolProcessor(ProtocolType type, int listenerPortNumber);
 	ObjectDataHandling_Abstract* CreateObjectDataHandling(ObjectHandlingMode mode);
 
@@ -90,9 +161,27 @@ private:
 
 	NodeId																m_nodeId;			/**< The id of the bridging node object. */
 
+	mutable NodeMetrics													m_metrics;			/**< The message counters and latencies of the node. Declared before the protocols to outlive their network threads. */
+
+	std::map<ProtocolId, std::unique_ptr<RemoteObjectMessageQueue>>	m_messageQueues;	/**< The received message queues per protocol, to hand over messages from network threads to the worker. Declared before the protocols to outlive their network threads. */
+	std::unique_ptr<RemoteObjectMessageQueue>							m_injectQueue;		/**< The queue of injected messages, to hand them over from the injecting threads to the worker. */
+	CriticalSection														m_injectLock;		/**< Lock to serialize the injecting threads, since the inject queue takes a single producer. */
+
 	std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>	m_typeAProtocols;	/**< The remote protocols that act with role A of this node. */
 	std::map<ProtocolId, std::unique_ptr<ProtocolProcessor_Abstract>>	m_typeBProtocols;	/**< The remote protocols that act with role B of this node. */
 
+	mutable RemoteObjectStateCache										m_stateCache;		/**< The latest known object values, to answer role A polls without forwarding them to role B. */
+
+	std::map<ProtocolId, std::unique_ptr<CoalescingSendStage>>			m_sendStages;		/**< The coalescing output stages per protocol that has a coalescing interval configured. Declared after the protocols to be gone before them. */
+	SendStageTimer														m_sendStageTimer;	/**< Timer draining the due send stages, ticking at the shortest stage interval. Declared after the stages to be stopped before them. */
+	int																	m_sendStageTickInterval;	/**< The interval in ms the send stage timer ticks in. */
+
 	std::vector<ProcessingEngineNode::NodeListener*>					m_listeners;		/**< The listner objects, for e.g. logging message traffic. */
 
+	double																m_receiveTime;		/**< The time in ms the message currently processed was received at. 0 while no message is processed. */
+	mutable int															m_forwardCount;		/**< The count of messages the data handling forwarded for the message currently processed. */
+
+	EngineThreadingMode													m_threadingMode;	/**< The threading mode the node was configured for. */
+	ProcessingEngineWorker*												m_worker;			/**< The worker thread that processes the received messages in engine thread mode. Not owned by the node. */
+
 };
@@ -0,0 +1,100 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "ProcessingEngineWorker.h"
+
+#include "ProcessingEngineNode.h"
+
+
+// **************************************************************************************
+//    class ProcessingEngineWorker
+// **************************************************************************************
+/**
+ * Constructor
+ *
+ * @param threadName	The name to give the underlying thread.
+ */
+ProcessingEngineWorker::ProcessingEngineWorker(const String& threadName)
+	: Thread(threadName)
+{
+}
+
+/**
+ * Destructor. Makes sure the thread is shut down before the object is gone.
+ */
+ProcessingEngineWorker::~ProcessingEngineWorker()
+{
+	stopThread(2 * ET_WorkerIdleTimeout);
+}
+
+/**
+ * Method to assign a node to this worker. Must not be called while the thread is running.
+ *
+ * @param node	The node whose received messages shall be processed by this worker.
+ */
+void ProcessingEngineWorker::AddNode(ProcessingEngineNode* node)
+{
+	jassert(!isThreadRunning());
+
+	if (node)
+		m_nodes.addIfNotAlreadyThere(node);
+}
+
+/**
+ * Method to wake the worker thread because new messages are available.
+ * Safe to be called from any thread.
+ */
+void ProcessingEngineWorker::Notify()
+{
+	notify();
+}
+
+/**
+ * Reimplemented thread loop. Waits to be notified of new messages
+ * and lets all assigned nodes process their queued messages.
+ */
+void ProcessingEngineWorker::run()
+{
+	while (!threadShouldExit())
+	{
+		wait(ET_WorkerIdleTimeout);
+
+		if (threadShouldExit())
+			return;
+
+		for (auto node : m_nodes)
+			node->ProcessQueuedMessages();
+	}
+}
@@ -0,0 +1,67 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+// Fwd. declarations
+class ProcessingEngineNode;
+
+
+/**
+ * Class ProcessingEngineWorker is a thread that drains the received message queues
+ * of the engine nodes it is assigned to, to decouple protocol message processing from the application message loop.
+ * Nodes wake the worker by calling Notify after queueing a message.
+ */
+class ProcessingEngineWorker : public Thread
+{
+public:
+	ProcessingEngineWorker(const String& threadName);
+	~ProcessingEngineWorker() override;
+
+	void AddNode(ProcessingEngineNode* node);
+	void Notify();
+
+	//==============================================================================
+	void run() override;
+
+private:
+	Array<ProcessingEngineNode*>	m_nodes;	/**< The nodes whose queues are processed by this worker. Only to be modified while the thread is not running. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessingEngineWorker)
+};
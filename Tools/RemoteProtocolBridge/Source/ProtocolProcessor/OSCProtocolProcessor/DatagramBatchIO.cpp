@@ -0,0 +1,356 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "DatagramBatchIO.h"
+
+#if JUCE_WINDOWS
+ #include <winsock2.h>
+ #include <ws2tcpip.h>
+#else
+ #include <sys/types.h>
+ #include <sys/socket.h>
+ #include <netinet/in.h>
+ #include <errno.h>
+#endif
+
+
+namespace SenderAwareOSC
+{
+
+namespace
+{
+#if JUCE_WINDOWS
+	using SocketHandle = SOCKET;
+	using SocketAddressLength = int;
+#else
+	using SocketHandle = int;
+	using SocketAddressLength = socklen_t;
+#endif
+
+	/**
+	 * Helper to convert a socket address to a numeric sender endpoint.
+	 *
+	 * @param address	The socket address to convert.
+	 * @return	The sender endpoint, invalid if the address is no IPv4 address.
+	 */
+	SenderEndpoint ToSenderEndpoint(const sockaddr_in& address)
+	{
+		if (address.sin_family != AF_INET)
+			return SenderEndpoint();
+
+		return SenderEndpoint(ByteOrder::bigEndianInt(&address.sin_addr.s_addr), ByteOrder::bigEndianShort(&address.sin_port));
+	}
+
+	/**
+	 * Helper to convert a numeric endpoint to a socket address.
+	 *
+	 * @param endpoint	The endpoint to convert.
+	 * @return	The socket address.
+	 */
+	sockaddr_in ToSocketAddress(const SenderEndpoint& endpoint)
+	{
+		sockaddr_in address;
+		zerostruct(address);
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = ByteOrder::swapIfLittleEndian(endpoint.address);
+		address.sin_port = ByteOrder::swapIfLittleEndian(static_cast<uint16>(endpoint.port));
+
+		return address;
+	}
+}
+
+
+// **************************************************************************************
+//    class DatagramReceiveBatch
+// **************************************************************************************
+/**
+ * Constructor of the datagram receive batch class.
+ */
+DatagramReceiveBatch::DatagramReceiveBatch()
+	: m_buffer(static_cast<size_t>(ReceiveBatchSize) * DatagramBufferSize)
+{
+	for (int i = 0; i < ReceiveBatchSize; ++i)
+		m_sizes[i] = 0;
+}
+
+/**
+ * Destructor of the datagram receive batch class.
+ */
+DatagramReceiveBatch::~DatagramReceiveBatch()
+{
+}
+
+/**
+ * Method to read the datagrams pending on the given socket.
+ * Must only be called when the socket is ready for reading, since it may block otherwise on non-Linux platforms.
+ *
+ * @param socket	The socket to read from.
+ * @return	The number of datagrams read, -1 on error.
+ */
+int DatagramReceiveBatch::Receive(DatagramSocket& socket)
+{
+	SocketHandle handle = static_cast<SocketHandle>(socket.getRawSocketHandle());
+
+#if JUCE_LINUX
+	mmsghdr headers[ReceiveBatchSize];
+	iovec buffers[ReceiveBatchSize];
+	sockaddr_in addresses[ReceiveBatchSize];
+
+	for (int i = 0; i < ReceiveBatchSize; ++i)
+	{
+		buffers[i].iov_base = m_buffer + static_cast<size_t>(i) * DatagramBufferSize;
+		buffers[i].iov_len = DatagramBufferSize;
+
+		zerostruct(headers[i]);
+		headers[i].msg_hdr.msg_name = &addresses[i];
+		headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		headers[i].msg_hdr.msg_iov = &buffers[i];
+		headers[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	int count = ::recvmmsg(handle, headers, ReceiveBatchSize, MSG_DONTWAIT, nullptr);
+	if (count < 0)
+		return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+
+	for (int i = 0; i < count; ++i)
+	{
+		m_sizes[i] = headers[i].msg_len;
+		m_senders[i] = ToSenderEndpoint(addresses[i]);
+	}
+
+	return count;
+#else
+	sockaddr_in address;
+	SocketAddressLength addressLength = sizeof(address);
+
+#if JUCE_WINDOWS
+	int bytesRead = (int)::recvfrom(handle, m_buffer, DatagramBufferSize, 0, (sockaddr*)&address, &addressLength);
+#else
+	int bytesRead = (int)::recvfrom(handle, m_buffer, (size_t)DatagramBufferSize, 0, (sockaddr*)&address, &addressLength);
+#endif
+	if (bytesRead < 0)
+		return -1;
+
+	m_sizes[0] = static_cast<size_t>(bytesRead);
+	m_senders[0] = ToSenderEndpoint(address);
+
+	return 1;
+#endif
+}
+
+/**
+ * Getter for the data of a datagram read with the last call to Receive.
+ *
+ * @param index	The index of the datagram.
+ * @return	The datagram data.
+ */
+const char* DatagramReceiveBatch::GetData(int index) const
+{
+	jassert(index >= 0 && index < ReceiveBatchSize);
+	return m_buffer + static_cast<size_t>(index) * DatagramBufferSize;
+}
+
+/**
+ * Getter for the size of a datagram read with the last call to Receive.
+ *
+ * @param index	The index of the datagram.
+ * @return	The datagram size.
+ */
+size_t DatagramReceiveBatch::GetSize(int index) const
+{
+	jassert(index >= 0 && index < ReceiveBatchSize);
+	return m_sizes[index];
+}
+
+/**
+ * Getter for the sender endpoint of a datagram read with the last call to Receive.
+ *
+ * @param index	The index of the datagram.
+ * @return	The datagram sender endpoint.
+ */
+const SenderEndpoint& DatagramReceiveBatch::GetSender(int index) const
+{
+	jassert(index >= 0 && index < ReceiveBatchSize);
+	return m_senders[index];
+}
+
+
+// **************************************************************************************
+//    class DatagramSendBatch
+// **************************************************************************************
+/**
+ * Constructor of the datagram send batch class.
+ */
+DatagramSendBatch::DatagramSendBatch()
+	: m_targetPort(0), m_buffer(static_cast<size_t>(SendBufferSize)), m_bufferedSize(0), m_count(0)
+{
+}
+
+/**
+ * Destructor of the datagram send batch class.
+ */
+DatagramSendBatch::~DatagramSendBatch()
+{
+}
+
+/**
+ * Setter for the target endpoint datagrams are sent to.
+ * Queued datagrams have to be flushed before changing the target.
+ *
+ * @param hostName		The target host name or ip address.
+ * @param portNumber	The target port.
+ */
+void DatagramSendBatch::SetTarget(const String& hostName, int portNumber)
+{
+	jassert(IsEmpty());
+
+	m_targetHostName = hostName;
+	m_targetPort = portNumber;
+	m_targetEndpoint = SenderEndpoint::fromString(hostName, portNumber);
+}
+
+/**
+ * Method to send a datagram to the target endpoint. On Linux the datagram is queued
+ * until the batch is flushed or full, otherwise it is written right away.
+ *
+ * @param socket	The socket to send with.
+ * @param data		The datagram data.
+ * @param dataSize	The datagram size.
+ * @return	True if the datagram was queued or written.
+ */
+bool DatagramSendBatch::Send(DatagramSocket& socket, const char* data, size_t dataSize)
+{
+#if JUCE_LINUX
+	if (m_targetEndpoint.isValid() && dataSize <= SendBufferSize)
+	{
+		bool flushSuccess = true;
+		if (m_count == SendBatchSize || m_bufferedSize + dataSize > SendBufferSize)
+			flushSuccess = Flush(socket);
+
+		memcpy(m_buffer + m_bufferedSize, data, dataSize);
+		m_offsets[m_count] = m_bufferedSize;
+		m_sizes[m_count] = dataSize;
+		m_bufferedSize += dataSize;
+		m_count++;
+
+		return flushSuccess;
+	}
+#endif
+
+	return Write(socket, data, dataSize);
+}
+
+/**
+ * Method to send all queued datagrams.
+ *
+ * @param socket	The socket to send with.
+ * @return	True if all queued datagrams were sent.
+ */
+bool DatagramSendBatch::Flush(DatagramSocket& socket)
+{
+	if (m_count == 0)
+		return true;
+
+	bool sendSuccess = true;
+
+#if JUCE_LINUX
+	sockaddr_in target = ToSocketAddress(m_targetEndpoint);
+	mmsghdr headers[SendBatchSize];
+	iovec buffers[SendBatchSize];
+
+	for (int i = 0; i < m_count; ++i)
+	{
+		buffers[i].iov_base = m_buffer + m_offsets[i];
+		buffers[i].iov_len = m_sizes[i];
+
+		zerostruct(headers[i]);
+		headers[i].msg_hdr.msg_name = &target;
+		headers[i].msg_hdr.msg_namelen = sizeof(target);
+		headers[i].msg_hdr.msg_iov = &buffers[i];
+		headers[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	SocketHandle handle = static_cast<SocketHandle>(socket.getRawSocketHandle());
+	int sentCount = 0;
+	while (sentCount < m_count)
+	{
+		int count = ::sendmmsg(handle, headers + sentCount, static_cast<unsigned int>(m_count - sentCount), 0);
+		if (count <= 0)
+		{
+			if (count < 0 && errno == EINTR)
+				continue;
+
+			sendSuccess = false;
+			break;
+		}
+
+		sentCount += count;
+	}
+#else
+	// datagrams are only queued on Linux
+	ignoreUnused(socket);
+	jassertfalse;
+#endif
+
+	m_bufferedSize = 0;
+	m_count = 0;
+
+	return sendSuccess;
+}
+
+/**
+ * Getter for if no datagrams are queued.
+ *
+ * @return	True if no datagrams are queued.
+ */
+bool DatagramSendBatch::IsEmpty() const
+{
+	return m_count == 0;
+}
+
+/**
+ * Helper method to write a single datagram to the target right away.
+ *
+ * @param socket	The socket to send with.
+ * @param data		The datagram data.
+ * @param dataSize	The datagram size.
+ * @return	True if the complete datagram was written.
+ */
+bool DatagramSendBatch::Write(DatagramSocket& socket, const char* data, size_t dataSize)
+{
+	return socket.write(m_targetHostName, m_targetPort, data, static_cast<int>(dataSize)) == static_cast<int>(dataSize);
+}
+
+}
@@ -0,0 +1,121 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "SenderAwareOSCReceiver.h"
+
+#include <JuceHeader.h>
+
+
+namespace SenderAwareOSC
+{
+
+/**
+ * Class DatagramReceiveBatch reads the datagrams that are pending on a udp socket, incl. their numeric sender endpoints.
+ * On Linux, up to ReceiveBatchSize datagrams are read with a single recvmmsg call,
+ * on other platforms a single datagram is read per call with recvfrom.
+ */
+class DatagramReceiveBatch
+{
+public:
+	enum
+	{
+#if JUCE_LINUX
+		ReceiveBatchSize = 16,		/**< Max. number of datagrams read with a single call. */
+#else
+		ReceiveBatchSize = 1,		/**< Max. number of datagrams read with a single call. */
+#endif
+		DatagramBufferSize = 65535	/**< Buffer size per datagram, large enough for any udp payload. */
+	};
+
+public:
+	DatagramReceiveBatch();
+	~DatagramReceiveBatch();
+
+	int Receive(DatagramSocket& socket);
+
+	const char* GetData(int index) const;
+	size_t GetSize(int index) const;
+	const SenderEndpoint& GetSender(int index) const;
+
+private:
+	HeapBlock<char>			m_buffer;						/**< The buffer the datagrams are read into, DatagramBufferSize per datagram. */
+	size_t					m_sizes[ReceiveBatchSize];		/**< The sizes of the datagrams read with the last call. */
+	SenderEndpoint			m_senders[ReceiveBatchSize];	/**< The sender endpoints of the datagrams read with the last call. */
+
+	JUCE_DECLARE_NON_COPYABLE(DatagramReceiveBatch)
+};
+
+/**
+ * Class DatagramSendBatch sends datagrams to a single target endpoint.
+ * On Linux, datagrams are queued and sent with a single sendmmsg call when the batch is flushed or full.
+ * On other platforms, and for targets that are no numeric IPv4 address, every datagram is written right away.
+ */
+class DatagramSendBatch
+{
+public:
+	enum
+	{
+		SendBatchSize = 64,			/**< Max. number of datagrams queued before the batch is sent. */
+		SendBufferSize = 65536		/**< Max. number of bytes queued before the batch is sent. */
+	};
+
+public:
+	DatagramSendBatch();
+	~DatagramSendBatch();
+
+	void SetTarget(const String& hostName, int portNumber);
+
+	bool Send(DatagramSocket& socket, const char* data, size_t dataSize);
+	bool Flush(DatagramSocket& socket);
+	bool IsEmpty() const;
+
+private:
+	bool Write(DatagramSocket& socket, const char* data, size_t dataSize);
+
+	String			m_targetHostName;					/**< The target host name or ip, used for the unbatched fallback. */
+	int				m_targetPort;						/**< The target port. */
+	SenderEndpoint	m_targetEndpoint;					/**< The numeric target endpoint. Invalid if the target is no IPv4 address. */
+	HeapBlock<char>	m_buffer;							/**< The buffer queued datagrams are copied into. */
+	size_t			m_bufferedSize;						/**< The number of bytes queued in the buffer. */
+	size_t			m_offsets[SendBatchSize];			/**< The buffer offsets of the queued datagrams. */
+	size_t			m_sizes[SendBatchSize];				/**< The sizes of the queued datagrams. */
+	int				m_count;							/**< The number of queued datagrams. */
+
+	JUCE_DECLARE_NON_COPYABLE(DatagramSendBatch)
+};
+
+}
@@ -0,0 +1,260 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "OSCAddressTable.h"
+
+
+namespace
+{
+	/**
+	 * Compile time string length helper.
+	 */
+	constexpr size_t AddressLength(const char* address)
+	{
+		size_t length = 0;
+		while (address[length] != '\0')
+			++length;
+
+		return length;
+	}
+
+	/**
+	 * The known remote object addresses, indexed by RemoteObjectIdentifier.
+	 * New remote objects only have to be added here (in enum order) to be sent and received.
+	 */
+	constexpr OSCAddressTable::Entry Entries[ROI_UserMAX] =
+	{
+		{ ROI_HeartbeatPing,			"/ping",											AddressLength("/ping"),												0, ROVT_NONE,	0 },
+		{ ROI_HeartbeatPong,			"/pong",											AddressLength("/pong"),												0, ROVT_NONE,	0 },
+		{ ROI_Invalid,					"",													0,																	0, ROVT_NONE,	0 },
+		{ ROI_SoundObject_Position_X,	"/dbaudio1/coordinatemapping/source_position_x",	AddressLength("/dbaudio1/coordinatemapping/source_position_x"),		2, ROVT_FLOAT,	1 },
+		{ ROI_SoundObject_Position_Y,	"/dbaudio1/coordinatemapping/source_position_y",	AddressLength("/dbaudio1/coordinatemapping/source_position_y"),		2, ROVT_FLOAT,	1 },
+		{ ROI_SoundObject_Position_XY,	"/dbaudio1/coordinatemapping/source_position_xy",	AddressLength("/dbaudio1/coordinatemapping/source_position_xy"),	2, ROVT_FLOAT,	2 },
+		{ ROI_SoundObject_Spread,		"/dbaudio1/positioning/source_spread",				AddressLength("/dbaudio1/positioning/source_spread"),				1, ROVT_FLOAT,	1 },
+		{ ROI_SoundObject_DelayMode,	"/dbaudio1/positioning/source_delaymode",			AddressLength("/dbaudio1/positioning/source_delaymode"),			1, ROVT_INT,	1 },
+		{ ROI_ReverbSendGain,			"/dbaudio1/matrixinput/reverbsendgain",				AddressLength("/dbaudio1/matrixinput/reverbsendgain"),				1, ROVT_FLOAT,	1 },
+	};
+
+	/**
+	 * Compile time check that the table is indexed by RemoteObjectIdentifier.
+	 */
+	constexpr bool IsIndexedById()
+	{
+		for (int i = 0; i < ROI_UserMAX; ++i)
+			if (Entries[i].Id != i)
+				return false;
+
+		return true;
+	}
+	static_assert(IsIndexedById(), "OSC address table entries must be in RemoteObjectIdentifier order");
+
+	enum HashConstants
+	{
+		HashSlotCount	= 32,	/**< Number of hash slots, must be a power of two. */
+		MaxHashSeed		= 1024	/**< Max. number of seeds tried to find a collision free hash. */
+	};
+
+	/**
+	 * FNV-1a based hash of an address string, varied by the given seed.
+	 */
+	constexpr uint32 HashAddress(const char* address, size_t length, uint32 seed)
+	{
+		uint32 hash = 2166136261u ^ seed;
+		for (size_t i = 0; i < length; ++i)
+		{
+			hash ^= uint8(address[i]);
+			hash *= 16777619u;
+		}
+
+		return (hash ^ (hash >> 15)) & (HashSlotCount - 1);
+	}
+
+	/**
+	 * Compile time search for a seed that maps all known addresses to distinct hash slots.
+	 */
+	constexpr uint32 FindPerfectHashSeed()
+	{
+		for (uint32 seed = 0; seed < MaxHashSeed; ++seed)
+		{
+			bool slotUsed[HashSlotCount] = {};
+			bool collisionFree = true;
+			for (int i = 0; i < ROI_UserMAX && collisionFree; ++i)
+			{
+				if (Entries[i].AddressLength == 0)
+					continue;
+
+				uint32 slot = HashAddress(Entries[i].Address, Entries[i].AddressLength, seed);
+				collisionFree = !slotUsed[slot];
+				slotUsed[slot] = true;
+			}
+
+			if (collisionFree)
+				return seed;
+		}
+
+		return MaxHashSeed;
+	}
+
+	constexpr uint32 HashSeed = FindPerfectHashSeed();
+	static_assert(HashSeed < MaxHashSeed, "No collision free hash found for the OSC address table, HashSlotCount has to be increased");
+
+	/**
+	 * Hash slot to table index mapping.
+	 */
+	struct HashSlots
+	{
+		int8 Index[HashSlotCount];	/**< The table index per hash slot, -1 for unused slots. */
+	};
+
+	constexpr HashSlots BuildHashSlots()
+	{
+		HashSlots slots = {};
+		for (int i = 0; i < HashSlotCount; ++i)
+			slots.Index[i] = -1;
+
+		for (int i = 0; i < ROI_UserMAX; ++i)
+			if (Entries[i].AddressLength > 0)
+				slots.Index[HashAddress(Entries[i].Address, Entries[i].AddressLength, HashSeed)] = int8(i);
+
+		return slots;
+	}
+
+	constexpr HashSlots Slots = BuildHashSlots();
+}
+
+
+// **************************************************************************************
+//    class OSCAddressTable
+// **************************************************************************************
+/**
+ * Getter for the table entry of a given remote object.
+ *
+ * @param id	The remote object id to get the entry for.
+ * @return	The table entry. For ids out of range, the empty ROI_Invalid entry is returned.
+ */
+const OSCAddressTable::Entry& OSCAddressTable::Get(RemoteObjectIdentifier id)
+{
+	if (id < ROI_HeartbeatPing || id >= ROI_UserMAX)
+		return Entries[ROI_Invalid];
+
+	return Entries[id];
+}
+
+/**
+ * Getter for the OSC address string of a given remote object, without addressing values.
+ *
+ * @param id	The remote object id to get the address for.
+ * @return	The zero terminated address string, empty for unknown ids.
+ */
+const char* OSCAddressTable::GetAddress(RemoteObjectIdentifier id)
+{
+	return Get(id).Address;
+}
+
+/**
+ * Method to classify a received OSC address. The addressing values appended to the address
+ * are split off and returned, the remaining address is looked up in the perfect hash table.
+ *
+ * @param address		The address string. Does not need to be zero terminated.
+ * @param addressLength	The length of the address string.
+ * @param addressing	The addressing values that were appended to the address (channel as first, record as second).
+ * @return	The table entry for the address or nullptr if it is not known.
+ */
+const OSCAddressTable::Entry* OSCAddressTable::Lookup(const char* address, size_t addressLength, RemoteObjectAddressing& addressing)
+{
+	addressing.first = INVALID_ADDRESS_VALUE;
+	addressing.second = INVALID_ADDRESS_VALUE;
+
+	// addressing values are appended as '/record/channel' or '/channel'
+	int addressingCount = 0;
+	int16 value;
+	if (SplitAddressingValue(address, addressLength, value))
+	{
+		addressing.first = value;
+		addressingCount++;
+
+		if (SplitAddressingValue(address, addressLength, value))
+		{
+			addressing.second = value;
+			addressingCount++;
+		}
+	}
+
+	int8 index = Slots.Index[HashAddress(address, addressLength, HashSeed)];
+	if (index < 0)
+		return nullptr;
+
+	// the hash is only perfect for known addresses, so the address itself has to be verified
+	const Entry& entry = Entries[index];
+	if (entry.AddressLength != addressLength || memcmp(entry.Address, address, addressLength) != 0)
+		return nullptr;
+
+	// heartbeat objects do not use addressing values at all
+	if (entry.AddressingCount != addressingCount && entry.AddressingCount > 0)
+		return nullptr;
+
+	return &entry;
+}
+
+/**
+ * Helper method to split a trailing '/<number>' addressing value off an address.
+ *
+ * @param address		The address string.
+ * @param addressLength	The length of the address string. Is reduced by the split off part on success.
+ * @param value			The addressing value that was split off.
+ * @return	True if a numeric addressing value was found at the end of the address.
+ */
+bool OSCAddressTable::SplitAddressingValue(const char* address, size_t& addressLength, int16& value)
+{
+	size_t digitPos = addressLength;
+	while (digitPos > 0 && address[digitPos - 1] >= '0' && address[digitPos - 1] <= '9')
+		--digitPos;
+
+	size_t digitCount = addressLength - digitPos;
+	if (digitCount == 0 || digitCount > 5 || digitPos == 0 || address[digitPos - 1] != '/')
+		return false;
+
+	int parsedValue = 0;
+	for (size_t i = digitPos; i < addressLength; ++i)
+		parsedValue = parsedValue * 10 + (address[i] - '0');
+
+	if (parsedValue > std::numeric_limits<int16>::max())
+		return false;
+
+	value = int16(parsedValue);
+	addressLength = digitPos - 1;
+
+	return true;
+}
@@ -0,0 +1,73 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class OSCAddressTable provides the OSC address strings of the known remote objects
+ * and the classification of received addresses.
+ * The table is indexed by RemoteObjectIdentifier and lookups use a perfect hash that is generated
+ * at compile time, so classification is O(address length) independent of the number of known objects
+ * and no String objects are created.
+ */
+class OSCAddressTable
+{
+public:
+	/**
+	 * Description of a known remote object OSC address and the message format it is used with.
+	 */
+	struct Entry
+	{
+		RemoteObjectIdentifier	Id;					/**< The remote object id the address belongs to. */
+		const char*				Address;			/**< The address string, without addressing values. */
+		size_t					AddressLength;		/**< The length of the address string. */
+		int						AddressingCount;	/**< The number of addressing values appended to the address ('/record/channel' or '/channel'). */
+		RemoteObjectValueType	ValType;			/**< The value type the remote object is handled with. */
+		uint16					ValCount;			/**< The number of values the remote object carries. */
+	};
+
+public:
+	static const Entry& Get(RemoteObjectIdentifier id);
+	static const char* GetAddress(RemoteObjectIdentifier id);
+	static const Entry* Lookup(const char* address, size_t addressLength, RemoteObjectAddressing& addressing);
+
+private:
+	static bool SplitAddressingValue(const char* address, size_t& addressLength, int16& value);
+};
@@ -0,0 +1,163 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "OSCBundlePacker.h"
+
+
+// **************************************************************************************
+//    class OSCBundlePacker
+// **************************************************************************************
+/**
+ * Constructor of the OSC bundle packer class.
+ *
+ * @param maxPacketSize	The max. size of an assembled packet.
+ */
+OSCBundlePacker::OSCBundlePacker(int maxPacketSize)
+{
+	m_packetSize = 0;
+	m_maxPacketSize = 0;
+	m_messageCount = 0;
+
+	SetMaxPacketSize(maxPacketSize);
+}
+
+/**
+ * Destructor of the OSC bundle packer class.
+ */
+OSCBundlePacker::~OSCBundlePacker()
+{
+}
+
+/**
+ * Setter for the max. size of an assembled packet. This clears the currently assembled packet.
+ *
+ * @param maxPacketSize	The max. size of an assembled packet. Limited to the range of EBS_MinBundleMTU to EBS_MaxBundleMTU.
+ */
+void OSCBundlePacker::SetMaxPacketSize(int maxPacketSize)
+{
+	m_maxPacketSize = static_cast<size_t>(jlimit(int(EBS_MinBundleMTU), int(EBS_MaxBundleMTU), maxPacketSize));
+	m_packetData.calloc(m_maxPacketSize);
+
+	// '#bundle' string and immediate timetag (1) are the same for every packet
+	memcpy(m_packetData.getData(), "#bundle", 8);
+	m_packetData[15] = 1;
+
+	Clear();
+}
+
+/**
+ * Getter for the max. size of an assembled packet.
+ *
+ * @return	The max. size of an assembled packet.
+ */
+int OSCBundlePacker::GetMaxPacketSize() const
+{
+	return static_cast<int>(m_maxPacketSize);
+}
+
+/**
+ * Method to add an encoded OSC message to the assembled bundle packet.
+ *
+ * @param message		The encoded message data.
+ * @param messageSize	The encoded message data size.
+ * @return	True if the message was added, false if it does not fit into the remaining packet size.
+ */
+bool OSCBundlePacker::AddMessage(const char* message, size_t messageSize)
+{
+	if (m_packetSize + BundleElementSizeSize + messageSize > m_maxPacketSize)
+		return false;
+
+	uint32 elementSize = ByteOrder::swapIfLittleEndian(static_cast<uint32>(messageSize));
+	memcpy(m_packetData + m_packetSize, &elementSize, BundleElementSizeSize);
+	memcpy(m_packetData + m_packetSize + BundleElementSizeSize, message, messageSize);
+
+	m_packetSize += BundleElementSizeSize + messageSize;
+	m_messageCount++;
+
+	return true;
+}
+
+/**
+ * Getter for if the assembled packet does not contain any messages.
+ *
+ * @return	True if no messages were added since last clearing.
+ */
+bool OSCBundlePacker::IsEmpty() const
+{
+	return m_messageCount == 0;
+}
+
+/**
+ * Getter for the number of messages in the assembled packet.
+ *
+ * @return	The number of messages added since last clearing.
+ */
+int OSCBundlePacker::GetMessageCount() const
+{
+	return m_messageCount;
+}
+
+/**
+ * Getter for the assembled packet. A single message is returned as is,
+ * multiple messages are returned as bundle.
+ *
+ * @param packetSize	The size of the assembled packet.
+ * @return	The assembled packet data, nullptr if no messages were added.
+ */
+const char* OSCBundlePacker::GetPacket(size_t& packetSize) const
+{
+	if (m_messageCount == 0)
+	{
+		packetSize = 0;
+		return nullptr;
+	}
+	else if (m_messageCount == 1)
+	{
+		packetSize = m_packetSize - BundleHeaderSize - BundleElementSizeSize;
+		return m_packetData + BundleHeaderSize + BundleElementSizeSize;
+	}
+
+	packetSize = m_packetSize;
+	return m_packetData;
+}
+
+/**
+ * Method to clear the assembled packet.
+ */
+void OSCBundlePacker::Clear()
+{
+	m_packetSize = BundleHeaderSize;
+	m_messageCount = 0;
+}
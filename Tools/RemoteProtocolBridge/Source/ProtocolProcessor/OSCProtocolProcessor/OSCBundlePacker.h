@@ -0,0 +1,75 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class OSCBundlePacker accumulates encoded OSC messages into a '#bundle' packet
+ * that does not exceed a configured max. packet size (mtu).
+ * A packet holding only a single message is provided as the plain message, without bundle framing.
+ */
+class OSCBundlePacker
+{
+public:
+	enum
+	{
+		BundleHeaderSize = 16,		/**< Size of the '#bundle' string and timetag at the beginning of a bundle. */
+		BundleElementSizeSize = 4	/**< Size of the size field preceding every bundle element. */
+	};
+
+public:
+	OSCBundlePacker(int maxPacketSize = EBS_DefaultBundleMTU);
+	~OSCBundlePacker();
+
+	void SetMaxPacketSize(int maxPacketSize);
+	int GetMaxPacketSize() const;
+
+	bool AddMessage(const char* message, size_t messageSize);
+	bool IsEmpty() const;
+	int GetMessageCount() const;
+	const char* GetPacket(size_t& packetSize) const;
+	void Clear();
+
+private:
+	HeapBlock<char>	m_packetData;		/**< Buffer the bundle packet is assembled in. */
+	size_t			m_packetSize;		/**< The current size of the assembled bundle packet, incl. header. */
+	size_t			m_maxPacketSize;	/**< The max. size of an assembled bundle packet. */
+	int				m_messageCount;		/**< The number of messages in the assembled bundle packet. */
+};
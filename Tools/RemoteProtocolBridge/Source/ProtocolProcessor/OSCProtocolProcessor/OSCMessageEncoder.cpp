@@ -0,0 +1,238 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "OSCMessageEncoder.h"
+#include "OSCAddressTable.h"
+
+
+// **************************************************************************************
+//    class OSCMessageEncoder
+// **************************************************************************************
+/**
+ * Constructor of the OSC message encoder class.
+ */
+OSCMessageEncoder::OSCMessageEncoder()
+{
+}
+
+/**
+ * Destructor of the OSC message encoder class.
+ */
+OSCMessageEncoder::~OSCMessageEncoder()
+{
+}
+
+/**
+ * Method to encode a remote object message into an OSC datagram.
+ * Messages with values are encoded with the value count given in msgData (int or float arguments),
+ * messages without values are encoded with an empty type tag string, e.g. to poll a value.
+ *
+ * @param Id			The remote object id of the message.
+ * @param msgData		The message payload and metadata.
+ * @param buffer		The buffer to encode the message into.
+ * @param bufferSize	The size of the buffer.
+ * @return	The size of the encoded message, 0 if the message could not be encoded.
+ */
+size_t OSCMessageEncoder::EncodeMessage(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, char* buffer, size_t bufferSize)
+{
+	if (Id >= ROI_UserMAX || msgData.valType == ROVT_STRING || msgData.valCount > MAX_REMOTE_OBJECT_VALUE_COUNT)
+	{
+		jassertfalse; // String not (yet?) supported, max known d&b OSC msg val cnt would be positioning xyz
+		return 0;
+	}
+
+	int valCount = (msgData.valType == ROVT_NONE) ? 0 : msgData.valCount;
+	if (valCount > 0 && (msgData.payload == nullptr || msgData.payloadSize < valCount * sizeof(uint32)))
+	{
+		jassertfalse;
+		return 0;
+	}
+
+	const EncodedPrefix* prefix = GetPrefix(Id, msgData);
+	if (prefix == nullptr)
+		return 0;
+
+	size_t messageSize = prefix->Size + valCount * sizeof(uint32);
+	if (messageSize > bufferSize)
+		return 0;
+
+	memcpy(buffer, prefix->Data, prefix->Size);
+
+	// int and float values are both 32bit and only need conversion to network byte order
+	const uint32* values = static_cast<const uint32*>(msgData.payload);
+	char* writePos = buffer + prefix->Size;
+	for (int i = 0; i < valCount; ++i)
+	{
+		uint32 value = ByteOrder::swapIfLittleEndian(values[i]);
+		memcpy(writePos, &value, sizeof(uint32));
+		writePos += sizeof(uint32);
+	}
+
+	return messageSize;
+}
+
+/**
+ * Method to clear all cached prefixes.
+ */
+void OSCMessageEncoder::ClearCache()
+{
+	m_prefixCache.clear();
+}
+
+/**
+ * Helper method to get the key the prefix of a message is cached with.
+ *
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message metadata.
+ * @return	The cache key.
+ */
+uint64 OSCMessageEncoder::GetPrefixKey(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	int valCount = (msgData.valType == ROVT_NONE) ? 0 : msgData.valCount;
+
+	return (uint64(uint16(Id)) << 48)
+		| (uint64(uint16(msgData.addrVal.first)) << 32)
+		| (uint64(uint16(msgData.addrVal.second)) << 16)
+		| (uint64(uint8(msgData.valType)) << 8)
+		| uint64(uint8(valCount));
+}
+
+/**
+ * Helper method to get the encoded prefix of a message, either from cache or newly rendered.
+ *
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message metadata.
+ * @return	The encoded prefix, nullptr if it could not be rendered.
+ */
+const OSCMessageEncoder::EncodedPrefix* OSCMessageEncoder::GetPrefix(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	uint64 key = GetPrefixKey(Id, msgData);
+
+	auto cachedPrefix = m_prefixCache.find(key);
+	if (cachedPrefix != m_prefixCache.end())
+		return &cachedPrefix->second;
+
+	EncodedPrefix* prefix = &m_uncachedPrefix;
+	if (m_prefixCache.size() < MaxCachedPrefixes)
+		prefix = &m_prefixCache[key];
+
+	if (!RenderPrefix(Id, msgData, *prefix))
+	{
+		m_prefixCache.erase(key);
+		return nullptr;
+	}
+
+	return prefix;
+}
+
+/**
+ * Helper method to render the 4-byte padded OSC address and type tag string of a message.
+ * The address is the remote object address, followed by the record and channel addressing values, if valid.
+ *
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message metadata.
+ * @param prefix	The prefix to render into.
+ * @return	True on success, false if the prefix does not fit into the prefix storage.
+ */
+bool OSCMessageEncoder::RenderPrefix(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, EncodedPrefix& prefix)
+{
+	int valCount = (msgData.valType == ROVT_NONE) ? 0 : msgData.valCount;
+	const OSCAddressTable::Entry& entry = OSCAddressTable::Get(Id);
+
+	// address incl. addressing values (max. 7 chars each) and null termination padding
+	if (entry.AddressLength + 2 * 7 + 4 > MaxPrefixSize)
+	{
+		jassertfalse;
+		return false;
+	}
+
+	memset(prefix.Data, 0, MaxPrefixSize);
+
+	size_t writePos = entry.AddressLength;
+	memcpy(prefix.Data, entry.Address, entry.AddressLength);
+
+	if (msgData.addrVal.second != INVALID_ADDRESS_VALUE)
+		writePos += AppendAddressingValue(prefix.Data + writePos, msgData.addrVal.second);
+	if (msgData.addrVal.first != INVALID_ADDRESS_VALUE)
+		writePos += AppendAddressingValue(prefix.Data + writePos, msgData.addrVal.first);
+
+	// null terminated and padded to 4 bytes
+	writePos = (writePos + 4) & ~size_t(3);
+
+	// type tag string ',' + one tag per value, null terminated and padded to 4 bytes
+	if (writePos + valCount + 2 + 3 > MaxPrefixSize)
+	{
+		jassertfalse;
+		return false;
+	}
+
+	prefix.Data[writePos++] = ',';
+	for (int i = 0; i < valCount; ++i)
+		prefix.Data[writePos++] = (msgData.valType == ROVT_INT) ? 'i' : 'f';
+	writePos = (writePos + 4) & ~size_t(3);
+
+	prefix.Size = static_cast<uint16>(writePos);
+
+	return true;
+}
+
+/**
+ * Helper method to append a '/' separated decimal addressing value to an address.
+ *
+ * @param buffer	The buffer to write to.
+ * @param value		The addressing value to write.
+ * @return	The number of chars written.
+ */
+size_t OSCMessageEncoder::AppendAddressingValue(char* buffer, int16 value)
+{
+	char digits[6];
+	int digitCount = 0;
+	int absValue = (value < 0) ? -int(value) : int(value);
+
+	do
+	{
+		digits[digitCount++] = static_cast<char>('0' + (absValue % 10));
+		absValue /= 10;
+	} while (absValue > 0);
+
+	size_t writePos = 0;
+	buffer[writePos++] = '/';
+	if (value < 0)
+		buffer[writePos++] = '-';
+	while (digitCount > 0)
+		buffer[writePos++] = digits[--digitCount];
+
+	return writePos;
+}
@@ -0,0 +1,87 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+#include <unordered_map>
+
+
+/**
+ * Class OSCMessageEncoder serializes remote object messages into OSC datagrams.
+ * The address and type tag part of a message only depends on the remote object, its addressing
+ * and value format. It is rendered once and cached, so encoding a message is a copy
+ * of the cached prefix followed by the big-endian argument values.
+ */
+class OSCMessageEncoder
+{
+public:
+	enum
+	{
+		MaxPrefixSize = 128,															/**< Max. size of an encoded, padded address and type tag prefix. */
+		MaxMessageSize = MaxPrefixSize + MAX_REMOTE_OBJECT_VALUE_COUNT * sizeof(uint32),	/**< Max. size of an encoded message. */
+		MaxCachedPrefixes = 8192														/**< Max. number of cached prefixes. Prefixes beyond are rendered on every use. */
+	};
+
+public:
+	OSCMessageEncoder();
+	~OSCMessageEncoder();
+
+	size_t EncodeMessage(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, char* buffer, size_t bufferSize);
+	void ClearCache();
+
+private:
+	/**
+	 * Encoded, 4-byte padded OSC address and type tag string.
+	 */
+	struct EncodedPrefix
+	{
+		char	Data[MaxPrefixSize];	/**< The encoded prefix data. */
+		uint16	Size;					/**< The size of the encoded prefix data. */
+	};
+
+	static uint64 GetPrefixKey(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	static bool RenderPrefix(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, EncodedPrefix& prefix);
+	static size_t AppendAddressingValue(char* buffer, int16 value);
+
+	const EncodedPrefix* GetPrefix(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+
+private:
+	std::unordered_map<uint64, EncodedPrefix>	m_prefixCache;		/**< The cached prefixes, keyed by remote object, addressing and value format. */
+	EncodedPrefix								m_uncachedPrefix;	/**< Prefix storage used when the cache is full. */
+};
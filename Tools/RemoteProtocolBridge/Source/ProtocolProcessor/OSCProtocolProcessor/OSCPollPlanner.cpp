@@ -0,0 +1,256 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#include "OSCPollPlanner.h"
+
+
+// **************************************************************************************
+//    class OSCPollPlanner
+// **************************************************************************************
+/**
+ * The composite objects a single poll can answer several active objects with.
+ */
+const OSCPollPlanner::CompositeObject OSCPollPlanner::s_compositeObjects[] =
+{
+	{ ROI_SoundObject_Position_XY, { ROI_SoundObject_Position_X, ROI_SoundObject_Position_Y }, 2 },
+};
+
+/**
+ * Constructor
+ */
+OSCPollPlanner::OSCPollPlanner()
+{
+}
+
+/**
+ * Destructor
+ */
+OSCPollPlanner::~OSCPollPlanner()
+{
+}
+
+/**
+ * Method to compute the minimal set of poll queries for the given active objects.
+ * A part of a composite object is covered by a poll of the composite object, if the composite object
+ * is active for the same addressing or if all its parts are. Duplicate objects are only polled once.
+ * Covered parts keep the position of their first occurrence in the poll order.
+ * Every polled object gets its own polling interval per addressing. A composite object polled in place of its parts
+ * is polled at the shortest polling interval of itself and its parts at the same addressing, each being the individual
+ * interval of the object, or the default interval if it has none. So none of the active objects is polled less often
+ * than configured, and objects at other addressings are not affected.
+ *
+ * @param objects			The active remote objects.
+ * @param defaultInterval	The polling interval in ms of the objects without an individual polling interval.
+ * @param tiers				The individual polling intervals in ms per remote object id.
+ */
+void OSCPollPlanner::Plan(const Array<RemoteObject>& objects, int defaultInterval, const std::map<RemoteObjectIdentifier, int>& tiers)
+{
+	Clear();
+
+	std::unordered_map<uint64, bool> activeKeys;
+	activeKeys.reserve(static_cast<size_t>(objects.size()));
+	for (const RemoteObject& obj : objects)
+		activeKeys[GetRemoteObjectKey(obj.Id, obj.Addr)] = true;
+
+	m_pollIndices.reserve(static_cast<size_t>(objects.size()));
+	m_pollObjects.ensureStorageAllocated(objects.size());
+	m_pollIntervals.ensureStorageAllocated(objects.size());
+
+	for (const RemoteObject& obj : objects)
+	{
+		RemoteObject pollObj = obj;
+		int interval = GetTierInterval(tiers, obj.Id, defaultInterval);
+
+		int partIndex = 0;
+		const CompositeObject* composite = FindCompositeOfPart(obj.Id, partIndex);
+		if (composite != nullptr)
+		{
+			bool compositeActive = activeKeys.count(GetRemoteObjectKey(composite->Composite, obj.Addr)) > 0;
+			bool allPartsActive = true;
+			for (int i = 0; i < composite->PartCount; ++i)
+				allPartsActive = allPartsActive && activeKeys.count(GetRemoteObjectKey(composite->Parts[i], obj.Addr)) > 0;
+
+			if (compositeActive || allPartsActive)
+			{
+				Derivation& derivation = m_derivations[GetRemoteObjectKey(composite->Composite, obj.Addr)];
+				derivation.PartMask |= (1u << partIndex);
+				derivation.ForwardComposite = compositeActive;
+
+				interval = jmin(interval, GetTierInterval(tiers, composite->Composite, defaultInterval));
+				pollObj.Id = composite->Composite;
+			}
+		}
+
+		// an object that is already polled is polled at the shortest interval of all objects it answers
+		uint64 key = GetRemoteObjectKey(pollObj.Id, pollObj.Addr);
+		auto pollIndex = m_pollIndices.find(key);
+		if (pollIndex != m_pollIndices.end())
+		{
+			m_pollIntervals.set(pollIndex->second, jmin(m_pollIntervals[pollIndex->second], interval));
+			continue;
+		}
+
+		m_pollIndices[key] = m_pollObjects.size();
+		m_pollObjects.add(pollObj);
+		m_pollIntervals.add(interval);
+	}
+}
+
+/**
+ * Method to clear the planned poll queries and derivations.
+ */
+void OSCPollPlanner::Clear()
+{
+	m_pollObjects.clear();
+	m_pollIntervals.clear();
+	m_pollIndices.clear();
+	m_derivations.clear();
+}
+
+/**
+ * Getter for the minimal set of objects to be polled.
+ *
+ * @return	The objects to be polled.
+ */
+const Array<RemoteObject>& OSCPollPlanner::GetPollObjects() const
+{
+	return m_pollObjects;
+}
+
+/**
+ * Getter for the polling intervals of the objects to be polled.
+ *
+ * @return	The polling intervals in ms, in order of the objects to be polled.
+ */
+const Array<int>& OSCPollPlanner::GetPollIntervals() const
+{
+	return m_pollIntervals;
+}
+
+/**
+ * Getter for the object that is polled to answer the given object.
+ *
+ * @param Id		The remote object id.
+ * @param addrVal	The remote object addressing.
+ * @return	The id of the composite object that is polled in place of the given object, or the given id if it is polled itself.
+ */
+RemoteObjectIdentifier OSCPollPlanner::GetPolledId(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal) const
+{
+	int partIndex = 0;
+	const CompositeObject* composite = FindCompositeOfPart(Id, partIndex);
+	if (composite == nullptr)
+		return Id;
+
+	auto derivation = m_derivations.find(GetRemoteObjectKey(composite->Composite, addrVal));
+	if (derivation == m_derivations.end() || (derivation->second.PartMask & (1u << partIndex)) == 0)
+		return Id;
+
+	return composite->Composite;
+}
+
+/**
+ * Getter for the objects to derive from a received value.
+ *
+ * @param Id		The remote object id of the received value.
+ * @param addrVal	The remote object addressing of the received value.
+ * @return	The derivation of the received value. Values that nothing is derived from are only forwarded themselves.
+ */
+OSCPollPlanner::Derivation OSCPollPlanner::GetDerivation(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal) const
+{
+	auto derivation = m_derivations.find(GetRemoteObjectKey(Id, addrVal));
+	if (derivation == m_derivations.end())
+		return Derivation{ 0, true };
+
+	return derivation->second;
+}
+
+/**
+ * Helper method to look up the definition of a composite object.
+ *
+ * @param Id	The remote object id of the composite object.
+ * @return	The composite object definition, or nullptr if the object is no composite object.
+ */
+const OSCPollPlanner::CompositeObject* OSCPollPlanner::FindComposite(RemoteObjectIdentifier Id)
+{
+	for (const auto& composite : s_compositeObjects)
+	{
+		if (composite.Composite == Id)
+			return &composite;
+	}
+
+	return nullptr;
+}
+
+/**
+ * Helper method to look up the definition of the composite object the given object is a part of.
+ *
+ * @param Id			The remote object id of the part.
+ * @param partIndex		Reference to return the index of the part in the composite object definition in.
+ * @return	The composite object definition, or nullptr if the object is no part of a composite object.
+ */
+const OSCPollPlanner::CompositeObject* OSCPollPlanner::FindCompositeOfPart(RemoteObjectIdentifier Id, int& partIndex)
+{
+	for (const auto& composite : s_compositeObjects)
+	{
+		for (int i = 0; i < composite.PartCount; ++i)
+		{
+			if (composite.Parts[i] == Id)
+			{
+				partIndex = i;
+				return &composite;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * Helper method to get the polling interval of an object.
+ *
+ * @param tiers				The individual polling intervals in ms per remote object id.
+ * @param Id				The remote object id.
+ * @param defaultInterval	The polling interval in ms of objects without an individual polling interval.
+ * @return	The individual polling interval of the object, or the default interval if it has none.
+ */
+int OSCPollPlanner::GetTierInterval(const std::map<RemoteObjectIdentifier, int>& tiers, RemoteObjectIdentifier Id, int defaultInterval)
+{
+	auto tier = tiers.find(Id);
+	if (tier == tiers.end())
+		return defaultInterval;
+
+	return tier->second;
+}
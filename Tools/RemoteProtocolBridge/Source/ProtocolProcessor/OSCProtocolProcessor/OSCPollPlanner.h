@@ -0,0 +1,137 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <unordered_map>
+
+
+/**
+ * Class OSCPollPlanner reduces the active remote objects of a protocol to the minimal set of poll queries.
+ * Objects that are part of a composite object (e.g. x and y position as part of the xy position) are not
+ * polled individually, if the composite object is active for the same addressing anyway, or if several parts
+ * of it are active and a single poll of the composite object answers all of them.
+ * The values of the parts are derived from the received composite value instead, so the parent node
+ * still receives the values of every active object.
+ */
+class OSCPollPlanner
+{
+public:
+	/**
+	 * Objects to be derived from a received composite value.
+	 */
+	struct Derivation
+	{
+		uint32	PartMask;			/**< Bitmask of the parts of the composite object to derive, by their index in the composite definition. */
+		bool	ForwardComposite;	/**< Indication if the composite value itself is to be forwarded, since the composite object is active. */
+	};
+
+public:
+	OSCPollPlanner();
+	~OSCPollPlanner();
+
+	void Plan(const Array<RemoteObject>& objects, int defaultInterval, const std::map<RemoteObjectIdentifier, int>& tiers);
+	void Clear();
+
+	const Array<RemoteObject>& GetPollObjects() const;
+	const Array<int>& GetPollIntervals() const;
+	RemoteObjectIdentifier GetPolledId(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal) const;
+	Derivation GetDerivation(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal) const;
+
+	/**
+	 * Method to invoke the given callable for the received value and every value derived from it.
+	 * A composite value that was only polled to derive its parts from is not passed on itself.
+	 *
+	 * @param Id			The remote object id of the received value.
+	 * @param msgData		The received message data.
+	 * @param derivation	The derivation of the received value, as returned by GetDerivation.
+	 * @param forward		The callable to be invoked with the RemoteObjectIdentifier and RemoteObjectMessageData of every value to pass on.
+	 */
+	template <typename Callback>
+	static void ForwardReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, const Derivation& derivation, Callback&& forward)
+	{
+		if (derivation.ForwardComposite)
+			forward(Id, msgData);
+
+		const CompositeObject* composite = FindComposite(Id);
+		if (derivation.PartMask == 0 || composite == nullptr || msgData.valType != ROVT_FLOAT || msgData.payload == nullptr)
+			return;
+
+		const float* values = static_cast<const float*>(msgData.payload);
+		for (int i = 0; i < composite->PartCount; ++i)
+		{
+			if ((derivation.PartMask & (1u << i)) == 0 || i >= msgData.valCount)
+				continue;
+
+			float value = values[i];
+			RemoteObjectMessageData partMsgData = msgData;
+			partMsgData.valCount = 1;
+			partMsgData.payload = &value;
+			partMsgData.payloadSize = sizeof(float);
+
+			forward(composite->Parts[i], partMsgData);
+		}
+	}
+
+private:
+	/**
+	 * Definition of a composite object, whose value consists of the values of its parts in order.
+	 */
+	struct CompositeObject
+	{
+		RemoteObjectIdentifier	Composite;	/**< The remote object id of the composite object. */
+		RemoteObjectIdentifier	Parts[2];	/**< The remote object ids of the parts, in order of their value in the composite value. */
+		int						PartCount;	/**< The number of parts of the composite object. */
+	};
+
+	static const CompositeObject* FindComposite(RemoteObjectIdentifier Id);
+	static const CompositeObject* FindCompositeOfPart(RemoteObjectIdentifier Id, int& partIndex);
+	static int GetTierInterval(const std::map<RemoteObjectIdentifier, int>& tiers, RemoteObjectIdentifier Id, int defaultInterval);
+
+	static const CompositeObject			s_compositeObjects[];	/**< The composite objects a single poll can answer several active objects with. */
+
+	Array<RemoteObject>						m_pollObjects;	/**< The minimal set of objects to be polled. */
+	Array<int>								m_pollIntervals;	/**< The polling intervals in ms of the polled objects, in order of m_pollObjects. Incl. the ones of the parts a composite poll answers. */
+	std::unordered_map<uint64, int>			m_pollIndices;	/**< The index in m_pollObjects per polled object id and addressing. */
+	std::unordered_map<uint64, Derivation>	m_derivations;	/**< The objects to derive from the received composite values, by composite object id and addressing. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCPollPlanner)
+};
@@ -0,0 +1,458 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#include "OSCPollingScheduler.h"
+
+#include "../../ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class OSCPollingScheduler
+// **************************************************************************************
+/**
+ * Constructor
+ */
+OSCPollingScheduler::OSCPollingScheduler()
+{
+	m_nextDeadline = std::numeric_limits<double>::max();
+	m_pollSetTime = 0;
+	m_minInterval = ET_DefaultPollingRate;
+	m_adaptiveMaxInterval = ET_DefaultAdaptivePollingMaxInterval;
+
+	ResetResponseTracking();
+}
+
+/**
+ * Destructor
+ */
+OSCPollingScheduler::~OSCPollingScheduler()
+{
+}
+
+/**
+ * Method to set the objects to be polled. The poll messages of all objects are encoded once here,
+ * to only have to be copied to the socket when they are due.
+ * Objects are grouped by their polling interval and the first deadlines within every group are
+ * spread evenly across the interval, starting from the current time.
+ *
+ * @param objects			The remote objects to be polled.
+ * @param intervals			The polling intervals in ms of the objects, in order of the objects.
+ * @param encoder			The encoder to use to encode the poll messages.
+ */
+void OSCPollingScheduler::SetPollSet(const Array<RemoteObject>& objects, const Array<int>& intervals, OSCMessageEncoder& encoder)
+{
+	Clear();
+
+	m_entries.reserve(static_cast<size_t>(objects.size()));
+	m_entryIndices.reserve(static_cast<size_t>(objects.size()));
+	m_messages.setSize(static_cast<size_t>(objects.size()) * OSCMessageEncoder::MaxMessageSize);
+
+	RemoteObjectMessageData msgData;
+	msgData.valCount = 0;
+	msgData.valType = ROVT_NONE;
+	msgData.payload = 0;
+	msgData.payloadSize = 0;
+
+	// count the objects per interval first, to know how far apart their deadlines have to be
+	jassert(intervals.size() == objects.size());
+	std::map<int, int> objectsPerInterval;
+	for (int i = 0; i < objects.size(); ++i)
+		objectsPerInterval[jmax(1, intervals[i])]++;
+
+	std::map<int, int> scheduledPerInterval;
+	double now = Time::getMillisecondCounterHiRes();
+	m_pollSetTime = now;
+	size_t messagesSize = 0;
+	char* messages = static_cast<char*>(m_messages.getData());
+	for (int i = 0; i < objects.size(); ++i)
+	{
+		msgData.addrVal = objects[i].Addr;
+
+		size_t messageSize = encoder.EncodeMessage(objects[i].Id, msgData, messages + messagesSize, OSCMessageEncoder::MaxMessageSize);
+		if (messageSize == 0)
+			continue;
+
+		int interval = jmax(1, intervals[i]);
+		int slotIndex = scheduledPerInterval[interval]++;
+
+		PollEntry entry;
+		entry.Object = objects[i];
+		entry.BaseInterval = interval;
+		entry.Interval = interval;
+		entry.StaggerOffset = (double(slotIndex) * interval) / objectsPerInterval[interval];
+		entry.Deadline = now + entry.StaggerOffset;
+		entry.MessageOffset = messagesSize;
+		entry.MessageSize = messageSize;
+		entry.InFlight = false;
+		entry.SentTime = 0;
+		entry.PollCount = 0;
+		entry.ResponseCount = 0;
+		entry.LostCount = 0;
+		entry.RoundTripTime = 0;
+		entry.LastRoundTripTime = 0;
+		entry.HasValue = false;
+		m_entryIndices[GetRemoteObjectKey(entry.Object.Id, entry.Object.Addr)] = static_cast<int>(m_entries.size());
+		m_entries.push_back(entry);
+
+		messagesSize += messageSize;
+		m_nextDeadline = jmin(m_nextDeadline, entry.Deadline);
+		m_minInterval = jmin(m_minInterval, interval);
+	}
+
+	m_messages.setSize(messagesSize);
+}
+
+/**
+ * Method to remove all objects from polling.
+ */
+void OSCPollingScheduler::Clear()
+{
+	m_entries.clear();
+	m_entryIndices.clear();
+	m_messages.reset();
+	m_nextDeadline = std::numeric_limits<double>::max();
+	m_minInterval = ET_DefaultPollingRate;
+
+	ResetResponseTracking();
+}
+
+/**
+ * Method to forget about all polls in flight and to consider the device responsive again,
+ * e.g. when the processor is (re-)started.
+ */
+void OSCPollingScheduler::ResetResponseTracking()
+{
+	for (PollEntry& entry : m_entries)
+		entry.InFlight = false;
+
+	m_firstUnansweredTime = -1;
+	m_deviceResponsive = true;
+	m_probeInterval = ET_PollResponseTimeout;
+	m_nextProbeTime = 0;
+	m_probeIndex = 0;
+	m_lastProbeIndex = -1;
+}
+
+/**
+ * Setter for the max. interval adaptive polling backs off to.
+ * Disabling adaptive polling returns all objects to their configured interval.
+ *
+ * @param maxInterval	The max. polling interval in ms for objects whose value does not change. 0 to disable adaptive polling.
+ */
+void OSCPollingScheduler::SetAdaptiveMaxInterval(int maxInterval)
+{
+	m_adaptiveMaxInterval = jmax(0, maxInterval);
+
+	if (m_adaptiveMaxInterval == 0)
+	{
+		double now = Time::getMillisecondCounterHiRes();
+		for (PollEntry& entry : m_entries)
+			ResetInterval(entry, now);
+	}
+}
+
+/**
+ * Method to be called with every value received from the device, to match it with the poll in flight
+ * for the object and to adapt the polling interval of the object.
+ * A value that differs from the previously received one (compared with the given precision) returns
+ * the object to its configured interval. An unchanged value doubles the interval, up to the adaptive max. interval.
+ * Any received value shows that the device is responsive, so polling resumes if it was backed off.
+ *
+ * @param Id			The remote object id of the received value.
+ * @param msgData		The received message data.
+ * @param precision		The precision to compare float values with.
+ * @param now			The current time, in ms.
+ * @return	True if the received value belongs to a polled object, false if not.
+ */
+bool OSCPollingScheduler::OnValueReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, float precision, double now)
+{
+	m_firstUnansweredTime = -1;
+	if (!m_deviceResponsive)
+	{
+		// resume regular polling with the initial staggering
+		m_deviceResponsive = true;
+		m_probeInterval = ET_PollResponseTimeout;
+		for (PollEntry& entry : m_entries)
+		{
+			entry.Deadline = now + entry.StaggerOffset;
+			m_nextDeadline = jmin(m_nextDeadline, entry.Deadline);
+		}
+	}
+
+	PollEntry* entry = FindEntry(Id, msgData.addrVal);
+	if (entry == nullptr)
+		return false;
+
+	if (entry->InFlight)
+	{
+		// smooth the round trip time like tcp does (rfc 6298)
+		entry->LastRoundTripTime = now - entry->SentTime;
+		if (entry->ResponseCount == 0)
+			entry->RoundTripTime = entry->LastRoundTripTime;
+		else
+			entry->RoundTripTime += (entry->LastRoundTripTime - entry->RoundTripTime) / 8;
+
+		entry->InFlight = false;
+		++entry->ResponseCount;
+	}
+
+	if (msgData.valCount == 0)
+		return true;
+
+	bool isChangedValue = !entry->HasValue
+		|| ProcessingEngineConfig::IsChangedValue(entry->LastValue.valType, entry->LastValue.valCount, &entry->LastValue.values, msgData, precision);
+
+	if (isChangedValue)
+	{
+		entry->HasValue = entry->LastValue.Set(0, Id, msgData);
+		ResetInterval(*entry, now);
+	}
+	else if (m_adaptiveMaxInterval > 0)
+	{
+		// back off exponentially, the pending deadline is moved along with the interval
+		double interval = jmin(entry->Interval * 2, jmax(entry->BaseInterval, double(m_adaptiveMaxInterval)));
+		entry->Deadline += interval - entry->Interval;
+		entry->Interval = interval;
+	}
+
+	return true;
+}
+
+/**
+ * Method to be called with every value that is sent to a remote object, e.g. when a client writes to it.
+ * Since the value is going to change, the object is returned to its configured polling interval.
+ *
+ * @param Id		The remote object id of the sent value.
+ * @param addrVal	The remote object addressing of the sent value.
+ * @param now		The current time, in ms.
+ */
+void OSCPollingScheduler::OnValueSent(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal, double now)
+{
+	if (PollEntry* entry = FindEntry(Id, addrVal))
+		ResetInterval(*entry, now);
+}
+
+/**
+ * Getter for the flag if there are no objects to be polled.
+ *
+ * @return	True if no objects are polled.
+ */
+bool OSCPollingScheduler::IsEmpty() const
+{
+	return m_entries.empty();
+}
+
+/**
+ * Getter for the flag if the device answers polls.
+ *
+ * @return	True if the device answered polls lately, false if polling is backed off to probing it.
+ */
+bool OSCPollingScheduler::IsDeviceResponsive() const
+{
+	return m_deviceResponsive;
+}
+
+/**
+ * Getter for the polling statistics of all polled objects, e.g. to verify the savings of adaptive polling
+ * or to monitor the round trip times and losses of the polls.
+ *
+ * @param now	The current time, in ms.
+ * @return	The polling rates, response counts and round trip times per polled object.
+ */
+Array<OSCPollingScheduler::PollStatistics> OSCPollingScheduler::GetPollStatistics(double now) const
+{
+	Array<PollStatistics> statistics;
+	statistics.ensureStorageAllocated(static_cast<int>(m_entries.size()));
+
+	double elapsedSeconds = (now - m_pollSetTime) / 1000.0;
+	for (const PollEntry& entry : m_entries)
+	{
+		PollStatistics stats;
+		stats.Object = entry.Object;
+		stats.CurrentRate = 1000.0 / entry.Interval;
+		stats.AverageRate = elapsedSeconds > 0 ? entry.PollCount / elapsedSeconds : 0;
+		stats.PollCount = entry.PollCount;
+		stats.ResponseCount = entry.ResponseCount;
+		stats.LostCount = entry.LostCount;
+		stats.RoundTripTime = entry.RoundTripTime;
+		stats.LastRoundTripTime = entry.LastRoundTripTime;
+		statistics.add(stats);
+	}
+
+	return statistics;
+}
+
+/**
+ * Getter for the interval the scheduler has to be checked for due poll messages in.
+ * This is the polling slot interval, or the shortest polling interval if that is even shorter.
+ *
+ * @return	The interval to call ProcessDue in, in ms.
+ */
+int OSCPollingScheduler::GetSlotInterval() const
+{
+	return jlimit(1, int(ET_PollingSlotInterval), m_minInterval);
+}
+
+/**
+ * Helper method to look up the entry of a polled object.
+ *
+ * @param Id		The remote object id.
+ * @param addrVal	The remote object addressing.
+ * @return	The pointer to the entry, or nullptr if the object is not polled.
+ */
+OSCPollingScheduler::PollEntry* OSCPollingScheduler::FindEntry(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal)
+{
+	auto index = m_entryIndices.find(GetRemoteObjectKey(Id, addrVal));
+	if (index == m_entryIndices.end())
+		return nullptr;
+
+	return &m_entries[static_cast<size_t>(index->second)];
+}
+
+/**
+ * Helper method to return an object to its configured polling interval.
+ * If the object is not due within that interval, it is polled at the latest one interval from now.
+ *
+ * @param entry		The entry of the object.
+ * @param now		The current time, in ms.
+ */
+void OSCPollingScheduler::ResetInterval(PollEntry& entry, double now)
+{
+	if (entry.Interval == entry.BaseInterval)
+		return;
+
+	entry.Interval = entry.BaseInterval;
+	entry.Deadline = jmin(entry.Deadline, now + entry.BaseInterval);
+	m_nextDeadline = jmin(m_nextDeadline, entry.Deadline);
+}
+
+/**
+ * Helper method to check if the previous poll of an object is still awaiting its response.
+ * A poll that was not answered within the response timeout is counted as lost.
+ *
+ * @param entry		The entry of the object.
+ * @param now		The current time, in ms.
+ * @return	True if the object must not be polled again yet.
+ */
+bool OSCPollingScheduler::IsAwaitingResponse(PollEntry& entry, double now)
+{
+	if (!entry.InFlight)
+		return false;
+
+	if (now - entry.SentTime < ET_PollResponseTimeout)
+		return true;
+
+	entry.InFlight = false;
+	++entry.LostCount;
+
+	return false;
+}
+
+/**
+ * Helper method to track a poll that was sent for an object as in flight.
+ *
+ * @param entry		The entry of the object.
+ * @param now		The current time, in ms.
+ */
+void OSCPollingScheduler::OnPollSent(PollEntry& entry, double now)
+{
+	entry.InFlight = true;
+	entry.SentTime = now;
+	++entry.PollCount;
+
+	if (m_firstUnansweredTime < 0)
+		m_firstUnansweredTime = now;
+}
+
+/**
+ * Helper method to detect that the device stopped answering polls, i.e. no value was received
+ * within the response timeout after sending a poll. All polls in flight then count as lost
+ * and polling backs off to probing the device.
+ *
+ * @param now		The current time, in ms.
+ * @return	True if the device is responsive, false if it is to be probed only.
+ */
+bool OSCPollingScheduler::UpdateDeviceState(double now)
+{
+	if (m_deviceResponsive && m_firstUnansweredTime >= 0 && now - m_firstUnansweredTime >= ET_PollResponseTimeout)
+	{
+		m_deviceResponsive = false;
+		m_probeInterval = ET_PollResponseTimeout;
+		m_nextProbeTime = now;
+		m_lastProbeIndex = -1;
+
+		for (PollEntry& entry : m_entries)
+		{
+			if (entry.InFlight)
+			{
+				entry.InFlight = false;
+				++entry.LostCount;
+			}
+		}
+
+#ifdef DEBUG
+		DBG("OSC polling: device does not respond, backing off");
+#endif
+	}
+
+	return m_deviceResponsive;
+}
+
+/**
+ * Helper method to get the entry to send the next probe poll for to an unresponsive device, if one is due.
+ * The probed objects are cycled through and the probe interval doubles with every probe, up to a max. interval.
+ *
+ * @param now		The current time, in ms.
+ * @return	The entry to send a probe poll for, or nullptr if no probe is due.
+ */
+OSCPollingScheduler::PollEntry* OSCPollingScheduler::TakeDueProbe(double now)
+{
+	if (m_entries.empty() || now < m_nextProbeTime)
+		return nullptr;
+
+	// the previous probe was not answered either
+	if (m_lastProbeIndex >= 0 && m_entries[static_cast<size_t>(m_lastProbeIndex)].InFlight)
+	{
+		m_entries[static_cast<size_t>(m_lastProbeIndex)].InFlight = false;
+		++m_entries[static_cast<size_t>(m_lastProbeIndex)].LostCount;
+	}
+
+	m_lastProbeIndex = m_probeIndex % static_cast<int>(m_entries.size());
+	m_probeIndex = m_lastProbeIndex + 1;
+
+	m_nextProbeTime = now + m_probeInterval;
+	m_probeInterval = jmin(m_probeInterval * 2, double(ET_MaxPollBackoffInterval));
+
+	return &m_entries[static_cast<size_t>(m_lastProbeIndex)];
+}
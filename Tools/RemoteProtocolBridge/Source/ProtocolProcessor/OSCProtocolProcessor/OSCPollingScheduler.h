@@ -0,0 +1,196 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include "OSCMessageEncoder.h"
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <unordered_map>
+
+
+/**
+ * Class OSCPollingScheduler holds the encoded poll messages of the active remote objects
+ * together with an individual polling interval and deadline per object.
+ * Instead of sending the entire poll set in one burst per polling interval, the deadlines of
+ * objects sharing an interval are staggered evenly across that interval, so the poll messages
+ * are spread over the time slots the scheduler is checked in.
+ * With adaptive polling enabled, the interval of an object whose polled value did not change
+ * is doubled with every response, up to a max. interval. It falls back to the configured
+ * interval as soon as the value changes or a new value is sent to the object.
+ * Every sent poll is tracked until it is answered or timed out, and an object is not polled again
+ * while its previous poll is in flight. If the device stops answering altogether, polling backs off
+ * to a single probe poll in an exponentially growing interval, until the device answers again.
+ */
+class OSCPollingScheduler
+{
+public:
+	/**
+	 * Scheduling state of a single polled remote object.
+	 */
+	struct PollEntry
+	{
+		RemoteObject			Object;			/**< The polled remote object. */
+		double					BaseInterval;	/**< The configured polling interval of the object, in ms. */
+		double					Interval;		/**< The current polling interval of the object, in ms. Longer than the configured one while adaptive polling backs off. */
+		double					Deadline;		/**< The time the object is due to be polled next, in ms. */
+		size_t					MessageOffset;	/**< The offset of the encoded poll message in the message buffer. */
+		size_t					MessageSize;	/**< The size of the encoded poll message. */
+		double					StaggerOffset;	/**< The offset of the first deadline of the object within its interval, in ms. */
+		bool					InFlight;		/**< Indication if a poll of the object was sent and is not answered or timed out yet. */
+		double					SentTime;		/**< The time the last poll of the object was sent, in ms. */
+		uint32					PollCount;		/**< The count of poll messages sent for the object since the poll set was set. */
+		uint32					ResponseCount;	/**< The count of polls of the object that were answered. */
+		uint32					LostCount;		/**< The count of polls of the object that were not answered in time. */
+		double					RoundTripTime;	/**< The smoothed round trip time of the polls of the object, in ms. */
+		double					LastRoundTripTime;	/**< The round trip time of the last answered poll of the object, in ms. */
+		bool					HasValue;		/**< Indication if a value of the object has been received yet. */
+		RemoteObjectMessageCopy	LastValue;		/**< The last received value of the object, to detect value changes. */
+	};
+
+	/**
+	 * Polling statistics of a single polled remote object.
+	 */
+	struct PollStatistics
+	{
+		RemoteObject	Object;				/**< The polled remote object. */
+		double			CurrentRate;		/**< The rate the object is currently polled at, in polls per second. */
+		double			AverageRate;		/**< The rate the object was polled at on average since the poll set was set, in polls per second. */
+		uint32			PollCount;			/**< The count of poll messages sent for the object. */
+		uint32			ResponseCount;		/**< The count of polls of the object that were answered. */
+		uint32			LostCount;			/**< The count of polls of the object that were not answered in time. */
+		double			RoundTripTime;		/**< The smoothed round trip time of the polls of the object, in ms. 0 if no poll was answered yet. */
+		double			LastRoundTripTime;	/**< The round trip time of the last answered poll of the object, in ms. 0 if no poll was answered yet. */
+	};
+
+public:
+	OSCPollingScheduler();
+	~OSCPollingScheduler();
+
+	void SetPollSet(const Array<RemoteObject>& objects, const Array<int>& intervals, OSCMessageEncoder& encoder);
+	void Clear();
+	void SetAdaptiveMaxInterval(int maxInterval);
+	void ResetResponseTracking();
+
+	bool OnValueReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, float precision, double now);
+	void OnValueSent(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal, double now);
+
+	bool IsEmpty() const;
+	bool IsDeviceResponsive() const;
+	int GetSlotInterval() const;
+	Array<PollStatistics> GetPollStatistics(double now) const;
+
+	/**
+	 * Method to invoke the given callable for every poll message that is due at the given time.
+	 * The deadline of every due object is advanced by its interval. Objects that missed
+	 * several deadlines (e.g. while the processor was not running) are not polled repeatedly
+	 * to catch up, but keep their position in the interval to not undo the staggering.
+	 * Objects whose previous poll is still in flight are skipped. While the device is unresponsive,
+	 * only a single probe poll is due per backoff interval.
+	 *
+	 * @param now		The current time, in ms.
+	 * @param onDue		The callable to be invoked with the RemoteObject, message data and message size of every due object.
+	 *					Has to return true if the poll message was sent, false if it was skipped.
+	 * @return	The number of poll messages that were sent.
+	 */
+	template <typename Callback>
+	int ProcessDue(double now, Callback&& onDue)
+	{
+		const char* messages = static_cast<const char*>(m_messages.getData());
+
+		if (!UpdateDeviceState(now))
+		{
+			PollEntry* probe = TakeDueProbe(now);
+			if (probe == nullptr || !onDue(probe->Object, messages + probe->MessageOffset, probe->MessageSize))
+				return 0;
+
+			OnPollSent(*probe, now);
+			return 1;
+		}
+
+		if (now < m_nextDeadline)
+			return 0;
+
+		int sentCount = 0;
+		double nextDeadline = std::numeric_limits<double>::max();
+		for (PollEntry& entry : m_entries)
+		{
+			if (entry.Deadline <= now)
+			{
+				if (!IsAwaitingResponse(entry, now) && onDue(entry.Object, messages + entry.MessageOffset, entry.MessageSize))
+				{
+					OnPollSent(entry, now);
+					++sentCount;
+				}
+
+				entry.Deadline += entry.Interval;
+				if (entry.Deadline <= now)
+					entry.Deadline += (std::floor((now - entry.Deadline) / entry.Interval) + 1.0) * entry.Interval;
+			}
+
+			nextDeadline = jmin(nextDeadline, entry.Deadline);
+		}
+		m_nextDeadline = nextDeadline;
+
+		return sentCount;
+	}
+
+private:
+	PollEntry* FindEntry(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal);
+	void ResetInterval(PollEntry& entry, double now);
+	bool IsAwaitingResponse(PollEntry& entry, double now);
+	void OnPollSent(PollEntry& entry, double now);
+	bool UpdateDeviceState(double now);
+	PollEntry* TakeDueProbe(double now);
+
+	std::vector<PollEntry>			m_entries;				/**< The scheduling state of all polled objects. */
+	std::unordered_map<uint64, int>	m_entryIndices;			/**< Lookup of the entry indices by remote object id and addressing. */
+	MemoryBlock						m_messages;				/**< The encoded poll messages of all polled objects. */
+	double							m_nextDeadline;			/**< The earliest deadline of all polled objects, in ms. */
+	double							m_pollSetTime;			/**< The time the poll set was set, in ms. */
+	int								m_minInterval;			/**< The shortest polling interval of all polled objects, in ms. */
+	int								m_adaptiveMaxInterval;	/**< The max. interval in ms adaptive polling backs off to. 0 if adaptive polling is disabled. */
+	double							m_firstUnansweredTime;	/**< The time the first poll was sent after the last received value, in ms. -1 if no poll is unanswered. */
+	bool							m_deviceResponsive;		/**< Indication if the device answers polls. Only probe polls are sent if not. */
+	double							m_probeInterval;		/**< The current interval an unresponsive device is probed in, in ms. */
+	double							m_nextProbeTime;		/**< The time the next probe poll is due, in ms. */
+	int								m_probeIndex;			/**< The index of the entry that is used for the next probe poll. */
+	int								m_lastProbeIndex;		/**< The index of the entry that was used for the last probe poll. -1 if none. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCPollingScheduler)
+};
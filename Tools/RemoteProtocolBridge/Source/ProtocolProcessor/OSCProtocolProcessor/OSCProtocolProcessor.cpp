@@ -33,6 +33,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "OSCProtocolProcessor.h"
+#include "OSCAddressTable.h"
+#include "OSCRawMessageDecoder.h"
 
 #include "../../ProcessingEngineConfig.h"
 //#include "../../ProcessingEngineNode.h"
@@ -43,15 +45,24 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // **************************************************************************************
 /**
  * Derived OSC remote protocol processing class
+ *
+ * @param listenerPortNumber	The port to listen on for incoming OSC messages
+ * @param useRealtimeCallback	True if received messages shall be handled directly on the network thread instead of the application message loop
  */
-OSCProtocolProcessor::OSCProtocolProcessor(int listenerPortNumber)
-	: ProtocolProcessor_Abstract(), m_oscReceiver(listenerPortNumber)
+OSCProtocolProcessor::OSCProtocolProcessor(int listenerPortNumber, bool useRealtimeCallback)
+	: ProtocolProcessor_Abstract(), m_oscReceiver(listenerPortNumber), m_processorTimer(*this)
 {
 	m_type = ProtocolType::PT_OSCProtocol;
 	m_oscMsgRate = ET_DefaultPollingRate;
+	m_bundleWindow = ET_DefaultBundleWindow;
+	m_useRealtimeCallback = useRealtimeCallback;
 
-	// OSCProtocolProcessor derives from OSCReceiver::Listener
-	m_oscReceiver.addListener(this);
+	for (int i = 0; i < TT_UserMAX; ++i)
+	{
+		m_timerTaskIntervals[i] = 0;
+		m_timerTaskDueTimes[i] = 0;
+	}
+	m_timerTickInterval = 0;
 }
 
 /**
@@ -60,6 +71,35 @@ OSCProtocolProcessor::OSCProtocolProcessor(int listenerPortNumber)
 OSCProtocolProcessor::~OSCProtocolProcessor()
 {
 	Stop();
+
+	RemoveReceiverListener();
+}
+
+/**
+ * Helper method to register this object as listener of the osc receiver.
+ * When the configured ip is a valid IPv4 address, the receiver only calls
+ * this object for data received from that address.
+ */
+void OSCProtocolProcessor::AddReceiverListener()
+{
+	m_senderEndpoint = SenderEndpoint::fromString(m_ipAddress);
+
+	// OSCProtocolProcessor derives from OSCReceiver::Listener
+	if (m_useRealtimeCallback)
+		m_oscReceiver.addListener(static_cast<SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>*>(this), m_senderEndpoint);
+	else
+		m_oscReceiver.addListener(static_cast<SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>*>(this), m_senderEndpoint);
+}
+
+/**
+ * Helper method to unregister this object as listener of the osc receiver.
+ */
+void OSCProtocolProcessor::RemoveReceiverListener()
+{
+	if (m_useRealtimeCallback)
+		m_oscReceiver.removeListener(static_cast<SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>*>(this));
+	else
+		m_oscReceiver.removeListener(static_cast<SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>*>(this));
 }
 
 /**
@@ -72,7 +112,17 @@ bool OSCProtocolProcessor::Start()
 	bool successR = false;
 
 	// Connect both sender and receiver  
-	successS = m_oscSender.connect(m_ipAddress, m_clientPort);
+	{
+		const ScopedLock l(m_sendLock);
+
+		m_sendSocket = std::make_unique<DatagramSocket>(true);
+		successS = m_sendSocket->bindToPort(0);
+		if (!successS)
+			m_sendSocket.reset();
+
+		// Polls sent before a restart are not going to be answered anymore
+		m_pollingScheduler.ResetResponseTracking();
+	}
 	jassert(successS);
 
 	successR = m_oscReceiver.connect();
@@ -80,6 +130,9 @@ bool OSCProtocolProcessor::Start()
 
 	m_IsRunning = (successS && successR);
 
+	// Bundle flushing, rate limiter release, polling and subscription pushes are run by the processor timer
+	UpdateProcessorTimer();
+
 	return m_IsRunning;
 }
 
@@ -93,9 +146,18 @@ bool OSCProtocolProcessor::Stop()
 	bool successS = false;
 	bool successR = false;
 
-	// Connect both sender and receiver  
-	successS = m_oscSender.disconnect();
-	jassert(successS);
+	UpdateProcessorTimer();
+
+	// Disconnect both sender and receiver  
+	{
+		const ScopedLock l(m_sendLock);
+
+		FlushBundle();
+		if (m_sendSocket)
+			m_sendBatch.Flush(*m_sendSocket);
+		m_sendSocket.reset();
+		successS = true;
+	}
 
 	successR = m_oscReceiver.disconnect();
 	jassert(successR);
@@ -106,7 +168,7 @@ bool OSCProtocolProcessor::Stop()
 /**
  * Reimplemented setter for protocol config data.
  * This calls the base implementation and in addition
- * takes care of setting polling interval.
+ * takes care of setting polling intervals and outgoing message bundling.
  *
  * @param protocolData	The configuration data struct with config data
  * @param activeObjs	The objects to use as 'active' for this protocol
@@ -116,14 +178,44 @@ bool OSCProtocolProcessor::Stop()
 void OSCProtocolProcessor::SetProtocolConfigurationData(const ProcessingEngineConfig::ProtocolData& protocolData, const Array<RemoteObject>& activeObjs, NodeId NId, ProtocolId PId)
 {
 	m_oscMsgRate = protocolData.PollingInterval;
+	m_pollingTiers = protocolData.PollingTiers;
+
+	{
+		const ScopedLock l(m_sendLock);
+
+		m_bundleWindow = protocolData.BundleWindow;
+		m_pollingScheduler.SetAdaptiveMaxInterval(protocolData.AdaptivePollingMaxInterval);
+		m_bundlePacker.SetMaxPacketSize(protocolData.BundleMTU);
+		m_sendBatch.SetTarget(protocolData.IpAddress, protocolData.ClientPort);
+	}
+
+	m_subscriptionFilter.SetMaxRate(protocolData.SubscriptionMaxRate);
+	m_subscriptionFilter.SetSubscriptions(protocolData.Subscriptions);
+	if (m_subscriptionFilter.IsRateLimited())
+		m_dueSubscriptionValues.resize(EBS_SubscriptionDueBatchSize);
 
 	ProtocolProcessor_Abstract::SetProtocolConfigurationData(protocolData, activeObjs, NId, PId);
+
+	if (m_rateLimiter.IsEnabled())
+		m_releasedMessages.resize(EBS_RateLimiterQueueSize);
+
+	UpdateProcessorTimer();
+
+	// (re-)register for the data received from the configured ip
+	RemoveReceiverListener();
+	AddReceiverListener();
 }
 
 /**
  * Setter for remote object to specifically activate.
  * For OSC processing this is used to activate internal polling
  * of the object values.
+ * The objects are reduced to the minimal set of poll queries first, e.g. x and y positions
+ * are answered by a single xy position poll and derived from its value when it is received.
+ * The poll messages of all queries are encoded once here and handed to the
+ * polling scheduler, that spreads them across their polling intervals.
+ * Objects polled at an individual interval are configured as polling tiers,
+ * all others are polled at the protocols' polling interval.
  * In case an empty list of objects is passed, polling is stopped and
  * the internal list is cleared.
  *
@@ -131,110 +223,363 @@ void OSCProtocolProcessor::SetProtocolConfigurationData(const ProcessingEngineCo
  */
 void OSCProtocolProcessor::SetRemoteObjectsActive(const Array<RemoteObject>& Objs)
 {
-	// Start timer callback if objects are to be polled
-	if (Objs.size() > 0)
 	{
+		const ScopedLock l(m_sendLock);
+
 		m_activeRemoteObjects = Objs;
+		if (m_activeRemoteObjects.size() > 0)
+		{
+			m_pollPlanner.Plan(m_activeRemoteObjects, m_oscMsgRate, m_pollingTiers);
+			m_pollingScheduler.SetPollSet(m_pollPlanner.GetPollObjects(), m_pollPlanner.GetPollIntervals(), m_messageEncoder);
+		}
+		else
+		{
+			m_pollPlanner.Clear();
+			m_pollingScheduler.Clear();
+		}
+	}
+
+	UpdateProcessorTimer();
+}
+
+/**
+ * Helper method to update the intervals of the periodic tasks from the current configuration and state,
+ * and to let the processor timer tick at the shortest of them, or to stop it if no task is active.
+ * A task whose interval did not change keeps its due time.
+ * Must not be called from the periodic tasks, since stopping the timer waits for them to finish.
+ */
+void OSCProtocolProcessor::UpdateProcessorTimer()
+{
+	const ScopedLock ul(m_timerUpdateLock);
 
-		startTimer(m_oscMsgRate);
+	int intervals[TT_UserMAX] = { 0 };
+	if (m_IsRunning)
+	{
+		{
+			// only the bundling and polling state is protected by the send lock. The rate limiter and subscription filter
+			// have locks of their own, that are held while sending from the timer thread, so they must not be taken under it.
+			const ScopedLock l(m_sendLock);
+
+			// Pending bundled messages are flushed at the latest after the bundling window
+			intervals[TT_BundleFlush] = m_bundleWindow;
+			// Poll messages are sent in time slots, spread across their polling intervals
+			intervals[TT_Polling] = m_pollingScheduler.IsEmpty() ? 0 : m_pollingScheduler.GetSlotInterval();
+		}
+
+		// Messages held back by the rate limiter are sent as soon as it releases them
+		intervals[TT_RateLimiter] = m_rateLimiter.IsEnabled() ? static_cast<int>(ET_RateLimiterInterval) : 0;
+		// Changed values of subscribed objects held back by the max. rate are pushed when they are due
+		intervals[TT_Subscription] = m_subscriptionFilter.IsRateLimited() ? static_cast<int>(ET_SubscriptionFlushInterval) : 0;
 	}
+
+	int tickInterval = 0;
+	double now = Time::getMillisecondCounterHiRes();
+	{
+		const ScopedLock l(m_timerTaskLock);
+
+		for (int i = 0; i < TT_UserMAX; ++i)
+		{
+			if (m_timerTaskIntervals[i] != intervals[i])
+			{
+				m_timerTaskIntervals[i] = intervals[i];
+				m_timerTaskDueTimes[i] = now + intervals[i];
+			}
+
+			if (intervals[i] > 0 && (tickInterval == 0 || intervals[i] < tickInterval))
+				tickInterval = intervals[i];
+		}
+
+		m_timerTickInterval = tickInterval;
+	}
+
+	if (tickInterval > 0)
+		m_processorTimer.startTimer(tickInterval);
 	else
+		m_processorTimer.stopTimer();
+}
+
+/**
+ * Called by the processor timer to run the periodic tasks that are due.
+ * Tasks with a longer interval than the timer tick run on the first tick they are due at.
+ */
+void OSCProtocolProcessor::OnProcessorTimer()
+{
+	bool isDue[TT_UserMAX] = { false };
+	double now = Time::getMillisecondCounterHiRes();
 	{
-		m_activeRemoteObjects.clear();
+		const ScopedLock l(m_timerTaskLock);
+
+		// tolerate ticks that arrive a little early, to not skip a task for a whole tick
+		double tolerance = 0.5 * m_timerTickInterval;
+		for (int i = 0; i < TT_UserMAX; ++i)
+		{
+			if (m_timerTaskIntervals[i] <= 0 || now + tolerance < m_timerTaskDueTimes[i])
+				continue;
 
-		stopTimer();
+			isDue[i] = true;
+			m_timerTaskDueTimes[i] += m_timerTaskIntervals[i];
+			if (m_timerTaskDueTimes[i] + tolerance <= now)
+				m_timerTaskDueTimes[i] = now + m_timerTaskIntervals[i];
+		}
 	}
+
+	if (isDue[TT_RateLimiter])
+		OnRateLimiterInterval();
+	if (isDue[TT_Subscription])
+		OnSubscriptionInterval();
+	if (isDue[TT_Polling])
+		OnPollingSlot();
+	// the bundle is flushed last, to send what the other tasks added to it
+	if (isDue[TT_BundleFlush])
+		OnBundleWindowElapsed();
 }
 
 /**
- * Method to trigger sending of a message
+ * Method to trigger sending of a message.
+ * If the client subscribed to objects, only changed values of these are sent, in the subscription max. rate.
+ * If rate limiting is enabled and the rate is exceeded, the message is held back until the rate limiter releases it.
  *
  * @param Id		The id of the object to send a message for
  * @param msgData	The message payload and metadata
+ * @return	True if the message was sent, queued or deliberately filtered.
  */
 bool OSCProtocolProcessor::SendMessage(RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData)
 {
 	if (!m_IsRunning)
 		return false;
 
-	bool sendSuccess = false;
+	if (!m_subscriptionFilter.Filter(Id, msgData, m_dataPrecision, Time::getMillisecondCounterHiRes()))
+		return true;
 
-	String addressString = GetRemoteObjectString(Id);
+	return SendMessageRateLimited(Id, msgData);
+}
 
-	if (msgData.addrVal.second != INVALID_ADDRESS_VALUE)
-		addressString += String::formatted("/%d", msgData.addrVal.second);
+/**
+ * Helper method to send a message right away, or to hold it back if rate limiting is enabled and the rate is exceeded.
+ *
+ * @param Id		The id of the object to send a message for
+ * @param msgData	The message payload and metadata
+ * @return	True if the message was sent or held back.
+ */
+bool OSCProtocolProcessor::SendMessageRateLimited(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	RateLimiterLane lane = ProtocolRateLimiter::GetLane(Id, msgData);
+	if (!m_rateLimiter.TryAcquire(lane))
+		return m_rateLimiter.HoldBack(lane, Id, msgData);
 
-	if (msgData.addrVal.first != INVALID_ADDRESS_VALUE)
-		addressString += String::formatted("/%d", msgData.addrVal.first);
+	return SendMessageNow(Id, msgData);
+}
 
-	uint16 valSize;
-	switch (msgData.valType)
-	{
-	case ROVT_INT:
-		valSize = sizeof(int);
-		break;
-	case ROVT_FLOAT:
-		valSize = sizeof(float);
-		break;
-	case ROVT_STRING:
-		jassertfalse; // String not (yet?) supported
-		valSize = 0;
-		break;
-	case ROVT_NONE:
-	default:
-		valSize = 0;
-		break;
-	}
+/**
+ * Helper method to encode and send a message right away, or add it to the pending bundle if bundling is enabled.
+ *
+ * @param Id		The id of the object to send a message for
+ * @param msgData	The message payload and metadata
+ * @return	True if the message was sent or bundled.
+ */
+bool OSCProtocolProcessor::SendMessageNow(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	const ScopedLock l(m_sendLock);
+
+	if (!m_sendSocket)
+		return false;
+
+	// A value written to the object is expected to change, so adaptive polling returns to the configured interval
+	if (msgData.valCount > 0)
+		m_pollingScheduler.OnValueSent(m_pollPlanner.GetPolledId(Id, msgData.addrVal), msgData.addrVal, Time::getMillisecondCounterHiRes());
 
-	jassert((msgData.valCount*valSize) == msgData.payloadSize);
+	// Address and type tags are copied from the encoders' cache, values are appended in network byte order
+	size_t messageSize = m_messageEncoder.EncodeMessage(Id, msgData, m_sendBuffer, sizeof(m_sendBuffer));
+	if (messageSize == 0)
+		return false;
+
+	return SendEncodedMessage(m_sendBuffer, messageSize);
+}
+
+/**
+ * Helper method to send an already encoded message right away, or add it to the pending bundle if bundling is enabled.
+ * Must be called with m_sendLock held.
+ *
+ * @param message		The encoded message data.
+ * @param messageSize	The encoded message data size.
+ * @return	True if the message was sent or bundled.
+ */
+bool OSCProtocolProcessor::SendEncodedMessage(const char* message, size_t messageSize)
+{
+	if (m_bundleWindow <= 0)
+		return WritePacket(message, messageSize);
+
+	// Accumulate the message in the pending bundle, that is sent when full or when the bundling window elapsed
+	if (m_bundlePacker.AddMessage(message, messageSize))
+		return true;
+
+	bool flushSuccess = FlushBundle();
+	if (m_bundlePacker.AddMessage(message, messageSize))
+		return flushSuccess;
+
+	// Message too large to be bundled at all with the configured mtu
+	return WritePacket(message, messageSize) && flushSuccess;
+}
+
+/**
+ * Helper method to send the pending bundle of accumulated outgoing messages.
+ * Must be called with m_sendLock held.
+ *
+ * @return	True if there was nothing to send or sending succeeded.
+ */
+bool OSCProtocolProcessor::FlushBundle()
+{
+	size_t packetSize = 0;
+	const char* packet = m_bundlePacker.GetPacket(packetSize);
+	if (packet == nullptr)
+		return true;
+
+	bool sendSuccess = WritePacket(packet, packetSize);
+	m_bundlePacker.Clear();
+
+	return sendSuccess;
+}
+
+/**
+ * Helper method to send a single encoded packet with the send socket.
+ * On Linux, the packet is queued in the send batch until FlushPendingMessages is called.
+ * Must be called with m_sendLock held.
+ *
+ * @param packet		The packet data.
+ * @param packetSize	The packet data size.
+ * @return	True if the packet was queued or completely written.
+ */
+bool OSCProtocolProcessor::WritePacket(const char* packet, size_t packetSize)
+{
+	if (!m_sendSocket)
+		return false;
+
+	return m_sendBatch.Send(*m_sendSocket, packet, packetSize);
+}
+
+/**
+ * Reimplemented method to send the packets that were queued for batched sending.
+ * Called by the parent node when it finished processing a batch of received messages.
+ */
+void OSCProtocolProcessor::FlushPendingMessages()
+{
+	const ScopedLock l(m_sendLock);
+
+	if (m_sendSocket)
+		m_sendBatch.Flush(*m_sendSocket);
+}
+
+/**
+ * Called by the processor timer when the bundling window elapsed.
+ */
+void OSCProtocolProcessor::OnBundleWindowElapsed()
+{
+	const ScopedLock l(m_sendLock);
+
+	FlushBundle();
+	if (m_sendSocket)
+		m_sendBatch.Flush(*m_sendSocket);
+}
 
-	switch (msgData.valType)
+/**
+ * Called by the processor timer to send the messages the rate limiter released, in order of their priority.
+ */
+void OSCProtocolProcessor::OnRateLimiterInterval()
+{
+	bool releasedMessages = false;
+	for (int i = RLL_Position; i < RLL_UserMAX; ++i)
 	{
-	case ROVT_INT:
+		int count = m_rateLimiter.TakeReleased(static_cast<RateLimiterLane>(i), m_releasedMessages.data(), static_cast<int>(m_releasedMessages.size()));
+		for (int j = 0; j < count; ++j)
 		{
-		jassert(msgData.valCount < 4); // max known d&b OSC msg val cnt would be positioning xyz
-		int multivalues[3];
-
-		for (int i = 0; i < msgData.valCount; ++i)
-			multivalues[i] = ((int*)msgData.payload)[i];
-
-		if (msgData.valCount == 1)
-			sendSuccess = m_oscSender.send(OSCMessage(addressString, multivalues[0]));
-		else if (msgData.valCount == 2)
-			sendSuccess = m_oscSender.send(OSCMessage(addressString, multivalues[0], multivalues[1]));
-		else if (msgData.valCount == 3)
-			sendSuccess = m_oscSender.send(OSCMessage(addressString, multivalues[0], multivalues[1], multivalues[2]));
-		else
-			sendSuccess = m_oscSender.send(OSCMessage(addressString));
+			RemoteObjectMessageData msgData = m_releasedMessages[static_cast<size_t>(j)].GetMessageData();
+			SendMessageNow(m_releasedMessages[static_cast<size_t>(j)].Id, msgData);
 		}
-		break;
-	case ROVT_FLOAT:
-		{
-		jassert(msgData.valCount < 4); // max known d&b OSC msg val cnt would be positioning xyz
-		float multivalues[3];
-
-		for (int i = 0; i < msgData.valCount; ++i)
-			multivalues[i] = ((float*)msgData.payload)[i];
-
-		if (msgData.valCount == 1)
-			sendSuccess = m_oscSender.send(OSCMessage(addressString, multivalues[0]));
-		else if (msgData.valCount == 2)
-			sendSuccess = m_oscSender.send(OSCMessage(addressString, multivalues[0], multivalues[1]));
-		else if (msgData.valCount == 3)
-			sendSuccess = m_oscSender.send(OSCMessage(addressString, multivalues[0], multivalues[1], multivalues[2]));
+		releasedMessages = releasedMessages || count > 0;
+	}
+
+	if (releasedMessages)
+		FlushPendingMessages();
+}
+
+/**
+ * Called by the processor timer to push the changed values of subscribed objects
+ * that were held back by the subscription max. rate and are due now.
+ */
+void OSCProtocolProcessor::OnSubscriptionInterval()
+{
+	int dueCount = m_subscriptionFilter.TakeDue(Time::getMillisecondCounterHiRes(), m_dueSubscriptionValues.data(), static_cast<int>(m_dueSubscriptionValues.size()));
+	for (int i = 0; i < dueCount; ++i)
+	{
+		RemoteObjectMessageData msgData = m_dueSubscriptionValues[static_cast<size_t>(i)].GetMessageData();
+		SendMessageRateLimited(m_dueSubscriptionValues[static_cast<size_t>(i)].Id, msgData);
+	}
+
+	if (dueCount > 0)
+		FlushPendingMessages();
+}
+
+/**
+ * Helper method to handle the subscription requests of the client.
+ * '/subscribe' subscribes the client to the objects given as OSC address string arguments
+ * (e.g. '/dbaudio1/coordinatemapping/source_position_xy/1/3'), '/unsubscribe' unsubscribes it from them,
+ * or from all objects if no argument is given.
+ * Once subscribed, only changed values of the subscribed objects are pushed to the client.
+ *
+ * @param addressString	The address of the received message.
+ * @param message		The received message.
+ * @return	True if the message was a subscription request, false otherwise.
+ */
+bool OSCProtocolProcessor::HandleSubscriptionMessage(const String& addressString, const OSCMessage& message)
+{
+	bool subscribe = (addressString == "/subscribe");
+	if (!subscribe && addressString != "/unsubscribe")
+		return false;
+
+	if (!subscribe && message.isEmpty())
+		m_subscriptionFilter.Clear();
+
+	for (const OSCArgument& argument : message)
+	{
+		if (!argument.isString())
+			continue;
+
+		String objectAddress = argument.getString();
+
+		RemoteObject object;
+		const OSCAddressTable::Entry* knownAddress = OSCAddressTable::Lookup(objectAddress.toRawUTF8(), objectAddress.getNumBytesAsUTF8(), object.Addr);
+		if (!knownAddress || knownAddress->AddressingCount == 0)
+			continue;
+
+		object.Id = knownAddress->Id;
+		if (knownAddress->AddressingCount < 2)
+			object.Addr.second = INVALID_ADDRESS_VALUE;
+
+		if (subscribe)
+			m_subscriptionFilter.Subscribe(object);
 		else
-			sendSuccess = m_oscSender.send(OSCMessage(addressString));
-		}
-		break;
-	case ROVT_NONE:
-		sendSuccess = m_oscSender.send(OSCMessage(addressString));
-		break;
-	case ROVT_STRING:
-	default:
-		break;
+			m_subscriptionFilter.Unsubscribe(object);
 	}
 
-	return sendSuccess;
+#ifdef DEBUG
+	DBG("NId" + String(m_parentNodeId)
+		+ " PId" + String(m_protocolProcessorId) + ": client subscribed to "
+		+ String(m_subscriptionFilter.GetSubscriptionCount()) + " objects");
+#endif
+
+	UpdateProcessorTimer();
+
+	return true;
+}
+
+/**
+ * Getter for the number of objects the client subscribed to.
+ *
+ * @return	The number of subscribed objects, 0 if every value is pushed to the client.
+ */
+int OSCProtocolProcessor::GetSubscriptionCount() const
+{
+	return m_subscriptionFilter.GetSubscriptionCount();
 }
 
 /**
@@ -248,7 +593,8 @@ bool OSCProtocolProcessor::SendMessage(RemoteObjectIdentifier Id, RemoteObjectMe
 */
 void OSCProtocolProcessor::oscBundleReceived(const OSCBundle &bundle, const String& senderIPAddress, const int& senderPort)
 {
-	if (senderIPAddress != m_ipAddress)
+	// Data from foreign senders is only received if the configured ip could not be used for sender specific registration
+	if (!m_senderEndpoint.isValid() && senderIPAddress != m_ipAddress)
 	{
 #ifdef DEBUG
 		DBG("NId"+String(m_parentNodeId) 
@@ -267,6 +613,38 @@ void OSCProtocolProcessor::oscBundleReceived(const OSCBundle &bundle, const Stri
 	}
 }
 
+/**
+ * Called on the network thread with the raw received data, before it is parsed into OSC objects.
+ * Messages of known remote objects are decoded in place and passed to the parent node,
+ * without creating any intermediate objects. Data with unknown addresses is left to the regular parsing.
+ *
+ * The receiver only calls this for data from the configured ip, if it is a valid IPv4 address.
+ *
+ * @param data		The raw received data.
+ * @param dataSize	The size of the raw received data.
+ * @param sender	The endpoint the data originates from.
+ * @return	True if the data was handled or deliberately ignored, false if it requires regular parsing.
+ */
+bool OSCProtocolProcessor::oscRawDataReceived(const char* data, size_t dataSize, const SenderEndpoint& sender)
+{
+	ignoreUnused(sender);
+
+	// Without sender specific registration, leave the data to regular parsing that filters by ip string
+	if (!m_senderEndpoint.isValid())
+		return false;
+
+	OSCRawMessageDecoder::DecodeResult result = OSCRawMessageDecoder::DecodePacket(data, dataSize, [this](RemoteObjectMessageCopy& message)
+	{
+		// value object messages without values are polls, that do not answer our own polls
+		if (message.valCount == 0 && message.addrVal.first != INVALID_ADDRESS_VALUE)
+			OnPollReceived(message.Id, message.GetMessageData());
+		else
+			OnValueReceived(message.Id, message.GetMessageData());
+	});
+
+	return result != OSCRawMessageDecoder::DR_UnknownAddress;
+}
+
 /**
  * Called when the OSCReceiver receives a new OSC message and parses its contents to
  * pass the received data to parent node for further handling
@@ -278,7 +656,9 @@ void OSCProtocolProcessor::oscBundleReceived(const OSCBundle &bundle, const Stri
 void OSCProtocolProcessor::oscMessageReceived(const OSCMessage &message, const String& senderIPAddress, const int& senderPort)
 {
 	ignoreUnused(senderPort);
-	if (senderIPAddress != m_ipAddress)
+
+	// Data from foreign senders is only received if the configured ip could not be used for sender specific registration
+	if (!m_senderEndpoint.isValid() && senderIPAddress != m_ipAddress)
 	{
 #ifdef DEBUG
 		DBG("NId" + String(m_parentNodeId)
@@ -300,138 +680,96 @@ void OSCProtocolProcessor::oscMessageReceived(const OSCMessage &message, const S
 	newMsgData.payloadSize = 0;
 
 	String addressString = message.getAddressPattern().toString();
-	// Check if the incoming message is a response to a sent "ping" heartbeat.
-	if (addressString.startsWith(GetRemoteObjectString(ROI_HeartbeatPong)) && m_messageListener)
-		m_messageListener->OnProtocolMessageReceived(this, ROI_HeartbeatPong, newMsgData);
-	// Check if the incoming message is a response to a sent "pong" heartbeat.
-	else if (addressString.startsWith(GetRemoteObjectString(ROI_HeartbeatPing)) && m_messageListener)
-		m_messageListener->OnProtocolMessageReceived(this, ROI_HeartbeatPing, newMsgData);
+
+	// Subscription requests are handled by the processor and not passed to the parent node
+	if (HandleSubscriptionMessage(addressString, message))
+		return;
+
+	// Classify the address by table lookup, incl. splitting off the appended mapping and source ids.
+	RemoteObjectAddressing addressing;
+	const OSCAddressTable::Entry* knownAddress = OSCAddressTable::Lookup(addressString.toRawUTF8(), addressString.getNumBytesAsUTF8(), addressing);
+
+	// Check if the incoming message is a "ping" or "pong" heartbeat.
+	if (knownAddress && knownAddress->AddressingCount == 0)
+	{
+		if (m_messageListener)
+			m_messageListener->OnProtocolMessageReceived(this, knownAddress->Id, newMsgData);
+	}
+	// Check if the incoming message is a poll for the current value of a known object.
+	else if (knownAddress && !isContentMessage)
+	{
+		if (addressing.first <= 0 || (knownAddress->AddressingCount == 2 && addressing.second <= 0))
+			return;
+
+		newMsgData.addrVal.first = addressing.first;
+		if (knownAddress->AddressingCount == 2)
+			newMsgData.addrVal.second = addressing.second;
+
+		OnPollReceived(knownAddress->Id, newMsgData);
+	}
 	// Check if the incoming message contains parameters.
-	else if (messageSize > 0)
+	else if (isContentMessage)
 	{
-		// Parse the Source ID
-		int sourceId = (addressString.fromLastOccurrenceOf("/", false, true)).getIntValue();
+		// Parse the Source ID (unknown objects are forwarded as invalid object, with the last address part as Source ID)
+		int sourceId = knownAddress ? addressing.first : (addressString.fromLastOccurrenceOf("/", false, true)).getIntValue();
 		jassert(sourceId > 0);
 		if (sourceId > 0)
 		{
-			RemoteObjectIdentifier newObjectId;
+			RemoteObjectIdentifier newObjectId = knownAddress ? knownAddress->Id : ROI_Invalid;
 
 			newMsgData.addrVal.first = int16(sourceId);
 			newMsgData.valType = ROVT_FLOAT;
-		
-			float newFloatValue;
-			float newDualFloatValue[2];
-			int newIntValue;
-
-			// Determine which parameter was changed depending on the incoming message's address pattern.
-			if (addressString.startsWith(GetRemoteObjectString(ROI_SoundObject_Position_XY)))
-			{
-				// Parse the Mapping ID
-				addressString = addressString.upToLastOccurrenceOf("/", false, true);
-				newMsgData.addrVal.second = int16((addressString.fromLastOccurrenceOf("/", false, true)).getIntValue());
-				jassert(newMsgData.addrVal.second > 0);
 
-				newObjectId = ROI_SoundObject_Position_XY;
+			float newFloatValues[MAX_REMOTE_OBJECT_VALUE_COUNT];
+			int newIntValues[MAX_REMOTE_OBJECT_VALUE_COUNT];
 
-				if (isContentMessage)
-				{
-					newDualFloatValue[0] = message[0].getFloat32();
-					newDualFloatValue[1] = message[1].getFloat32();
-
-					newMsgData.valCount = 2;
-					newMsgData.payload = &newDualFloatValue;
-					newMsgData.payloadSize = 2 * sizeof(float);
-				}
-			}
-			else if (addressString.startsWith(GetRemoteObjectString(ROI_SoundObject_Position_X)))
+			if (knownAddress)
 			{
-				// Parse the Mapping ID
-				addressString = addressString.upToLastOccurrenceOf("/", false, true);
-				newMsgData.addrVal.second = int16((addressString.fromLastOccurrenceOf("/", false, true)).getIntValue());
-				jassert(newMsgData.addrVal.second > 0);
-
-				newObjectId = ROI_SoundObject_Position_X;
-				
-				if (isContentMessage)
+				// Objects with mapping use the Mapping ID as second address value
+				if (knownAddress->AddressingCount == 2)
 				{
-					newFloatValue = message[0].getFloat32();
-
-					newMsgData.valCount = 1;
-					newMsgData.payload = &newFloatValue;
-					newMsgData.payloadSize = sizeof(float);
+					newMsgData.addrVal.second = addressing.second;
+					jassert(newMsgData.addrVal.second > 0);
 				}
-			}
-			else if (addressString.startsWith(GetRemoteObjectString(ROI_SoundObject_Position_Y)))
-			{
-				// Parse the Mapping ID
-				addressString = addressString.upToLastOccurrenceOf("/", false, true);
-				newMsgData.addrVal.second = int16((addressString.fromLastOccurrenceOf("/", false, true)).getIntValue());
-				jassert(newMsgData.addrVal.second > 0);
 
-				newObjectId = ROI_SoundObject_Position_Y;
+				if (messageSize < knownAddress->ValCount)
+					return;
 
-				if (isContentMessage)
+				for (int i = 0; i < knownAddress->ValCount; ++i)
 				{
-					newFloatValue = message[0].getFloat32();
-
-					newMsgData.valCount = 1;
-					newMsgData.payload = &newFloatValue;
-					newMsgData.payloadSize = sizeof(float);
+					// int values should be int, but since some OSC appliances can only process floats,
+					// we need to be prepared to optionally accept float as well (and vice versa)
+					if (message[i].isInt32())
+					{
+						newIntValues[i] = message[i].getInt32();
+						newFloatValues[i] = float(newIntValues[i]);
+					}
+					else if (message[i].isFloat32())
+					{
+						newFloatValues[i] = message[i].getFloat32();
+						if (!OSCRawMessageDecoder::FloatToInt(newFloatValues[i], newIntValues[i]))
+							return;
+					}
+					else
+						return;
 				}
-			}
-			else if (addressString.startsWith(GetRemoteObjectString(ROI_SoundObject_Spread)))
-			{
-				newObjectId = ROI_SoundObject_Spread;
-
-				if (isContentMessage)
-				{
-					newFloatValue = message[0].getFloat32();
-
-					newMsgData.valCount = 1;
-					newMsgData.payload = &newFloatValue;
-					newMsgData.payloadSize = sizeof(float);
-				}
-			}
-			else if (addressString.startsWith(GetRemoteObjectString(ROI_SoundObject_DelayMode)))
-			{
-				newObjectId = ROI_SoundObject_DelayMode;
 
-				if (isContentMessage)
+				newMsgData.valType = knownAddress->ValType;
+				newMsgData.valCount = knownAddress->ValCount;
+				if (knownAddress->ValType == ROVT_INT)
 				{
-					// delaymode should be an int, but since some OSC appliances can only process floats,
-					// we need to be prepared to optionally accept float as well
-					if (message[0].isInt32())
-						newIntValue = message[0].getInt32();
-					else if (message[0].isFloat32())
-						newIntValue = (int)round(message[0].getFloat32());
-
-					newMsgData.valType = ROVT_INT;
-					newMsgData.valCount = 1;
-					newMsgData.payload = &newIntValue;
-					newMsgData.payloadSize = sizeof(int);
+					newMsgData.payload = &newIntValues;
+					newMsgData.payloadSize = knownAddress->ValCount * sizeof(int);
 				}
-			}
-			else if (addressString.startsWith(GetRemoteObjectString(ROI_ReverbSendGain)))
-			{
-				newObjectId = ROI_ReverbSendGain;
-
-				if (isContentMessage)
+				else
 				{
-					newFloatValue = message[0].getFloat32();
-
-					newMsgData.valCount = 1;
-					newMsgData.payload = &newFloatValue;
-					newMsgData.payloadSize = sizeof(float);
+					newMsgData.payload = &newFloatValues;
+					newMsgData.payloadSize = knownAddress->ValCount * sizeof(float);
 				}
 			}
-			else
-			{
-				newObjectId = ROI_Invalid;
-			}
 
-			// provide the received message to parent node
-			if (m_messageListener)
-				m_messageListener->OnProtocolMessageReceived(this, newObjectId, newMsgData);
+			// provide the received message and the values derived from it to parent node
+			OnValueReceived(newObjectId, newMsgData);
 		}
 	}
 }
@@ -444,45 +782,111 @@ void OSCProtocolProcessor::oscMessageReceived(const OSCMessage &message, const S
  */
 String OSCProtocolProcessor::GetRemoteObjectString(RemoteObjectIdentifier id)
 {
-	switch (id)
+	return String(CharPointer_ASCII(OSCAddressTable::GetAddress(id)));
+}
+
+/**
+ * Helper method to pass every received value to the polling scheduler, to match it with the poll in flight
+ * and to adapt the polling interval of the object.
+ * The value is then passed on to the parent node, together with the values of the active objects
+ * that are derived from it, since they are answered by the same poll.
+ *
+ * @param Id		The remote object id of the received value.
+ * @param msgData	The received message data.
+ */
+void OSCProtocolProcessor::OnValueReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	OSCPollPlanner::Derivation derivation;
 	{
-	case ROI_HeartbeatPong:
-		return "/pong";
-	case ROI_HeartbeatPing:
-		return "/ping";
-	case ROI_SoundObject_Position_X:
-		return "/dbaudio1/coordinatemapping/source_position_x";
-	case ROI_SoundObject_Position_Y:
-		return "/dbaudio1/coordinatemapping/source_position_y";
-	case ROI_SoundObject_Position_XY:
-		return "/dbaudio1/coordinatemapping/source_position_xy";
-	case ROI_SoundObject_Spread:
-		return "/dbaudio1/positioning/source_spread";
-	case ROI_SoundObject_DelayMode:
-		return "/dbaudio1/positioning/source_delaymode";
-	case ROI_ReverbSendGain:
-		return "/dbaudio1/matrixinput/reverbsendgain";
-	default:
-		return "";
+		const ScopedLock l(m_sendLock);
+
+		m_pollingScheduler.OnValueReceived(Id, msgData, m_dataPrecision, Time::getMillisecondCounterHiRes());
+		derivation = m_pollPlanner.GetDerivation(Id, msgData.addrVal);
 	}
+
+	if (!m_messageListener)
+		return;
+
+	OSCPollPlanner::ForwardReceived(Id, msgData, derivation, [this](RemoteObjectIdentifier forwardId, RemoteObjectMessageData forwardMsgData)
+	{
+		m_messageListener->OnProtocolMessageReceived(this, forwardId, forwardMsgData);
+	});
 }
 
 /**
- * Timer callback function, which will be called at regular intervals to
- * send out OSC poll messages.
+ * Helper method to pass a received poll on to the parent node, to be answered from its state cache
+ * or forwarded to the protocols that hold the polled value.
+ * Polls are not passed to the polling scheduler, since they do not answer the polls sent by this processor.
+ *
+ * @param Id		The remote object id of the polled object.
+ * @param msgData	The received message data, without values.
  */
-void OSCProtocolProcessor::timerCallback()
+void OSCProtocolProcessor::OnPollReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
 {
-	int objectCount = m_activeRemoteObjects.size();
-	for (int i = 0; i < objectCount; i++)
+	if (!m_messageListener)
+		return;
+
+	RemoteObjectMessageData pollMsgData = msgData;
+	m_messageListener->OnProtocolMessageReceived(this, Id, pollMsgData);
+}
+
+/**
+ * Getter for the polling statistics of the active remote objects.
+ * With adaptive polling enabled, the rates show how far the polling of unchanging values backed off.
+ * The response counts and round trip times show how the device keeps up with the polling.
+ *
+ * @return	The polling rates, response counts and round trip times per polled object.
+ */
+Array<OSCPollingScheduler::PollStatistics> OSCProtocolProcessor::GetPollStatistics() const
+{
+	const ScopedLock l(m_sendLock);
+
+	return m_pollingScheduler.GetPollStatistics(Time::getMillisecondCounterHiRes());
+}
+
+/**
+ * Getter for the flag if the polled device answers polls.
+ *
+ * @return	True if the device answers polls, false if polling is backed off to probing it.
+ */
+bool OSCProtocolProcessor::IsPolledDeviceResponsive() const
+{
+	const ScopedLock l(m_sendLock);
+
+	return m_pollingScheduler.IsDeviceResponsive();
+}
+
+/**
+ * Called by the processor timer in every time slot, to send the poll messages
+ * of the active remote objects that are due.
+ */
+void OSCProtocolProcessor::OnPollingSlot()
+{
+	if (!m_IsRunning)
+		return;
+
+	const ScopedLock l(m_sendLock);
+
+	if (!m_sendSocket)
+		return;
+
+	// Polls that the rate limiter requires to leave the remaining rate to value changes are skipped until their next deadline
+	int sentCount = m_pollingScheduler.ProcessDue(Time::getMillisecondCounterHiRes(), [this](const RemoteObject& obj, const char* message, size_t messageSize)
+	{
+		ignoreUnused(obj);
+
+		if (!m_rateLimiter.TryAcquire(RLL_Polling))
+		{
+			m_rateLimiter.AddDropped(RLL_Polling, 1);
+			return false;
+		}
+
+		return SendEncodedMessage(message, messageSize);
+	});
+
+	if (sentCount > 0)
 	{
-		RemoteObjectMessageData msgData;
-		msgData.addrVal = m_activeRemoteObjects[i].Addr;
-		msgData.valCount = 0;
-		msgData.valType = ROVT_NONE;
-		msgData.payload = 0;
-		msgData.payloadSize = 0;
-		
-		SendMessage(m_activeRemoteObjects[i].Id, msgData);
+		FlushBundle();
+		m_sendBatch.Flush(*m_sendSocket);
 	}
 }
\ No newline at end of file
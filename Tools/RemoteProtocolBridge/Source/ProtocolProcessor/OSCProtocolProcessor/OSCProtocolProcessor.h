@@ -38,6 +38,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../ProtocolProcessor_Abstract.h"
 
 #include "SenderAwareOSCReceiver.h"
+#include "OSCMessageEncoder.h"
+#include "OSCBundlePacker.h"
+#include "OSCPollPlanner.h"
+#include "OSCPollingScheduler.h"
+#include "OSCSubscriptionFilter.h"
+#include "DatagramBatchIO.h"
 
 #include <JuceHeader.h>
 
@@ -47,11 +53,11 @@ using namespace SenderAwareOSC;
  * Class OSCProtocolProcessor is a derived class for OSC protocol interaction.
  */
 class OSCProtocolProcessor : public SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>,
-	public ProtocolProcessor_Abstract,
-	private Timer
+	public SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>,
+	public ProtocolProcessor_Abstract
 {
 public:
-	OSCProtocolProcessor(int listenerPortNumber);
+	OSCProtocolProcessor(int listenerPortNumber, bool useRealtimeCallback = false);
 	~OSCProtocolProcessor();
 
 	void SetProtocolConfigurationData(const ProcessingEngineConfig::ProtocolData& protocolData, const Array<RemoteObject>& activeObjs, NodeId NId, ProtocolId PId) override;
@@ -60,20 +66,86 @@ public:
 	bool Stop() override;
 	void SetRemoteObjectsActive(const Array<RemoteObject>& Objs) override;
 	bool SendMessage(RemoteObjectIdentifier id, RemoteObjectMessageData& msgData) override;
+	void FlushPendingMessages() override;
+
+	Array<OSCPollingScheduler::PollStatistics> GetPollStatistics() const;
+	bool IsPolledDeviceResponsive() const;
+	int GetSubscriptionCount() const;
 
 	static String GetRemoteObjectString(RemoteObjectIdentifier id);
 
 	virtual void oscBundleReceived(const OSCBundle &bundle, const String& senderIPAddress, const int& senderPort) override;
 	virtual void oscMessageReceived(const OSCMessage &message, const String& senderIPAddress, const int& senderPort) override;
+	virtual bool oscRawDataReceived(const char* data, size_t dataSize, const SenderEndpoint& sender) override;
 
 private:
-	void timerCallback() override;
+	/**
+	 * The periodic tasks of the processor, all driven by the single processor timer.
+	 */
+	enum TimerTask
+	{
+		TT_BundleFlush = 0,	/**< Send the pending bundle when the bundling window elapsed. */
+		TT_RateLimiter,		/**< Send the messages the rate limiter released. */
+		TT_Polling,			/**< Send the poll messages that are due in the current time slot. */
+		TT_Subscription,	/**< Push the changed values held back by the subscription max. rate. */
+		TT_UserMAX			/**< Value to mark enum max; For iteration purpose. */
+	};
+
+	/**
+	 * Timer running the periodic tasks of the processor on a single thread,
+	 * instead of a timer thread per task.
+	 */
+	class ProcessorTimer : public HighResolutionTimer
+	{
+	public:
+		ProcessorTimer(OSCProtocolProcessor& processor) : m_processor(processor) {}
+		void hiResTimerCallback() override { m_processor.OnProcessorTimer(); }
+
+	private:
+		OSCProtocolProcessor& m_processor;	/**< The processor to run the due tasks of. */
+	};
+
+	void OnProcessorTimer();
+	void OnPollingSlot();
+	void OnSubscriptionInterval();
+	bool HandleSubscriptionMessage(const String& addressString, const OSCMessage& message);
+	void OnValueReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	void OnPollReceived(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	void OnBundleWindowElapsed();
+	void OnRateLimiterInterval();
+	bool SendMessageRateLimited(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	bool SendMessageNow(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	bool SendEncodedMessage(const char* message, size_t messageSize);
+	bool FlushBundle();
+	bool WritePacket(const char* packet, size_t packetSize);
+	void UpdateProcessorTimer();
+	void AddReceiverListener();
+	void RemoveReceiverListener();
 
 private:
-	OSCSender				m_oscSender;			/**< An OSCSender object can connect to a network port. It then can send OSC
-													   * messages and bundles to a specified host over an UDP socket. */
+	std::unique_ptr<DatagramSocket>	m_sendSocket;	/**< The udp socket used to send the encoded OSC messages to the host. */
+	OSCMessageEncoder		m_messageEncoder;		/**< Encoder with cached address and type tag prefixes of the sent messages. */
+	char					m_sendBuffer[OSCMessageEncoder::MaxMessageSize];	/**< Reusable buffer the messages are encoded into. */
+	DatagramSendBatch		m_sendBatch;			/**< Batch of packets to be sent with a single syscall where supported. */
+	OSCBundlePacker			m_bundlePacker;			/**< Packer accumulating outgoing messages into bundles, if bundling is enabled. */
+	int						m_bundleWindow;			/**< Time window outgoing messages are accumulated in bundles, in ms. 0 if bundling is disabled. */
+	std::vector<RemoteObjectMessageCopy>	m_releasedMessages;	/**< Preallocated buffer to take the messages released by the rate limiter. */
+	std::vector<RemoteObjectMessageCopy>	m_dueSubscriptionValues;	/**< Preallocated buffer to take the subscription values that are due to be pushed. */
+	CriticalSection			m_sendLock;				/**< Lock to protect the encoder, buffer and socket, since messages are sent from engine and timer threads. */
 	SenderAwareOSCReceiver	m_oscReceiver;			/**< An OSCReceiver object can connect to a network port, receive incoming OSC packets from the network
 													   * via UDP, parse them, and forward the included OSCMessage and OSCBundle objects to its listeners. */
 	int						m_oscMsgRate;			/**< Interval at which OSC messages are sent to the host, in ms. */
+	std::map<RemoteObjectIdentifier, int>	m_pollingTiers;	/**< Individual polling intervals in ms per remote object id, overriding m_oscMsgRate. */
 	Array<RemoteObject>		m_activeRemoteObjects;	/**< List of remote objects to be activly handled. */
+	OSCPollPlanner			m_pollPlanner;			/**< Planner reducing the active remote objects to the minimal set of poll queries. */
+	OSCPollingScheduler		m_pollingScheduler;		/**< Scheduler spreading the poll messages of the active remote objects across their polling intervals. */
+	OSCSubscriptionFilter	m_subscriptionFilter;	/**< The objects the client subscribed to, to only push their changed values to it. */
+	ProcessorTimer			m_processorTimer;		/**< Timer running the periodic tasks, ticking at the shortest active task interval. */
+	int						m_timerTaskIntervals[TT_UserMAX];	/**< The interval in ms per periodic task. 0 if the task is inactive. */
+	double					m_timerTaskDueTimes[TT_UserMAX];	/**< The time in ms each active periodic task is due next. */
+	int						m_timerTickInterval;	/**< The interval in ms the processor timer ticks in. 0 if it is stopped. */
+	CriticalSection			m_timerTaskLock;		/**< Lock to protect the task intervals and due times, since they are checked on the timer thread. */
+	CriticalSection			m_timerUpdateLock;		/**< Lock to serialize the updates of the processor timer. Never taken on the timer thread. */
+	bool					m_useRealtimeCallback;	/**< Flag if received messages are handled directly on the network thread instead of the message loop. */
+	SenderEndpoint			m_senderEndpoint;		/**< Numeric endpoint of the configured ip, used to only receive data from it. Invalid if the ip is no IPv4 address. */
 };
@@ -0,0 +1,192 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "OSCRawMessageDecoder.h"
+
+#include "OSCAddressTable.h"
+
+
+// **************************************************************************************
+//    class OSCRawMessageDecoder
+// **************************************************************************************
+/**
+ * Helper method to check if the given packet data is an OSC bundle.
+ *
+ * @param data		The raw packet data.
+ * @param dataSize	The size of the raw packet data.
+ * @return	True if the data starts with a bundle header.
+ */
+bool OSCRawMessageDecoder::IsBundle(const char* data, size_t dataSize)
+{
+	return dataSize >= BundleHeaderSize && memcmp(data, "#bundle", 8) == 0;
+}
+
+/**
+ * Method to decode a single OSC message into the given message object.
+ * Addressing values and arguments are read in place from the raw buffer.
+ *
+ * @param data		The raw message data.
+ * @param dataSize	The size of the raw message data.
+ * @param message	The message object to fill with the decoded data.
+ * @return	The decoding result. The message object is only valid for DR_Decoded.
+ */
+OSCRawMessageDecoder::DecodeResult OSCRawMessageDecoder::DecodeMessage(const char* data, size_t dataSize, RemoteObjectMessageCopy& message)
+{
+	if (dataSize < 4 || data[0] != '/')
+		return DR_Malformed;
+
+	// address pattern string
+	size_t readPos = 0;
+	size_t addressLength = 0;
+	if (!ReadPaddedString(data, dataSize, readPos, addressLength))
+		return DR_Malformed;
+
+	// type tag string
+	size_t typeTagPos = readPos;
+	size_t typeTagLength = 0;
+	if (!ReadPaddedString(data, dataSize, readPos, typeTagLength) || typeTagLength < 1 || data[typeTagPos] != ',')
+		return DR_Malformed;
+	const char* typeTags = data + typeTagPos + 1;
+	size_t argumentCount = typeTagLength - 1;
+
+	// lookup of the address and the appended addressing values
+	RemoteObjectAddressing addressing;
+	const OSCAddressTable::Entry* knownAddress = OSCAddressTable::Lookup(data, addressLength, addressing);
+	if (knownAddress == nullptr)
+		return DR_UnknownAddress;
+
+	message.Id = knownAddress->Id;
+	message.addrVal.first = INVALID_ADDRESS_VALUE;
+	message.addrVal.second = INVALID_ADDRESS_VALUE;
+	message.valType = ROVT_NONE;
+	message.valCount = 0;
+
+	// heartbeat messages do not carry anything else
+	if (knownAddress->AddressingCount == 0)
+		return DR_Decoded;
+
+	if (addressing.first <= 0 || (knownAddress->AddressingCount == 2 && addressing.second <= 0))
+		return DR_Malformed;
+	message.addrVal = addressing;
+
+	// value object messages without values are polls for the current value
+	if (argumentCount == 0)
+		return DR_Decoded;
+
+	// argument values, big endian
+	if (argumentCount < knownAddress->ValCount || dataSize - readPos < size_t(4 * knownAddress->ValCount))
+		return DR_Malformed;
+
+	for (int i = 0; i < knownAddress->ValCount; ++i)
+	{
+		uint32 rawValue = ByteOrder::bigEndianInt(data + readPos + 4 * i);
+		float floatValue;
+		int intValue;
+		switch (typeTags[i])
+		{
+		case 'f':
+			memcpy(&floatValue, &rawValue, sizeof(float));
+			if (!FloatToInt(floatValue, intValue))
+				return DR_Malformed;
+			break;
+		case 'i':
+			intValue = int(rawValue);
+			floatValue = float(intValue);
+			break;
+		default:
+			return DR_Malformed;
+		}
+
+		// some OSC appliances can only process floats, so int values are accepted as float as well (and vice versa)
+		if (knownAddress->ValType == ROVT_INT)
+			message.values.intValues[i] = intValue;
+		else
+			message.values.floatValues[i] = floatValue;
+	}
+
+	message.valType = knownAddress->ValType;
+	message.valCount = knownAddress->ValCount;
+
+	return DR_Decoded;
+}
+
+/**
+ * Helper method to convert a received float value to the nearest int value.
+ * Values outside of the int range are clamped to it. NaN and infinity are rejected,
+ * since they cannot be converted and must not be passed on to the devices.
+ *
+ * @param floatValue	The float value to convert.
+ * @param intValue		The converted int value. Only valid on success.
+ * @return	True on success, false if the float value is not finite.
+ */
+bool OSCRawMessageDecoder::FloatToInt(float floatValue, int& intValue)
+{
+	if (!std::isfinite(floatValue))
+		return false;
+
+	double roundedValue = std::round(double(floatValue));
+	intValue = int(jlimit(double(std::numeric_limits<int>::min()), double(std::numeric_limits<int>::max()), roundedValue));
+
+	return true;
+}
+
+/**
+ * Helper method to read a zero terminated and zero padded OSC string.
+ *
+ * @param data			The raw message data.
+ * @param dataSize		The size of the raw message data.
+ * @param readPos		The position to start reading at. Is moved behind the string padding on success.
+ * @param stringLength	The length of the string that was read, without terminator.
+ * @return	True on success, false if the data ends before the string padding does.
+ */
+bool OSCRawMessageDecoder::ReadPaddedString(const char* data, size_t dataSize, size_t& readPos, size_t& stringLength)
+{
+	if (readPos >= dataSize)
+		return false;
+
+	const char* terminator = static_cast<const char*>(memchr(data + readPos, '\0', dataSize - readPos));
+	if (terminator == nullptr)
+		return false;
+
+	stringLength = size_t(terminator - (data + readPos));
+
+	size_t paddedLength = (stringLength + 4) & ~size_t(3);
+	if (paddedLength > dataSize - readPos)
+		return false;
+
+	readPos += paddedLength;
+
+	return true;
+}
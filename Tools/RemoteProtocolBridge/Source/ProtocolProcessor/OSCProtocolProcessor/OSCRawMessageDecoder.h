@@ -0,0 +1,149 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class OSCRawMessageDecoder decodes received OSC datagrams of the known d&b remote objects
+ * directly from the raw udp buffer into remote object messages.
+ * In contrast to JUCEs' OSC stream parsing, no OSCMessage/String objects are created,
+ * no heap memory is allocated and malformed input is reported by return value instead of exceptions.
+ */
+class OSCRawMessageDecoder
+{
+public:
+	/**
+	 * Result of decoding a chunk of raw OSC data.
+	 */
+	enum DecodeResult
+	{
+		DR_Decoded = 0,		/**< The data was decoded to one or more remote object messages. */
+		DR_Ignored,			/**< The data is valid, but does not carry anything to be handled (e.g. an empty bundle). */
+		DR_UnknownAddress,	/**< The data contains an address that is not known to the decoder and has to be handled otherwise. */
+		DR_Malformed		/**< The data is not valid OSC or does not match the expected remote object format. */
+	};
+
+public:
+	static bool IsBundle(const char* data, size_t dataSize);
+	static DecodeResult DecodeMessage(const char* data, size_t dataSize, RemoteObjectMessageCopy& message);
+	static bool FloatToInt(float floatValue, int& intValue);
+
+	/**
+	 * Method to decode a complete received OSC packet, that can either be a single message or a (nested) bundle.
+	 * Bundles are checked to be completely decodable first, to never deliver parts of a bundle
+	 * that afterwards has to be handed to a fallback decoder as a whole.
+	 *
+	 * @param data		The raw packet data.
+	 * @param dataSize	The size of the raw packet data.
+	 * @param onMessage	The callable to be invoked with every decoded RemoteObjectMessageCopy.
+	 * @return	The overall decoding result of the packet.
+	 */
+	template <typename Callback>
+	static DecodeResult DecodePacket(const char* data, size_t dataSize, Callback&& onMessage)
+	{
+		if (IsBundle(data, dataSize))
+		{
+			DecodeResult dryRunResult = WalkPacket(data, dataSize, [](RemoteObjectMessageCopy&) {}, 0);
+			if (dryRunResult != DR_Decoded)
+				return dryRunResult;
+		}
+
+		return WalkPacket(data, dataSize, onMessage, 0);
+	}
+
+private:
+	/**
+	 * Helper method to recursively walk through the given packet data and decode all contained messages.
+	 *
+	 * @param data		The raw packet data.
+	 * @param dataSize	The size of the raw packet data.
+	 * @param onMessage	The callable to be invoked with every decoded RemoteObjectMessageCopy.
+	 * @param depth		The current bundle nesting depth.
+	 * @return	The decoding result. For bundles, the first result that is not DR_Decoded or DR_Ignored is returned.
+	 */
+	template <typename Callback>
+	static DecodeResult WalkPacket(const char* data, size_t dataSize, Callback&& onMessage, int depth)
+	{
+		if (!IsBundle(data, dataSize))
+		{
+			RemoteObjectMessageCopy message;
+			DecodeResult result = DecodeMessage(data, dataSize, message);
+			if (result == DR_Decoded)
+				onMessage(message);
+
+			return result;
+		}
+
+		if (depth >= MaxBundleDepth)
+			return DR_Malformed;
+
+		// skip '#bundle' string and timetag
+		DecodeResult bundleResult = DR_Ignored;
+		size_t readPos = BundleHeaderSize;
+		while (readPos < dataSize)
+		{
+			if (dataSize - readPos < 4)
+				return DR_Malformed;
+
+			size_t elementSize = ByteOrder::bigEndianInt(data + readPos);
+			readPos += 4;
+			if (elementSize < 4 || (elementSize % 4) != 0 || elementSize > dataSize - readPos)
+				return DR_Malformed;
+
+			DecodeResult elementResult = WalkPacket(data + readPos, elementSize, onMessage, depth + 1);
+			if (elementResult == DR_UnknownAddress || elementResult == DR_Malformed)
+				return elementResult;
+			else if (elementResult == DR_Decoded)
+				bundleResult = DR_Decoded;
+
+			readPos += elementSize;
+		}
+
+		return bundleResult;
+	}
+
+	static bool ReadPaddedString(const char* data, size_t dataSize, size_t& readPos, size_t& stringLength);
+
+	enum DecoderConstants
+	{
+		BundleHeaderSize	= 16,	/**< Size of '#bundle' string incl. padding and the following timetag. */
+		MaxBundleDepth		= 8		/**< Max. accepted nesting depth of bundles. */
+	};
+};
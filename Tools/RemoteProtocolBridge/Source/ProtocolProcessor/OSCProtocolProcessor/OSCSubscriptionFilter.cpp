@@ -0,0 +1,283 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#include "OSCSubscriptionFilter.h"
+
+#include "../../ProcessingEngineConfig.h"
+
+
+// **************************************************************************************
+//    class OSCSubscriptionFilter
+// **************************************************************************************
+/**
+ * Constructor
+ */
+OSCSubscriptionFilter::OSCSubscriptionFilter()
+{
+	m_minPushInterval = 0;
+	m_pendingCount = 0;
+}
+
+/**
+ * Destructor
+ */
+OSCSubscriptionFilter::~OSCSubscriptionFilter()
+{
+}
+
+/**
+ * Setter for the max. rate changed values of a subscribed object are pushed in.
+ *
+ * @param maxRate	The max. rate in updates per second. 0 to push every change right away.
+ */
+void OSCSubscriptionFilter::SetMaxRate(int maxRate)
+{
+	const ScopedLock l(m_lock);
+
+	m_minPushInterval = maxRate > 0 ? 1000.0 / maxRate : 0;
+}
+
+/**
+ * Method to replace all subscriptions by the given objects, e.g. the subscriptions from the configuration.
+ *
+ * @param objects	The remote objects to subscribe to. Empty to push every value as without subscriptions.
+ */
+void OSCSubscriptionFilter::SetSubscriptions(const Array<RemoteObject>& objects)
+{
+	Clear();
+
+	for (const RemoteObject& object : objects)
+		Subscribe(object);
+}
+
+/**
+ * Method to add a subscription. The next value of the object is pushed regardless of its last pushed value.
+ *
+ * @param object	The remote object to subscribe to.
+ */
+void OSCSubscriptionFilter::Subscribe(const RemoteObject& object)
+{
+	const ScopedLock l(m_lock);
+
+	uint64 key = GetRemoteObjectKey(object.Id, object.Addr);
+	if (m_entryIndices.count(key) > 0)
+		return;
+
+	SubscriptionEntry entry;
+	entry.Object = object;
+	entry.HasValue = false;
+	entry.LastPushTime = 0;
+	entry.HasPending = false;
+
+	m_entryIndices[key] = static_cast<int>(m_entries.size());
+	m_entries.push_back(entry);
+}
+
+/**
+ * Method to remove a subscription.
+ *
+ * @param object	The remote object to unsubscribe from.
+ */
+void OSCSubscriptionFilter::Unsubscribe(const RemoteObject& object)
+{
+	const ScopedLock l(m_lock);
+
+	auto index = m_entryIndices.find(GetRemoteObjectKey(object.Id, object.Addr));
+	if (index == m_entryIndices.end())
+		return;
+
+	// move the last entry into the gap to keep the entries contiguous
+	int removedIndex = index->second;
+	m_entryIndices.erase(index);
+	if (m_entries[static_cast<size_t>(removedIndex)].HasPending)
+		--m_pendingCount;
+
+	int lastIndex = static_cast<int>(m_entries.size()) - 1;
+	if (removedIndex != lastIndex)
+	{
+		m_entries[static_cast<size_t>(removedIndex)] = m_entries[static_cast<size_t>(lastIndex)];
+		const RemoteObject& moved = m_entries[static_cast<size_t>(removedIndex)].Object;
+		m_entryIndices[GetRemoteObjectKey(moved.Id, moved.Addr)] = removedIndex;
+	}
+	m_entries.pop_back();
+}
+
+/**
+ * Method to remove all subscriptions. Every value is pushed to the client again afterwards.
+ */
+void OSCSubscriptionFilter::Clear()
+{
+	const ScopedLock l(m_lock);
+
+	m_entries.clear();
+	m_entryIndices.clear();
+	m_pendingCount = 0;
+}
+
+/**
+ * Getter for the active state of the filter.
+ *
+ * @return	True if the client is subscribed to any object, false if every value is to be sent to it.
+ */
+bool OSCSubscriptionFilter::IsActive() const
+{
+	const ScopedLock l(m_lock);
+
+	return !m_entries.empty();
+}
+
+/**
+ * Getter for the rate limited state of the filter.
+ *
+ * @return	True if the client is subscribed to any object and a max. rate is set, false otherwise.
+ */
+bool OSCSubscriptionFilter::IsRateLimited() const
+{
+	const ScopedLock l(m_lock);
+
+	return !m_entries.empty() && m_minPushInterval > 0;
+}
+
+/**
+ * Getter for the number of subscribed objects.
+ *
+ * @return	The number of subscribed objects.
+ */
+int OSCSubscriptionFilter::GetSubscriptionCount() const
+{
+	const ScopedLock l(m_lock);
+
+	return static_cast<int>(m_entries.size());
+}
+
+/**
+ * Method to decide if a value is to be sent to the client right away.
+ * Without subscriptions, every value is sent. Otherwise only changed values of subscribed objects are,
+ * and only if the max. rate allows to push the object again. A changed value that is held back by the
+ * max. rate is pushed later by TakeDue.
+ * Value-less messages are not filtered.
+ *
+ * @param Id		The remote object id of the value.
+ * @param msgData	The message data of the value.
+ * @param precision	The precision changes of float values are detected with.
+ * @param now		The current time, in ms.
+ * @return	True if the value is to be sent right away, false if it is dropped or held back.
+ */
+bool OSCSubscriptionFilter::Filter(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, float precision, double now)
+{
+	const ScopedLock l(m_lock);
+
+	if (m_entries.empty() || msgData.valCount == 0)
+		return true;
+
+	auto index = m_entryIndices.find(GetRemoteObjectKey(Id, msgData.addrVal));
+	if (index == m_entryIndices.end())
+		return false;
+
+	SubscriptionEntry& entry = m_entries[static_cast<size_t>(index->second)];
+
+	bool changed = !entry.HasValue || ProcessingEngineConfig::IsChangedValue(entry.LastValue.valType, entry.LastValue.valCount, &entry.LastValue.values, msgData, precision);
+	if (!changed)
+	{
+		// the value returned to the last pushed one, so a held back change is obsolete
+		if (entry.HasPending)
+		{
+			entry.HasPending = false;
+			--m_pendingCount;
+		}
+
+		return false;
+	}
+
+	if (entry.HasValue && now - entry.LastPushTime < m_minPushInterval)
+	{
+		if (entry.PendingValue.Set(0, Id, msgData) && !entry.HasPending)
+		{
+			entry.HasPending = true;
+			++m_pendingCount;
+		}
+
+		return false;
+	}
+
+	entry.HasValue = entry.LastValue.Set(0, Id, msgData);
+	entry.LastPushTime = now;
+	if (entry.HasPending)
+	{
+		entry.HasPending = false;
+		--m_pendingCount;
+	}
+
+	return true;
+}
+
+/**
+ * Method to take the held back values whose objects are due to be pushed again.
+ * The values are copied out, so they can be sent without holding the lock of the filter.
+ * Due values that do not fit into the given array stay held back until the next call.
+ *
+ * @param now		The current time, in ms.
+ * @param values	The preallocated array to copy the due values into.
+ * @param maxCount	The size of the given array.
+ * @return	The count of due values.
+ */
+int OSCSubscriptionFilter::TakeDue(double now, RemoteObjectMessageCopy* values, int maxCount)
+{
+	const ScopedLock l(m_lock);
+
+	if (m_pendingCount == 0)
+		return 0;
+
+	int dueCount = 0;
+	for (SubscriptionEntry& entry : m_entries)
+	{
+		if (dueCount >= maxCount)
+			break;
+
+		if (!entry.HasPending || now - entry.LastPushTime < m_minPushInterval)
+			continue;
+
+		entry.HasPending = false;
+		entry.HasValue = true;
+		entry.LastValue = entry.PendingValue;
+		entry.LastPushTime = now;
+		--m_pendingCount;
+
+		values[dueCount++] = entry.LastValue;
+	}
+
+	return dueCount;
+}
@@ -0,0 +1,96 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#pragma once
+
+#include "../../RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+#include <unordered_map>
+
+
+/**
+ * Class OSCSubscriptionFilter holds the remote objects an OSC client subscribed to and filters the
+ * values sent to the client accordingly. Once the client is subscribed to any object, only changed
+ * values of the subscribed objects are pushed to it, so it is kept up to date by the bridges' own
+ * upstream polling without having to poll itself.
+ * With a max. rate set, a subscribed objects' changed values are pushed at most in that rate.
+ * Changes in between are held back and the latest one is pushed when the object is due again.
+ */
+class OSCSubscriptionFilter
+{
+public:
+	OSCSubscriptionFilter();
+	~OSCSubscriptionFilter();
+
+	void SetMaxRate(int maxRate);
+	void SetSubscriptions(const Array<RemoteObject>& objects);
+	void Subscribe(const RemoteObject& object);
+	void Unsubscribe(const RemoteObject& object);
+	void Clear();
+
+	bool IsActive() const;
+	bool IsRateLimited() const;
+	int GetSubscriptionCount() const;
+
+	bool Filter(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, float precision, double now);
+
+	int TakeDue(double now, RemoteObjectMessageCopy* values, int maxCount);
+
+private:
+	/**
+	 * Push state of a single subscribed remote object.
+	 */
+	struct SubscriptionEntry
+	{
+		RemoteObject			Object;			/**< The subscribed remote object. */
+		bool					HasValue;		/**< Indication if a value of the object was pushed yet. */
+		RemoteObjectMessageCopy	LastValue;		/**< The last value pushed to the client, to detect value changes. */
+		double					LastPushTime;	/**< The time the last value was pushed, in ms. */
+		bool					HasPending;		/**< Indication if a changed value is held back by the max. rate. */
+		RemoteObjectMessageCopy	PendingValue;	/**< The latest changed value held back by the max. rate. */
+	};
+
+
+	CriticalSection					m_lock;				/**< Lock to protect the subscriptions, since they are changed from the network thread and filtered from the engine and timer threads. */
+	std::vector<SubscriptionEntry>	m_entries;			/**< The push state of all subscribed objects. */
+	std::unordered_map<uint64, int>	m_entryIndices;		/**< Lookup of the entry indices by remote object id and addressing. */
+	double							m_minPushInterval;	/**< The min. interval in ms between two values pushed for the same object. 0 if every change is pushed. */
+	int								m_pendingCount;		/**< The count of entries holding back a changed value. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OSCSubscriptionFilter)
+};
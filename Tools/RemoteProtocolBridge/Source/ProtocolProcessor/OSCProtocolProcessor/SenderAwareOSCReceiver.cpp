@@ -33,6 +33,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "SenderAwareOSCReceiver.h"
+#include "DatagramBatchIO.h"
+
+#include <unordered_map>
 
 
 namespace SenderAwareOSC
@@ -405,20 +408,32 @@ namespace SenderAwareOSC
 		 * Method to add a Listener to internal list.
 		 *
 		 * @param listenerToAdd	The listener object to add.
+		 * @param sender		The sender endpoint the listener shall be called for. Invalid to be called for all senders.
 		 */
-		void addListener(SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>* listenerToAdd)
+		void addListener(SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>* listenerToAdd, const SenderEndpoint& sender = SenderEndpoint())
 		{
-			listeners.add(listenerToAdd);
+			const ScopedLock l(demuxLock);
+
+			if (sender.isValid())
+				listenerDemux[sender.getKey()].addIfNotAlreadyThere(listenerToAdd);
+			else
+				listeners.add(listenerToAdd);
 		}
 
 		/**
 		 * Method to add a Listener to internal list.
 		 *
 		 * @param listenerToAdd	The listener object to add.
+		 * @param sender		The sender endpoint the listener shall be called for. Invalid to be called for all senders.
 		 */
-		void addListener(SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>* listenerToAdd)
+		void addListener(SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>* listenerToAdd, const SenderEndpoint& sender = SenderEndpoint())
 		{
-			realtimeListeners.add(listenerToAdd);
+			const ScopedLock l(demuxLock);
+
+			if (sender.isValid())
+				realtimeListenerDemux[sender.getKey()].addIfNotAlreadyThere(listenerToAdd);
+			else
+				realtimeListeners.add(listenerToAdd);
 		}
 
 		/**
@@ -428,7 +443,15 @@ namespace SenderAwareOSC
 		 */
 		void removeListener(SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>* listenerToRemove)
 		{
-			listeners.remove(listenerToRemove);
+			{
+				const ScopedLock l(demuxLock);
+
+				listeners.remove(listenerToRemove);
+				removeDemuxListener(listenerToRemove, listenerDemux);
+			}
+
+			// wait for a dispatch that may still call the listener to finish
+			const ScopedLock dl(dispatchLock);
 		}
 
 		/**
@@ -438,7 +461,15 @@ namespace SenderAwareOSC
 		 */
 		void removeListener(SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>* listenerToRemove)
 		{
-			realtimeListeners.remove(listenerToRemove);
+			{
+				const ScopedLock l(demuxLock);
+
+				realtimeListeners.remove(listenerToRemove);
+				removeDemuxListener(listenerToRemove, realtimeListenerDemux);
+			}
+
+			// wait for a dispatch that may still call the listener to finish
+			const ScopedLock dl(realtimeDispatchLock);
 		}
 
 		//==============================================================================
@@ -461,44 +492,133 @@ namespace SenderAwareOSC
 			* @param oscElement	The osc element data to use in this message.
 			* @param sndIP	The sender ip of this message.
 			* @param sndPort The port this message was received on.
+			* @param snd	The numeric sender endpoint of this message.
 			*/
-			CallbackMessage(OSCBundle::Element oscElement, String sndIP, int sndPort) : content(oscElement), senderIPAddress(sndIP), senderPort(sndPort) {}
+			CallbackMessage(OSCBundle::Element oscElement, String sndIP, int sndPort, const SenderEndpoint& snd) : content(oscElement), senderIPAddress(sndIP), senderPort(sndPort), sender(snd) {}
 
 			OSCBundle::Element	content;			/**< The payload of the message. Can be either an OSCMessage or an OSCBundle. */
 			String				senderIPAddress;	/**< The sender ip address from whom the message was received. */
 			int					senderPort;			/**< The sender port from where the message was received. */
+			SenderEndpoint		sender;				/**< The numeric sender endpoint, used to look up the listeners registered for it. */
+		};
+
+		//==============================================================================
+		/**
+		 * Helper to parse a received data buffer and to convert the sender address to a String at most once,
+		 * and only if a listener actually requires it.
+		 */
+		struct ReceivedData
+		{
+			ReceivedData(const char* d, size_t size, const SenderEndpoint& snd) : data(d), dataSize(size), sender(snd) {}
+
+			/**
+			 * Getter for the parsed OSC content of the received data. The data is parsed on first call.
+			 *
+			 * @param errorHandler	The format error handler to call if the data cannot be parsed.
+			 * @return	The parsed content, nullptr if the data is no valid OSC content.
+			 */
+			const OSCBundle::Element* getContent(const OSCReceiver::FormatErrorHandler& errorHandler)
+			{
+				if (!content && !parseFailed)
+				{
+					SenderAwareOSCInputStream inStream(data, dataSize);
+
+					try
+					{
+						content = std::make_unique<OSCBundle::Element>(inStream.readElementWithKnownSize(dataSize));
+					}
+					catch (const OSCFormatError&)
+					{
+						parseFailed = true;
+
+						if (errorHandler != nullptr)
+							errorHandler(data, (int)dataSize);
+					}
+				}
+
+				return content.get();
+			}
+
+			/**
+			 * Getter for the sender ip address string. The string is created on first call.
+			 *
+			 * @return	The sender ip address string.
+			 */
+			const String& getSenderIPAddress()
+			{
+				if (senderIPAddress.isEmpty())
+					senderIPAddress = sender.getAddressString();
+
+				return senderIPAddress;
+			}
+
+			const char*								data;				/**< The received data buffer. */
+			size_t									dataSize;			/**< The received data buffer size. */
+			SenderEndpoint							sender;				/**< The numeric sender endpoint of the received data. */
+			std::unique_ptr<OSCBundle::Element>		content;			/**< The parsed content, created on demand. */
+			bool									parseFailed{ false };	/**< Flag if parsing was tried and failed. */
+			String									senderIPAddress;	/**< The sender ip address string, created on demand. */
 		};
 
 		//==============================================================================
 		/**
 		 * Method to run to process received data buffer, incl. handling of ip and port the data originates from.
+		 * The data is only passed to the listeners registered for its sender and to the ones registered for all senders.
+		 * The listeners are collected under the registration lock, but called after releasing it,
+		 * so a listener that takes long does not block the dispatch on the other thread.
 		 *
 		 * @param data		The data buffer to handle.
 		 * @param dataSize	The data buffer size.
-		 * @param senderIPAddress	The ip the received data originates from.
-		 * @param senderPort	The port the data was received on.
+		 * @param sender	The numeric endpoint the received data originates from.
 		 */
-		void handleBuffer(const char* data, size_t dataSize, String& senderIPAddress, int& senderPort)
+		void handleBuffer(const char* data, size_t dataSize, const SenderEndpoint& sender)
 		{
-			SenderAwareOSCInputStream inStream(data, dataSize);
+			using RealtimeListener = SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>;
 
-			try
+			bool hasMessageLoopListeners = false;
 			{
-				auto content = inStream.readElementWithKnownSize(dataSize);
+				const ScopedLock l(demuxLock);
 
-				// realtime listeners should receive the OSC content first - and immediately
-				// on this thread:
-				callRealtimeListeners(content, senderIPAddress, senderPort);
+				realtimeDispatchListeners.clearQuick();
+				for (auto* listener : realtimeListeners.getListeners())
+					realtimeDispatchListeners.add(listener);
+				forEachDemuxListener(realtimeListenerDemux, sender, [this](RealtimeListener* listener) { realtimeDispatchListeners.add(listener); });
 
-				// now post the message that will trigger the handleMessage callback
-				// dealing with the non-realtime listeners.
-				if (listeners.size() > 0)
-					postMessage(new CallbackMessage(content, senderIPAddress, senderPort));
+				hasMessageLoopListeners = listeners.size() > 0 || hasDemuxListeners(listenerDemux, sender);
 			}
-			catch (const OSCFormatError&)
+
+			ReceivedData received(data, dataSize, sender);
+
+			// realtime listeners should receive the OSC content first - and immediately on this thread.
+			// They are offered the raw data first, to be able to decode it without the overhead
+			// of creating OSC objects. Only the ones that did not handle it get the parsed content.
+			auto callRealtimeListener = [&](RealtimeListener* listener)
 			{
-				if (formatErrorHandler != nullptr)
-					formatErrorHandler(data, (int)dataSize);
+				if (listener->oscRawDataReceived(data, dataSize, sender))
+					return;
+
+				if (auto* content = received.getContent(formatErrorHandler))
+				{
+					if (content->isMessage())
+						listener->oscMessageReceived(content->getMessage(), received.getSenderIPAddress(), sender.port);
+					else if (content->isBundle())
+						listener->oscBundleReceived(content->getBundle(), received.getSenderIPAddress(), sender.port);
+				}
+			};
+
+			{
+				const ScopedLock dl(realtimeDispatchLock);
+
+				for (auto* listener : realtimeDispatchListeners)
+					callRealtimeListener(listener);
+			}
+
+			// now post the message that will trigger the handleMessage callback
+			// dealing with the non-realtime listeners.
+			if (hasMessageLoopListeners)
+			{
+				if (auto* content = received.getContent(formatErrorHandler))
+					postMessage(new CallbackMessage(*content, received.getSenderIPAddress(), sender.port, sender));
 			}
 		}
 
@@ -560,11 +680,8 @@ namespace SenderAwareOSC
 		//==============================================================================
 		void run() override
 		{
-			int bufferSize = 65535;
-			HeapBlock<char> oscBuffer(bufferSize);
-
-			String senderIPAddress;
-			int senderPortNumber;
+			// on Linux, all datagrams pending on the socket are read with a single call
+			DatagramReceiveBatch receiveBatch;
 
 			while (!threadShouldExit())
 			{
@@ -577,10 +694,13 @@ namespace SenderAwareOSC
 				if (ready == 0)
 					continue;
 
-				auto bytesRead = (size_t)socket->read(oscBuffer.getData(), bufferSize, false, senderIPAddress, senderPortNumber);
+				auto receivedCount = receiveBatch.Receive(*socket);
 
-				if (bytesRead >= 4)
-					handleBuffer(oscBuffer.getData(), bytesRead, senderIPAddress, senderPortNumber);
+				for (int i = 0; i < receivedCount; ++i)
+				{
+					if (receiveBatch.GetSize(i) >= 4)
+						handleBuffer(receiveBatch.GetData(i), receiveBatch.GetSize(i), receiveBatch.GetSender(i));
+				}
 			}
 		}
 
@@ -616,6 +736,74 @@ namespace SenderAwareOSC
 			}
 		}
 
+		//==============================================================================
+		template <typename ListenerType>
+		using DemuxTable = std::unordered_map<uint64, Array<ListenerType*>>;
+
+		/**
+		 * Method to call a function for all listeners registered for a sender endpoint, either for
+		 * exactly its address and port or for its address on any port.
+		 *
+		 * @param table		The demux table to look up the listeners in.
+		 * @param sender	The sender endpoint to call the listeners of.
+		 * @param callback	The function to call for each listener.
+		 */
+		template <typename ListenerType, typename Callback>
+		static void forEachDemuxListener(const DemuxTable<ListenerType>& table, const SenderEndpoint& sender, Callback&& callback)
+		{
+			if (table.empty() || !sender.isValid())
+				return;
+
+			auto exactMatch = table.find(sender.getKey());
+			if (exactMatch != table.end())
+				for (auto* listener : exactMatch->second)
+					callback(listener);
+
+			if (sender.port != 0)
+			{
+				auto addressMatch = table.find(sender.withAnyPort().getKey());
+				if (addressMatch != table.end())
+					for (auto* listener : addressMatch->second)
+						callback(listener);
+			}
+		}
+
+		/**
+		 * Helper to check if any listener is registered for a sender endpoint.
+		 *
+		 * @param table		The demux table to look up the listeners in.
+		 * @param sender	The sender endpoint to check.
+		 * @return	True if at least one listener is registered for the sender.
+		 */
+		template <typename ListenerType>
+		static bool hasDemuxListeners(const DemuxTable<ListenerType>& table, const SenderEndpoint& sender)
+		{
+			bool found = false;
+			forEachDemuxListener(table, sender, [&found](ListenerType*) { found = true; });
+
+			return found;
+		}
+
+		/**
+		 * Helper to remove a listener from all sender endpoints it is registered for.
+		 *
+		 * @param listenerToRemove	The listener to remove.
+		 * @param table				The demux table to remove the listener from.
+		 */
+		template <typename ListenerType>
+		static void removeDemuxListener(ListenerType* listenerToRemove, DemuxTable<ListenerType>& table)
+		{
+			for (auto it = table.begin(); it != table.end(); )
+			{
+				it->second.removeAllInstancesOf(listenerToRemove);
+
+				if (it->second.isEmpty())
+					it = table.erase(it);
+				else
+					++it;
+			}
+		}
+
 		//==============================================================================
 		void handleMessage(const Message& msg) override
 		{
@@ -625,41 +813,36 @@ namespace SenderAwareOSC
 				auto& senderIPAddress = callbackMessage->senderIPAddress;
 				auto& senderPort = callbackMessage->senderPort;
 
-				callListeners(content, senderIPAddress, senderPort);
+				callListeners(content, senderIPAddress, senderPort, callbackMessage->sender);
 			}
 		}
 
 		//==============================================================================
-		void callListeners(const OSCBundle::Element& content, const String& senderIPAddress, const int& senderPort)
+		void callListeners(const OSCBundle::Element& content, const String& senderIPAddress, const int& senderPort, const SenderEndpoint& sender)
 		{
 			using Listener = SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>;
 
-			if (content.isMessage())
-			{
-				auto&& message = content.getMessage();
-				listeners.call([&](Listener& l) { l.oscMessageReceived(message, senderIPAddress, senderPort); });
-			}
-			else if (content.isBundle())
 			{
-				auto&& bundle = content.getBundle();
-				listeners.call([&](Listener& l) { l.oscBundleReceived(bundle, senderIPAddress, senderPort); });
+				const ScopedLock l(demuxLock);
+
+				dispatchListeners.clearQuick();
+				for (auto* listener : listeners.getListeners())
+					dispatchListeners.add(listener);
+				forEachDemuxListener(listenerDemux, sender, [this](Listener* listener) { dispatchListeners.add(listener); });
 			}
-		}
 
-		void callRealtimeListeners(const OSCBundle::Element& content, const String& senderIPAddress, const int& senderPort)
-		{
-			using Listener = SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>;
+			const ScopedLock dl(dispatchLock);
 
-			if (content.isMessage())
+			auto callListener = [&](Listener* listener)
 			{
-				auto&& message = content.getMessage();
-				realtimeListeners.call([&](Listener& l) { l.oscMessageReceived(message, senderIPAddress, senderPort); });
-			}
-			else if (content.isBundle())
-			{
-				auto&& bundle = content.getBundle();
-				realtimeListeners.call([&](Listener& l) { l.oscBundleReceived(bundle, senderIPAddress, senderPort); });
-			}
+				if (content.isMessage())
+					listener->oscMessageReceived(content.getMessage(), senderIPAddress, senderPort);
+				else if (content.isBundle())
+					listener->oscBundleReceived(content.getBundle(), senderIPAddress, senderPort);
+			};
+
+			for (auto* listener : dispatchListeners)
+				callListener(listener);
 		}
 
 		//==============================================================================
@@ -690,6 +873,15 @@ namespace SenderAwareOSC
 		ListenerList<SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>> listeners;
 		ListenerList<SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>>    realtimeListeners;
 
+		DemuxTable<SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>>	listenerDemux;			/**< Message loop listeners registered for specific senders, keyed by SenderEndpoint::getKey. */
+		DemuxTable<SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>>		realtimeListenerDemux;	/**< Realtime listeners registered for specific senders, keyed by SenderEndpoint::getKey. */
+		CriticalSection	demuxLock;	/**< Lock to protect the listener registrations against concurrent modification while the listeners to call are collected. */
+
+		Array<SenderAwareOSCReceiver::SAOListener<OSCReceiver::MessageLoopCallback>*>	dispatchListeners;			/**< The message loop listeners collected for the current dispatch. Only used on the message thread. */
+		Array<SenderAwareOSCReceiver::SAOListener<OSCReceiver::RealtimeCallback>*>		realtimeDispatchListeners;	/**< The realtime listeners collected for the current dispatch. Only used on the network thread. */
+		CriticalSection	dispatchLock;			/**< Lock held while message loop listeners are called, for removeListener to wait for a running dispatch. */
+		CriticalSection	realtimeDispatchLock;	/**< Lock held while realtime listeners are called, for removeListener to wait for a running dispatch. */
+
 		OptionalScopedPointer<DatagramSocket> socket;
 		OSCReceiver::FormatErrorHandler formatErrorHandler{ nullptr };
 
@@ -706,6 +898,36 @@ namespace SenderAwareOSC
 	//==============================================================================
 	std::map<int, std::unique_ptr<SenderAwareOSCReceiver::SAOPimpl>> SenderAwareOSCReceiver::SAOPimpl::m_pimples;
 
+	//==============================================================================
+	SenderEndpoint SenderEndpoint::fromString(const String& ipAddress, int portNumber)
+	{
+		StringArray octets;
+		octets.addTokens(ipAddress.trim(), ".", "");
+		if (octets.size() != 4)
+			return SenderEndpoint();
+
+		uint32 address = 0;
+		for (auto& octet : octets)
+		{
+			if (octet.isEmpty() || octet.length() > 3 || !octet.containsOnly("0123456789"))
+				return SenderEndpoint();
+
+			auto octetValue = octet.getIntValue();
+			if (octetValue > 255)
+				return SenderEndpoint();
+
+			address = (address << 8) | uint32(octetValue);
+		}
+
+		return SenderEndpoint(address, portNumber);
+	}
+
+	String SenderEndpoint::getAddressString() const
+	{
+		return String((address >> 24) & 0xff) + "." + String((address >> 16) & 0xff) + "."
+			+ String((address >> 8) & 0xff) + "." + String(address & 0xff);
+	}
+
 	//==============================================================================
 	SenderAwareOSCReceiver::SenderAwareOSCReceiver(int portNumber) : m_pimpl(SAOPimpl::getInstance(portNumber))
 	{
@@ -742,6 +964,16 @@ namespace SenderAwareOSC
 		m_pimpl->addListener(listenerToAdd);
 	}
 
+	void SenderAwareOSCReceiver::addListener(SAOListener<OSCReceiver::MessageLoopCallback>* listenerToAdd, const SenderEndpoint& sender)
+	{
+		m_pimpl->addListener(listenerToAdd, sender);
+	}
+
+	void SenderAwareOSCReceiver::addListener(SAOListener<OSCReceiver::RealtimeCallback>* listenerToAdd, const SenderEndpoint& sender)
+	{
+		m_pimpl->addListener(listenerToAdd, sender);
+	}
+
 	void SenderAwareOSCReceiver::removeListener(SAOListener<OSCReceiver::MessageLoopCallback>* listenerToRemove)
 	{
 		m_pimpl->removeListener(listenerToRemove);
@@ -41,10 +41,40 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace SenderAwareOSC
 {
 
+/**
+* Numeric representation of the endpoint (IPv4 address and port) that udp data was received from.
+* It is used to demultiplex received data to the listeners registered for a sender,
+* without having to convert the sender address to a String for every received packet.
+*/
+struct SenderEndpoint
+{
+	SenderEndpoint() = default;
+	SenderEndpoint(uint32 ipv4Address, int portNumber) : address(ipv4Address), port(portNumber) {}
+
+	/** Creates an endpoint from a dotted IPv4 address string. The result is invalid if the string is no IPv4 address. */
+	static SenderEndpoint fromString(const String& ipAddress, int portNumber = 0);
+
+	/** Returns the dotted IPv4 address string of this endpoint. */
+	String getAddressString() const;
+
+	/** Returns true if the endpoint refers to a specific IPv4 address. */
+	bool isValid() const noexcept { return address != 0; }
+
+	/** Returns the same endpoint, with the port set to match any sender port. */
+	SenderEndpoint withAnyPort() const noexcept { return SenderEndpoint(address, 0); }
+
+	/** Returns the key used to look up the listeners registered for this endpoint. */
+	uint64 getKey() const noexcept { return (uint64(address) << 16) | uint64(uint16(port)); }
+
+	uint32	address{ 0 };	/**< The IPv4 address in host byte order. 0 if unknown. */
+	int		port{ 0 };		/**< The port number. 0 matches any sender port when registering listeners. */
+};
+
 /**
 * This class implements a udp osc receiver, similar to JUCEs' own OCSReceiver implementation.
 * The most important difference is the modification to be able to differentiate between udp data sources.
 * This is realized by passing the sender ip adress and port along the received payload to recipients.
+* Listeners can be registered for a specific sender, to only be called for data originating from it.
 */
 class SenderAwareOSCReceiver
 {
@@ -106,6 +136,14 @@ public:
 			The default implementation provided here will simply do nothing.
 		*/
 		virtual void oscBundleReceived(const OSCBundle& /*bundle*/, const String& /*senderIPAddress*/, const int& /*senderPort*/) {}
+
+		/** Called with the raw received udp data, before it is parsed into OSC objects.
+			Only called for RealtimeCallback listeners, directly on the network thread.
+			Return true if the data was completely handled (or deliberately ignored),
+			to not receive it parsed via oscMessageReceived/oscBundleReceived again.
+			The default implementation provided here requests the parsed data.
+		*/
+		virtual bool oscRawDataReceived(const char* /*data*/, size_t /*dataSize*/, const SenderEndpoint& /*sender*/) { return false; }
 	};
 
 	//==============================================================================
@@ -154,6 +192,21 @@ public:
 	*/
 	void addListener(SAOListener<OSCReceiver::RealtimeCallback>* listenerToAdd);
 
+	/** Adds a listener that only listens to OSC messages and bundles received from the given sender.
+		The sender port may be 0 to listen to any port of the sender address.
+		An invalid sender adds the listener for all received data.
+		This listener will be called on the application's message loop.
+	*/
+	void addListener(SAOListener<OSCReceiver::MessageLoopCallback>* listenerToAdd, const SenderEndpoint& sender);
+
+	/** Adds a listener that only listens to OSC messages and bundles received from the given sender.
+		The sender port may be 0 to listen to any port of the sender address.
+		An invalid sender adds the listener for all received data.
+		This listener will be called in real-time directly on the network thread
+		that receives OSC data.
+	*/
+	void addListener(SAOListener<OSCReceiver::RealtimeCallback>* listenerToAdd, const SenderEndpoint& sender);
+
 	/** Removes a previously-registered listener. */
 	void removeListener(SAOListener<OSCReceiver::MessageLoopCallback>* listenerToRemove);
 
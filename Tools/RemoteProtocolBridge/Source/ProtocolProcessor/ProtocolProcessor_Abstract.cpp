@@ -70,6 +70,7 @@ ProtocolProcessor_Abstract::ProtocolProcessor_Abstract()
 	m_type = ProtocolType::PT_Invalid;
 	m_IsRunning = false;
 	m_messageListener = nullptr;
+	m_dataPrecision = 0.001f;
 }
 
 /**
@@ -107,10 +108,41 @@ void ProtocolProcessor_Abstract::SetProtocolConfigurationData(const ProcessingEn
 	m_clientPort = protocolData.ClientPort;
 	m_hostPort = protocolData.HostPort;
 
+	m_rateLimiter.SetRate(protocolData.RateLimit, protocolData.RateBurst);
+
 	if (protocolData.UsesActiveRemoteObjects)
 		SetRemoteObjectsActive(activeObjs);
 }
 
+/**
+ * Setter for the precision received values are compared with to detect value changes.
+ * This is the data precision configured for the object handling of the parent node.
+ *
+ * @param precision	The precision to compare values with. Values are compared exactly if 0.
+ */
+void ProtocolProcessor_Abstract::SetDataPrecision(float precision)
+{
+	m_dataPrecision = jmax(0.0f, precision);
+}
+
+/**
+ * Method to send messages that were queued by SendMessage for batched sending.
+ * The default implementation does nothing, since messages are sent right away.
+ */
+void ProtocolProcessor_Abstract::FlushPendingMessages()
+{
+}
+
+/**
+ * Getter for the rate limiter of this protocol processing object, e.g. to query its per-lane statistics
+ *
+ * @return The rate limiter of this protocol processing object
+ */
+const ProtocolRateLimiter& ProtocolProcessor_Abstract::GetRateLimiter() const
+{
+	return m_rateLimiter;
+}
+
 /**
  * Getter for the type of this protocol processing object
  *
@@ -36,6 +36,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../RemoteProtocolBridgeCommon.h"
 #include "../ProcessingEngineConfig.h"
+#include "ProtocolRateLimiter.h"
 #include "../JuceLibraryCode/JuceHeader.h"
 
 
@@ -72,11 +73,15 @@ public:
 	ProtocolType GetType();
 	ProtocolId GetId();
 	virtual void SetProtocolConfigurationData(const ProcessingEngineConfig::ProtocolData& protocolData, const Array<RemoteObject>& activeObjs, NodeId NId, ProtocolId PId);
+	void SetDataPrecision(float precision);
 
 	virtual bool Start() = 0;
 	virtual bool Stop() = 0;
 	virtual void SetRemoteObjectsActive(const Array<RemoteObject>& Objs) = 0;
 	virtual bool SendMessage(RemoteObjectIdentifier Id, RemoteObjectMessageData& msgData) = 0;
+	virtual void FlushPendingMessages();
+
+	const ProtocolRateLimiter& GetRateLimiter() const;
 
 protected:
 	Listener				*m_messageListener;		/**< The parent node object. Needed for e.g. triggering receive notifications. */
@@ -89,5 +94,8 @@ protected:
 	int						m_hostPort;				/**< TCP/UDP port where messages will be sent to. */
 
 	bool					m_IsRunning;			/**< Bool indication if the processor is successfully running. */
+	float					m_dataPrecision;		/**< The precision received values are compared with to detect value changes, as configured for the parent node. */
+
+	ProtocolRateLimiter		m_rateLimiter;			/**< The limiter to pace the outgoing messages with. Disabled if no rate limit is configured. */
 
 };
@@ -0,0 +1,273 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "ProtocolRateLimiter.h"
+
+
+// **************************************************************************************
+//    class ProtocolRateLimiter
+// **************************************************************************************
+/**
+ * Constructor. The limiter is disabled until a rate is set.
+ */
+ProtocolRateLimiter::ProtocolRateLimiter()
+{
+	m_rate = 0;
+	m_burstSize = EBS_DefaultRateBurst;
+	m_tokens = m_burstSize;
+	m_lastRefillTime = 0;
+	for (int i = 0; i < RLL_UserMAX; ++i)
+		m_droppedCounts[i] = 0;
+}
+
+/**
+ * Destructor
+ */
+ProtocolRateLimiter::~ProtocolRateLimiter()
+{
+}
+
+/**
+ * Setter for the rate messages are let pass with. Not to be called while messages are sent.
+ *
+ * @param messagesPerSecond	The max. average count of messages per second. 0 disables rate limiting.
+ * @param burstSize			The max. count of messages that may pass in a burst.
+ */
+void ProtocolRateLimiter::SetRate(int messagesPerSecond, int burstSize)
+{
+	const ScopedLock l(m_lock);
+
+	m_rate = jmax(0, messagesPerSecond) / 1000.0;
+	m_burstSize = jmax(1, burstSize);
+	m_tokens = m_burstSize;
+	m_lastRefillTime = Time::getMillisecondCounterHiRes();
+
+	for (int i = 0; i < RLL_UserMAX; ++i)
+	{
+		if (m_rate > 0 && !m_heldBackMessages[i])
+			m_heldBackMessages[i] = std::make_unique<RemoteObjectCoalescingQueue>(EBS_RateLimiterQueueSize);
+		else if (m_rate <= 0)
+			m_heldBackMessages[i].reset();
+	}
+}
+
+/**
+ * Getter for the enabled state of the rate limiter.
+ *
+ * @return	True if a rate is set.
+ */
+bool ProtocolRateLimiter::IsEnabled() const
+{
+	return m_rate > 0;
+}
+
+/**
+ * Helper method to assign a message to its priority lane.
+ *
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message data.
+ * @return	The lane of the message.
+ */
+RateLimiterLane ProtocolRateLimiter::GetLane(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	// a value count of 0 indicates a value polling message
+	if (msgData.valCount == 0)
+		return RLL_Polling;
+
+	switch (Id)
+	{
+	case ROI_SoundObject_Position_X:
+	case ROI_SoundObject_Position_Y:
+	case ROI_SoundObject_Position_XY:
+		return RLL_Position;
+	default:
+		return RLL_Parameter;
+	}
+}
+
+/**
+ * Method to take tokens from the bucket to send messages right away.
+ * Fails if the lane has to leave the remaining tokens to higher priority lanes,
+ * or if messages of the lane or a higher priority lane are held back, to not overtake them.
+ * A multi-message packet only needs a single token beyond the lanes' reserve, but takes tokens for all its messages.
+ *
+ * @param lane			The lane of the messages.
+ * @param messageCount	The count of messages that shall be sent.
+ * @return	True if the messages may be sent, false if they have to be held back or skipped.
+ */
+bool ProtocolRateLimiter::TryAcquire(RateLimiterLane lane, int messageCount)
+{
+	if (!IsEnabled())
+		return true;
+
+	const ScopedLock l(m_lock);
+
+	for (int i = RLL_Position; i <= lane; ++i)
+		if (HasHeldBackMessages(static_cast<RateLimiterLane>(i)))
+			return false;
+
+	Refill();
+
+	if (m_tokens - GetReserve(lane) < 1)
+		return false;
+
+	m_tokens -= messageCount;
+
+	return true;
+}
+
+/**
+ * Method to hold back a message that could not be sent right away, until the bucket refilled.
+ * A held back message for the same object id and addressing is replaced.
+ *
+ * @param lane		The lane of the message.
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message data.
+ * @return	True if the message was held back, false if it had to be dropped.
+ */
+bool ProtocolRateLimiter::HoldBack(RateLimiterLane lane, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	if (!m_heldBackMessages[lane])
+		return false;
+
+	return m_heldBackMessages[lane]->Push(0, Id, msgData);
+}
+
+/**
+ * Method to take as many held back messages of the given lane as the bucket allows to be sent now.
+ * Lanes should be processed in order of their priority.
+ *
+ * @param lane		The lane to take the messages of.
+ * @param messages	The preallocated array to copy the released messages into.
+ * @param maxCount	The size of the given array.
+ * @return	The count of released messages.
+ */
+int ProtocolRateLimiter::TakeReleased(RateLimiterLane lane, RemoteObjectMessageCopy* messages, int maxCount)
+{
+	if (!m_heldBackMessages[lane])
+		return 0;
+
+	const ScopedLock l(m_lock);
+
+	if (!HasHeldBackMessages(lane))
+		return 0;
+
+	Refill();
+
+	int releaseCount = jmin(maxCount, static_cast<int>(m_tokens - GetReserve(lane)));
+	if (releaseCount <= 0)
+		return 0;
+
+	int count = m_heldBackMessages[lane]->TakeAll(messages, releaseCount);
+	m_tokens -= count;
+
+	return count;
+}
+
+/**
+ * Method to count messages of the given lane that were skipped, because they could neither be sent nor held back.
+ *
+ * @param lane			The lane of the skipped messages.
+ * @param messageCount	The count of skipped messages.
+ */
+void ProtocolRateLimiter::AddDropped(RateLimiterLane lane, int messageCount)
+{
+	m_droppedCounts[lane] += static_cast<uint32>(messageCount);
+}
+
+/**
+ * Getter for the count of messages currently held back in the given lane.
+ *
+ * @param lane	The lane to get the queue depth of.
+ * @return	The count of held back messages.
+ */
+int ProtocolRateLimiter::GetQueueDepth(RateLimiterLane lane) const
+{
+	return m_heldBackMessages[lane] ? m_heldBackMessages[lane]->GetNumQueued() : 0;
+}
+
+/**
+ * Getter for the count of messages of the given lane that were dropped or skipped.
+ * Held back messages that were replaced by a newer value of the same object are not counted.
+ *
+ * @param lane	The lane to get the drop count of.
+ * @return	The count of dropped messages.
+ */
+uint32 ProtocolRateLimiter::GetDroppedCount(RateLimiterLane lane) const
+{
+	return m_droppedCounts[lane].get() + (m_heldBackMessages[lane] ? m_heldBackMessages[lane]->GetDroppedCount() : 0);
+}
+
+/**
+ * Helper method to add the tokens to the bucket that accumulated since the last refill.
+ * Must be called with m_lock held.
+ */
+void ProtocolRateLimiter::Refill()
+{
+	double now = Time::getMillisecondCounterHiRes();
+	m_tokens = jmin(m_burstSize, m_tokens + (now - m_lastRefillTime) * m_rate);
+	m_lastRefillTime = now;
+}
+
+/**
+ * Helper method to get the count of tokens the given lane has to leave to higher priority lanes.
+ *
+ * @param lane	The lane to get the reserve for.
+ * @return	The count of reserved tokens.
+ */
+double ProtocolRateLimiter::GetReserve(RateLimiterLane lane) const
+{
+	switch (lane)
+	{
+	case RLL_Parameter:
+		return m_burstSize / 4;
+	case RLL_Polling:
+		return m_burstSize / 2;
+	case RLL_Position:
+	default:
+		return 0;
+	}
+}
+
+/**
+ * Helper method to check if messages of the given lane are held back.
+ *
+ * @param lane	The lane to check.
+ * @return	True if messages of the lane are held back.
+ */
+bool ProtocolRateLimiter::HasHeldBackMessages(RateLimiterLane lane) const
+{
+	return m_heldBackMessages[lane] && m_heldBackMessages[lane]->GetNumQueued() > 0;
+}
@@ -0,0 +1,84 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "../RemoteProtocolBridgeCommon.h"
+#include "../RemoteObjectCoalescingQueue.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class ProtocolRateLimiter paces the outgoing messages of a protocol processor with a token bucket.
+ * Messages are assigned to priority lanes (positions, other parameters, polling). Lower priority lanes
+ * leave a reserve of the bucket to the higher ones, so they are held back first when the rate is exceeded.
+ * Messages that cannot be sent right away are held back per lane, coalesced to the latest value per object,
+ * and released by the protocol processor as soon as the bucket refilled.
+ */
+class ProtocolRateLimiter
+{
+public:
+	ProtocolRateLimiter();
+	~ProtocolRateLimiter();
+
+	void SetRate(int messagesPerSecond, int burstSize);
+	bool IsEnabled() const;
+
+	static RateLimiterLane GetLane(RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+
+	bool TryAcquire(RateLimiterLane lane, int messageCount = 1);
+	bool HoldBack(RateLimiterLane lane, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	int TakeReleased(RateLimiterLane lane, RemoteObjectMessageCopy* messages, int maxCount);
+	void AddDropped(RateLimiterLane lane, int messageCount);
+
+	int GetQueueDepth(RateLimiterLane lane) const;
+	uint32 GetDroppedCount(RateLimiterLane lane) const;
+
+private:
+	void Refill();
+	double GetReserve(RateLimiterLane lane) const;
+	bool HasHeldBackMessages(RateLimiterLane lane) const;
+
+	CriticalSection									m_lock;								/**< Lock to protect the bucket state, since messages are sent from engine and timer threads. */
+	double											m_rate;								/**< The bucket refill rate in messages per ms. 0 if rate limiting is disabled. */
+	double											m_burstSize;						/**< The max. count of tokens the bucket holds. */
+	double											m_tokens;							/**< The count of tokens currently available. Can become negative for multi-message packets. */
+	double											m_lastRefillTime;					/**< The time of the last refill, in ms. */
+	std::unique_ptr<RemoteObjectCoalescingQueue>	m_heldBackMessages[RLL_UserMAX];	/**< The messages held back per lane. Only allocated if rate limiting is enabled. */
+	Atomic<uint32>									m_droppedCounts[RLL_UserMAX];		/**< Count of messages per lane that were skipped instead of held back. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProtocolRateLimiter)
+};
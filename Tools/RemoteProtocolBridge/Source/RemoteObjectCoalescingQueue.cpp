@@ -0,0 +1,210 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "RemoteObjectCoalescingQueue.h"
+
+
+// **************************************************************************************
+//    class RemoteObjectCoalescingQueue
+// **************************************************************************************
+/**
+ * Constructor of the coalescing queue. Preallocates the storage for the given number of distinct objects.
+ *
+ * @param capacity	The number of distinct objects the queue can hold pending messages for.
+ */
+RemoteObjectCoalescingQueue::RemoteObjectCoalescingQueue(int capacity)
+	: m_messages(static_cast<size_t>(jmax(1, capacity))),
+	m_messageKeys(static_cast<size_t>(jmax(1, capacity))),
+	m_messageSlots(static_cast<size_t>(jmax(1, capacity)))
+{
+	// keep the hash table at most half full to keep probe sequences short
+	int slotCount = 1;
+	while (slotCount < 2 * jmax(1, capacity))
+		slotCount <<= 1;
+
+	m_slots.assign(static_cast<size_t>(slotCount), -1);
+	m_slotMask = slotCount - 1;
+	m_numQueued = 0;
+	m_coalescedCount = 0;
+	m_droppedCount = 0;
+}
+
+/**
+ * Destructor
+ */
+RemoteObjectCoalescingQueue::~RemoteObjectCoalescingQueue()
+{
+}
+
+/**
+ * Method to queue a message. If a message for the same object id and addressing is already pending,
+ * it is replaced by the given one, keeping its position in the queue.
+ * Safe to be called from any thread.
+ *
+ * @param PId		The id of the protocol the message shall be sent to.
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message data to copy into the queue.
+ * @param receiveTime	The time in ms the message was received at, kept with the message to measure its latency once it is sent. 0 if not known.
+ * @return	True if the message was queued, false if it could not be (full queue or unqueueable payload).
+ */
+bool RemoteObjectCoalescingQueue::Push(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double receiveTime)
+{
+	uint64 key = GetRemoteObjectKey(Id, msgData.addrVal);
+
+	const ScopedLock l(m_lock);
+
+	int slot = FindSlot(key);
+	int index = m_slots[static_cast<size_t>(slot)];
+	if (index >= 0)
+	{
+		if (!m_messages[static_cast<size_t>(index)].Set(PId, Id, msgData, receiveTime))
+		{
+			++m_droppedCount;
+			return false;
+		}
+
+		++m_coalescedCount;
+		return true;
+	}
+
+	if (m_numQueued >= static_cast<int>(m_messages.size()) || !m_messages[static_cast<size_t>(m_numQueued)].Set(PId, Id, msgData, receiveTime))
+	{
+		++m_droppedCount;
+		return false;
+	}
+
+	m_messageKeys[static_cast<size_t>(m_numQueued)] = key;
+	m_messageSlots[static_cast<size_t>(m_numQueued)] = slot;
+	m_slots[static_cast<size_t>(slot)] = m_numQueued;
+	++m_numQueued;
+
+	return true;
+}
+
+/**
+ * Method to take all pending messages out of the queue, in order of their first arrival.
+ * Safe to be called from any thread.
+ *
+ * @param messages	The preallocated array to copy the pending messages into.
+ * @param maxCount	The size of the given array. Should be at least the queue capacity, further messages stay pending otherwise.
+ * @return	The number of messages that were copied into the given array.
+ */
+int RemoteObjectCoalescingQueue::TakeAll(RemoteObjectMessageCopy* messages, int maxCount)
+{
+	const ScopedLock l(m_lock);
+
+	int count = jmin(m_numQueued, maxCount);
+	for (int i = 0; i < count; ++i)
+		messages[i] = m_messages[static_cast<size_t>(i)];
+
+	// release the hash table slots of all pending messages
+	for (int i = 0; i < m_numQueued; ++i)
+		m_slots[static_cast<size_t>(m_messageSlots[static_cast<size_t>(i)])] = -1;
+
+	// messages that did not fit the given array stay pending and have to be reinserted
+	int remaining = m_numQueued - count;
+	for (int i = 0; i < remaining; ++i)
+	{
+		m_messages[static_cast<size_t>(i)] = m_messages[static_cast<size_t>(count + i)];
+		m_messageKeys[static_cast<size_t>(i)] = m_messageKeys[static_cast<size_t>(count + i)];
+		m_messageSlots[static_cast<size_t>(i)] = FindSlot(m_messageKeys[static_cast<size_t>(i)]);
+		m_slots[static_cast<size_t>(m_messageSlots[static_cast<size_t>(i)])] = i;
+	}
+	m_numQueued = remaining;
+
+	return count;
+}
+
+/**
+ * Getter for the number of distinct objects the queue can hold pending messages for.
+ *
+ * @return	The queue capacity.
+ */
+int RemoteObjectCoalescingQueue::GetCapacity() const
+{
+	return static_cast<int>(m_messages.size());
+}
+
+/**
+ * Getter for the number of messages currently pending in the queue.
+ *
+ * @return	The number of pending messages.
+ */
+int RemoteObjectCoalescingQueue::GetNumQueued() const
+{
+	const ScopedLock l(m_lock);
+
+	return m_numQueued;
+}
+
+/**
+ * Getter for the number of messages that replaced a pending value since the queue was created.
+ *
+ * @return	The number of coalesced messages.
+ */
+uint32 RemoteObjectCoalescingQueue::GetCoalescedCount() const
+{
+	return m_coalescedCount.get();
+}
+
+/**
+ * Getter for the number of messages that were dropped since the queue was created.
+ *
+ * @return	The number of dropped messages.
+ */
+uint32 RemoteObjectCoalescingQueue::GetDroppedCount() const
+{
+	return m_droppedCount.get();
+}
+
+/**
+ * Helper method to find the hash table slot of the given key, by linear probing.
+ * Must be called with m_lock held.
+ *
+ * @param key	The lookup key to find the slot for.
+ * @return	The slot that refers to the pending message of the key, or the free slot the key can be inserted at.
+ */
+int RemoteObjectCoalescingQueue::FindSlot(uint64 key) const
+{
+	int slot = static_cast<int>((key * 0x9E3779B97F4A7C15ull) >> 40) & m_slotMask;
+	while (true)
+	{
+		int index = m_slots[static_cast<size_t>(slot)];
+		if (index < 0 || m_messageKeys[static_cast<size_t>(index)] == key)
+			return slot;
+
+		slot = (slot + 1) & m_slotMask;
+	}
+}
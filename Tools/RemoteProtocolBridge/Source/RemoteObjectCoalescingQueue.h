@@ -0,0 +1,78 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class RemoteObjectCoalescingQueue holds the outgoing remote object messages pending for a protocol,
+ * keeping only the latest value per remote object id and addressing.
+ * A message for an object that already has a value pending replaces that value in place,
+ * so the queue never holds more than one message per object and never a backlog of stale values.
+ * All storage is preallocated on construction, pushing and taking messages does not allocate.
+ */
+class RemoteObjectCoalescingQueue
+{
+public:
+	RemoteObjectCoalescingQueue(int capacity = EBS_CoalescingQueueSize);
+	~RemoteObjectCoalescingQueue();
+
+	bool Push(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double receiveTime = 0);
+	int TakeAll(RemoteObjectMessageCopy* messages, int maxCount);
+
+	int GetCapacity() const;
+	int GetNumQueued() const;
+	uint32 GetCoalescedCount() const;
+	uint32 GetDroppedCount() const;
+
+private:
+	int FindSlot(uint64 key) const;
+
+	CriticalSection							m_lock;				/**< Lock to protect the queue contents from concurrent pushing and taking. */
+	std::vector<RemoteObjectMessageCopy>	m_messages;			/**< The preallocated storage of pending messages, in order of first arrival. */
+	std::vector<uint64>						m_messageKeys;		/**< The lookup keys of the pending messages. */
+	std::vector<int>						m_messageSlots;		/**< The hash table slots referring to the pending messages. */
+	std::vector<int>						m_slots;			/**< Open addressing hash table mapping keys to pending message indices. -1 for unused slots. */
+	int										m_slotMask;			/**< Bitmask to wrap indices into the hash table, which has a power of two size. */
+	int										m_numQueued;		/**< Count of currently pending messages. */
+	Atomic<uint32>							m_coalescedCount;	/**< Count of messages that replaced a pending value of the same object. */
+	Atomic<uint32>							m_droppedCount;		/**< Count of messages that were dropped due to a full queue or an unqueueable payload. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteObjectCoalescingQueue)
+};
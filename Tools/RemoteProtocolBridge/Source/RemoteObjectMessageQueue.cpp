@@ -0,0 +1,137 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "RemoteObjectMessageQueue.h"
+
+
+// **************************************************************************************
+//    class RemoteObjectMessageQueue
+// **************************************************************************************
+/**
+ * Constructor of the message queue. Preallocates the storage for the given number of messages.
+ *
+ * @param capacity	The number of messages the queue can hold.
+ */
+RemoteObjectMessageQueue::RemoteObjectMessageQueue(int capacity)
+	: m_fifo(capacity),
+	m_messages(static_cast<size_t>(capacity)),
+	m_receiveTimes(static_cast<size_t>(capacity))
+{
+	m_droppedCount = 0;
+}
+
+/**
+ * Destructor
+ */
+RemoteObjectMessageQueue::~RemoteObjectMessageQueue()
+{
+}
+
+/**
+ * Method to copy a message into the queue. To be called from the producing thread only.
+ *
+ * @param PId		The id of the protocol the message was received on.
+ * @param Id		The remote object id of the message.
+ * @param msgData	The message data to copy into the queue.
+ * @param receiveTime	The time the message was received, in ms.
+ * @return	True if the message was queued, false if it had to be dropped.
+ */
+bool RemoteObjectMessageQueue::Push(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double receiveTime)
+{
+	int start1, size1, start2, size2;
+	m_fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+	if (size1 + size2 < 1)
+	{
+		++m_droppedCount;
+		return false;
+	}
+
+	int index = size1 > 0 ? start1 : start2;
+	if (!m_messages[static_cast<size_t>(index)].Set(PId, Id, msgData))
+	{
+		++m_droppedCount;
+		return false;
+	}
+	m_receiveTimes[static_cast<size_t>(index)] = receiveTime;
+
+	m_fifo.finishedWrite(1);
+
+	return true;
+}
+
+/**
+ * Method to take the oldest message out of the queue. To be called from the consuming thread only.
+ *
+ * @param message		The message object to copy the popped message into.
+ * @param receiveTime	The time the popped message was received, in ms.
+ * @return	True if a message was popped, false if the queue was empty.
+ */
+bool RemoteObjectMessageQueue::Pop(RemoteObjectMessageCopy& message, double& receiveTime)
+{
+	int start1, size1, start2, size2;
+	m_fifo.prepareToRead(1, start1, size1, start2, size2);
+
+	if (size1 + size2 < 1)
+		return false;
+
+	int index = size1 > 0 ? start1 : start2;
+	message = m_messages[static_cast<size_t>(index)];
+	receiveTime = m_receiveTimes[static_cast<size_t>(index)];
+
+	m_fifo.finishedRead(1);
+
+	return true;
+}
+
+/**
+ * Getter for the number of messages currently waiting in the queue.
+ *
+ * @return	The number of queued messages.
+ */
+int RemoteObjectMessageQueue::GetNumQueued() const
+{
+	return m_fifo.getNumReady();
+}
+
+/**
+ * Getter for the number of messages that were dropped since the queue was created.
+ *
+ * @return	The number of dropped messages.
+ */
+uint32 RemoteObjectMessageQueue::GetDroppedCount() const
+{
+	return m_droppedCount.get();
+}
@@ -0,0 +1,67 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Class RemoteObjectMessageQueue is a lock-free single producer / single consumer fifo
+ * to hand over received remote object messages from a network thread to an engine worker thread.
+ * All storage is preallocated on construction, pushing and popping does not allocate.
+ */
+class RemoteObjectMessageQueue
+{
+public:
+	RemoteObjectMessageQueue(int capacity = EBS_MessageQueueSize);
+	~RemoteObjectMessageQueue();
+
+	bool Push(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double receiveTime);
+	bool Pop(RemoteObjectMessageCopy& message, double& receiveTime);
+
+	int GetNumQueued() const;
+	uint32 GetDroppedCount() const;
+
+private:
+	AbstractFifo							m_fifo;			/**< The fifo index management object. */
+	std::vector<RemoteObjectMessageCopy>	m_messages;		/**< The preallocated message storage the fifo indices refer to. */
+	std::vector<double>						m_receiveTimes;	/**< The preallocated storage of the times the messages were received, in ms. */
+	Atomic<uint32>							m_droppedCount;	/**< Count of messages that were dropped due to a full queue or an unqueueable payload. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteObjectMessageQueue)
+};
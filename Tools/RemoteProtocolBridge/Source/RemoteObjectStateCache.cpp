@@ -0,0 +1,257 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#include "RemoteObjectStateCache.h"
+
+
+// **************************************************************************************
+//    class RemoteObjectStateCache
+// **************************************************************************************
+/**
+ * Constructor
+ */
+RemoteObjectStateCache::RemoteObjectStateCache()
+{
+	m_maxAge = ET_DefaultStateCacheMaxAge;
+	m_answeredCount = 0;
+	m_deduplicatedCount = 0;
+}
+
+/**
+ * Destructor
+ */
+RemoteObjectStateCache::~RemoteObjectStateCache()
+{
+}
+
+/**
+ * Setter for the max. age of a cached value to answer polls with.
+ *
+ * @param maxAge	The max. age in ms. 0 disables the cache.
+ */
+void RemoteObjectStateCache::SetMaxAge(int maxAge)
+{
+	const ScopedLock l(m_lock);
+
+	m_maxAge = jmax(0, maxAge);
+	if (m_maxAge <= 0)
+	{
+		m_values.clear();
+		m_pendingPolls.clear();
+	}
+}
+
+/**
+ * Getter for the enabled state of the cache.
+ *
+ * @return	True if a max. age is set, false if the cache is disabled.
+ */
+bool RemoteObjectStateCache::IsEnabled() const
+{
+	const ScopedLock l(m_lock);
+
+	return m_maxAge > 0;
+}
+
+/**
+ * Method to remove all cached values and pending polls, e.g. when the node is stopped.
+ */
+void RemoteObjectStateCache::Clear()
+{
+	const ScopedLock l(m_lock);
+
+	m_values.clear();
+	m_pendingPolls.clear();
+}
+
+/**
+ * Method to cache a value that is sent to a role A protocol.
+ * This is how the responses of the role B device end up in the cache, after the object data handling
+ * mapped them to the addressing of the role A protocol.
+ *
+ * @param PId		The id of the role A protocol the value is sent to.
+ * @param Id		The remote object id of the value.
+ * @param msgData	The message data of the value.
+ * @param now		The current time, in ms.
+ */
+void RemoteObjectStateCache::OnValueSentToA(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double now)
+{
+	if (msgData.valCount == 0)
+		return;
+
+	const ScopedLock l(m_lock);
+
+	if (m_maxAge <= 0)
+		return;
+
+	CacheEntry& entry = m_values[PId][GetRemoteObjectKey(Id, msgData.addrVal)];
+	entry.Valid = entry.Value.Set(PId, Id, msgData);
+	entry.Time = now;
+}
+
+/**
+ * Method to cache a value that a role A client wrote.
+ * The written value is what the client expects to be answered to its next poll. Cached values of the same
+ * object for other role A protocols are invalidated, since the write changes the value on the device.
+ *
+ * @param PId		The id of the role A protocol the value was received by.
+ * @param Id		The remote object id of the value.
+ * @param msgData	The message data of the value.
+ * @param now		The current time, in ms.
+ */
+void RemoteObjectStateCache::OnValueWrittenByA(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double now)
+{
+	if (msgData.valCount == 0)
+		return;
+
+	const ScopedLock l(m_lock);
+
+	if (m_maxAge <= 0)
+		return;
+
+	uint64 key = GetRemoteObjectKey(Id, msgData.addrVal);
+	for (auto& protocolValues : m_values)
+	{
+		if (protocolValues.first == PId)
+			continue;
+
+		auto entry = protocolValues.second.find(key);
+		if (entry != protocolValues.second.end())
+			entry->second.Valid = false;
+	}
+
+	CacheEntry& entry = m_values[PId][key];
+	entry.Valid = entry.Value.Set(PId, Id, msgData);
+	entry.Time = now;
+}
+
+/**
+ * Method to look up the cached value to answer a role A poll with.
+ *
+ * @param PId		The id of the role A protocol the poll was received by.
+ * @param Id		The remote object id of the poll.
+ * @param addrVal	The remote object addressing of the poll.
+ * @param now		The current time, in ms.
+ * @param value		Reference to copy the cached value into.
+ * @return	True if a valid value not older than the max. age was found, false if the poll has to be forwarded.
+ */
+bool RemoteObjectStateCache::GetCachedValue(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal, double now, RemoteObjectMessageCopy& value)
+{
+	const ScopedLock l(m_lock);
+
+	if (m_maxAge <= 0)
+		return false;
+
+	auto protocolValues = m_values.find(PId);
+	if (protocolValues == m_values.end())
+		return false;
+
+	auto entry = protocolValues->second.find(GetRemoteObjectKey(Id, addrVal));
+	if (entry == protocolValues->second.end() || !entry->second.Valid || now - entry->second.Time > m_maxAge)
+		return false;
+
+	value = entry->second.Value;
+	++m_answeredCount;
+
+	return true;
+}
+
+/**
+ * Method to register a poll that is about to be sent to a role B protocol.
+ *
+ * @param PId		The id of the role B protocol the poll is sent to.
+ * @param Id		The remote object id of the poll.
+ * @param addrVal	The remote object addressing of the poll.
+ * @param now		The current time, in ms.
+ * @return	True if the poll shall be sent, false if an identical poll was sent less than the poll response timeout ago and is not answered yet.
+ */
+bool RemoteObjectStateCache::BeginUpstreamPoll(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal, double now)
+{
+	const ScopedLock l(m_lock);
+
+	if (m_maxAge <= 0)
+		return true;
+
+	auto result = m_pendingPolls[PId].insert(std::make_pair(GetRemoteObjectKey(Id, addrVal), now));
+	if (!result.second)
+	{
+		if (now - result.first->second < ET_PollResponseTimeout)
+		{
+			++m_deduplicatedCount;
+			return false;
+		}
+
+		result.first->second = now;
+	}
+
+	return true;
+}
+
+/**
+ * Method to mark the pending poll of an object as answered, when a value of it is received by a role B protocol.
+ *
+ * @param PId		The id of the role B protocol the value was received by.
+ * @param Id		The remote object id of the value.
+ * @param addrVal	The remote object addressing of the value.
+ */
+void RemoteObjectStateCache::EndUpstreamPoll(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal)
+{
+	const ScopedLock l(m_lock);
+
+	auto protocolPolls = m_pendingPolls.find(PId);
+	if (protocolPolls != m_pendingPolls.end())
+		protocolPolls->second.erase(GetRemoteObjectKey(Id, addrVal));
+}
+
+/**
+ * Getter for the number of role A polls that were answered from the cache.
+ *
+ * @return	The number of answered polls.
+ */
+uint32 RemoteObjectStateCache::GetAnsweredCount() const
+{
+	return m_answeredCount.get();
+}
+
+/**
+ * Getter for the number of polls that were not sent upstream, since an identical poll was pending.
+ *
+ * @return	The number of deduplicated polls.
+ */
+uint32 RemoteObjectStateCache::GetDeduplicatedCount() const
+{
+	return m_deduplicatedCount.get();
+}
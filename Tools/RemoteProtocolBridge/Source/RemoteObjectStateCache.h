@@ -0,0 +1,96 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <unordered_map>
+
+
+/**
+ * Class RemoteObjectStateCache holds the latest known value per remote object of a node,
+ * to answer value-less polls of role A clients without forwarding them to the role B device.
+ * Values are cached per role A protocol in that protocols' addressing, as they were sent to it,
+ * so the cache answers a poll with exactly the value the object data handling would have
+ * forwarded to the polling client. Values written by a role A client are cached as well.
+ * In addition, identical polls sent to a role B protocol while an earlier one is not answered
+ * yet are deduplicated, since the pending response is forwarded to the role A clients anyway.
+ */
+class RemoteObjectStateCache
+{
+public:
+	RemoteObjectStateCache();
+	~RemoteObjectStateCache();
+
+	void SetMaxAge(int maxAge);
+	bool IsEnabled() const;
+	void Clear();
+
+	void OnValueSentToA(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double now);
+	void OnValueWrittenByA(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData, double now);
+	bool GetCachedValue(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal, double now, RemoteObjectMessageCopy& value);
+
+	bool BeginUpstreamPoll(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal, double now);
+	void EndUpstreamPoll(ProtocolId PId, RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal);
+
+	uint32 GetAnsweredCount() const;
+	uint32 GetDeduplicatedCount() const;
+
+private:
+	/**
+	 * Cached value of a single remote object.
+	 */
+	struct CacheEntry
+	{
+		RemoteObjectMessageCopy	Value;		/**< The cached message, incl. its payload values. */
+		double					Time;		/**< The time the value was cached, in ms. */
+		bool					Valid;		/**< Indication if the value is known to be up to date. False if it was invalidated by a write of another client. */
+	};
+
+
+	CriticalSection													m_lock;					/**< Lock to protect the cache contents, since they are accessed from the network and timer threads. */
+	double															m_maxAge;				/**< The max. age in ms of a cached value to answer polls with. 0 if the cache is disabled. */
+	std::map<ProtocolId, std::unordered_map<uint64, CacheEntry>>	m_values;				/**< The cached values per role A protocol, by remote object id and addressing. */
+	std::map<ProtocolId, std::unordered_map<uint64, double>>		m_pendingPolls;			/**< The send times in ms of the unanswered polls per role B protocol, by remote object id and addressing. */
+	Atomic<uint32>													m_answeredCount;		/**< Count of role A polls that were answered from the cache. */
+	Atomic<uint32>													m_deduplicatedCount;	/**< Count of polls that were not sent upstream, since an identical poll was pending. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteObjectStateCache)
+};
@@ -52,6 +52,8 @@ typedef uint64 ProtocolId;
 */
 #define INVALID_ADDRESS_VALUE -1
 #define CONFIGURATION_FILE "RemoteProtocolBridgeConfig.xml"
+#define METRICS_FILE "RemoteProtocolBridgeMetrics.xml"
+#define MAX_REMOTE_OBJECT_VALUE_COUNT 3	/**< Max known value count of a remote object (positioning xyz). */
 
 /**
  * Known Protocol Processor Types
@@ -83,6 +85,41 @@ enum ObjectHandlingMode
 	OHM_UserMAX						/**< Value to mark enum max; For iteration purpose. */
 };
 
+/**
+ * Known engine threading modes
+ */
+enum EngineThreadingMode
+{
+	ETM_Invalid = 0,		/**< Invalid engine threading mode value. */
+	ETM_MessageThread,		/**< All protocol message processing is done on the application message thread. */
+	ETM_EngineThread,		/**< Protocol message processing is done on a single dedicated engine thread, fed by the network threads. */
+	ETM_ThreadPerNode,		/**< Protocol message processing is done on a dedicated thread per node, fed by the network threads. */
+	ETM_UserMAX				/**< Value to mark enum max; For iteration purpose. */
+};
+
+/**
+ * Priority lanes of outgoing protocol messages, in descending priority.
+ */
+enum RateLimiterLane
+{
+	RLL_Position = 0,		/**< Live sound object position changes. */
+	RLL_Parameter,			/**< Other parameter value changes. */
+	RLL_Polling,			/**< Value polling requests. */
+	RLL_UserMAX				/**< Value to mark enum max; For iteration purpose. */
+};
+
+/**
+ * Message counters of the engine metrics.
+ */
+enum MetricsCounter
+{
+	MC_Received = 0,		/**< Messages received by a protocol. */
+	MC_Sent,				/**< Messages forwarded to a protocol. */
+	MC_Filtered,			/**< Received messages the object data handling did not forward to any protocol. */
+	MC_Dropped,				/**< Messages lost due to a full queue or a failed send. */
+	MC_UserMAX				/**< Value to mark enum max; For iteration purpose. */
+};
+
 /**
  * Remote Object Identification
  */
@@ -170,6 +207,18 @@ struct RemoteObjectAddressing
 	}
 };
 
+/**
+ * Helper to combine a remote object id and addressing to a single key, e.g. to look up per object state in hash maps.
+ *
+ * @param Id		The remote object id.
+ * @param addrVal	The remote object addressing.
+ * @return	The lookup key.
+ */
+inline uint64 GetRemoteObjectKey(RemoteObjectIdentifier Id, const RemoteObjectAddressing& addrVal)
+{
+	return (uint64(uint32(Id)) << 32) | (uint64(uint16(addrVal.first)) << 16) | uint64(uint16(addrVal.second));
+}
+
 /**
  * Dataset defining a remote object including adressing (info regarding channel/record)
  */
@@ -193,6 +242,68 @@ struct RemoteObjectMessageData
 	uint64					payloadSize;	/**< Size of the payload data. */
 };
 
+/**
+ * Dataset holding a self-contained copy of a remote object message, incl. its payload values.
+ * Used wherever message data has to outlive the callstack it was received in (e.g. for queueing).
+ */
+struct RemoteObjectMessageCopy
+{
+	ProtocolId				PId;			/**< The protocol the message was received on. */
+	RemoteObjectIdentifier	Id;				/**< The remote object id of the message. */
+	RemoteObjectAddressing	addrVal;		/**< Address definition value of the message. */
+	RemoteObjectValueType	valType;		/**< Datatype used for data values of the message. */
+	uint16					valCount;		/**< Value count used by the message. */
+	double					receiveTime;	/**< The time in ms the message was received at, to measure the forwarding latency when it is sent later. 0 if not known. */
+	union
+	{
+		int		intValues[MAX_REMOTE_OBJECT_VALUE_COUNT];	/**< Value storage for ROVT_INT messages. */
+		float	floatValues[MAX_REMOTE_OBJECT_VALUE_COUNT];	/**< Value storage for ROVT_FLOAT messages. */
+	}						values;			/**< Inline copy of the payload data. */
+
+	/**
+	 * Method to copy the contents of given message data into this object.
+	 *
+	 * @param protocolId	The protocol the message was received on.
+	 * @param objectId		The remote object id of the message.
+	 * @param msgData		The message data to copy.
+	 * @param messageReceiveTime	The time in ms the message was received at, 0 if not known.
+	 * @return	True on success, false if the payload cannot be held inline (e.g. string or too many values).
+	 */
+	bool Set(ProtocolId protocolId, RemoteObjectIdentifier objectId, const RemoteObjectMessageData& msgData, double messageReceiveTime = 0)
+	{
+		if (msgData.valCount > MAX_REMOTE_OBJECT_VALUE_COUNT || msgData.valType == ROVT_STRING || msgData.payloadSize > sizeof(values))
+			return false;
+
+		PId = protocolId;
+		Id = objectId;
+		addrVal = msgData.addrVal;
+		valType = msgData.valType;
+		valCount = msgData.valCount;
+		receiveTime = messageReceiveTime;
+		if (msgData.payload != nullptr && msgData.payloadSize > 0)
+			memcpy(&values, msgData.payload, static_cast<size_t>(msgData.payloadSize));
+
+		return true;
+	}
+	/**
+	 * Getter for a message data struct referring to the inline payload of this object.
+	 * The returned struct is only valid as long as this object is.
+	 *
+	 * @return	The message data struct.
+	 */
+	RemoteObjectMessageData GetMessageData()
+	{
+		RemoteObjectMessageData msgData;
+		msgData.addrVal = addrVal;
+		msgData.valType = valType;
+		msgData.valCount = valCount;
+		msgData.payloadSize = (valType == ROVT_INT ? sizeof(int) : (valType == ROVT_FLOAT ? sizeof(float) : 0)) * valCount;
+		msgData.payload = msgData.payloadSize > 0 ? &values : nullptr;
+
+		return msgData;
+	}
+};
+
 /**
  * Common size values used in UI
  */
@@ -242,5 +353,39 @@ enum UIColors
 enum EngineTimings
 {
 	ET_DefaultPollingRate	= 100,	/** OSC polling interval in ms. */
-	ET_LoggingFlushRate		= 300	/** Flush interval for accumulated messages to be printed. */
+	ET_DefaultAdaptivePollingMaxInterval	= 0,	/** Max. interval in ms OSC polling of unchanging values backs off to. 0 disables adaptive polling. */
+	ET_LoggingFlushRate		= 100,	/** Flush interval for accumulated messages to be printed. Shorter than the traffic plot resolution, to count messages in the right plot interval. */
+	ET_WorkerIdleTimeout	= 100,	/** Max. time an engine worker thread sleeps without being notified of new messages, in ms. */
+	ET_DefaultBundleWindow	= 0,	/** Time window in ms outgoing OSC messages are accumulated in bundles. 0 disables bundling. */
+	ET_DefaultCoalescingInterval	= 0,	/** Interval in ms outgoing messages are coalesced to their latest value per object. 0 disables coalescing. */
+	ET_DefaultRateLimit		= 0,	/** Max. rate of outgoing messages per protocol, in messages per second. 0 disables rate limiting. */
+	ET_RateLimiterInterval	= 5,	/** Interval in ms messages held back by the rate limiter are released in. */
+	ET_PollingSlotInterval	= 5,	/** Max. interval in ms the polling scheduler checks for due poll messages in. */
+	ET_PollResponseTimeout	= 500,	/** Time in ms after which an unanswered poll counts as lost and a device that answers no poll counts as unresponsive. */
+	ET_MaxPollBackoffInterval	= 8000,	/** Max. interval in ms an unresponsive device is probed in. */
+	ET_DefaultStateCacheMaxAge	= 0,	/** Max. age in ms of a cached object value to answer role A polls with. 0 disables the state cache. */
+	ET_DefaultSubscriptionMaxRate	= 0,	/** Max. rate in updates per second changed values of a subscribed object are pushed to an OSC client. 0 pushes every change. */
+	ET_SubscriptionFlushInterval	= 5,	/** Interval in ms changed values held back by the subscription max. rate are checked to be due in. */
+	ET_DaemonSignalPollInterval	= 100,	/** Interval in ms the headless daemon checks for stop and reload signals in. */
+	ET_DefaultMetricsDumpInterval	= 0,	/** Interval in ms the engine metrics are written to the metrics file. 0 disables the file dump. */
+	ET_MetricsServerPollInterval	= 100	/** Max. time in ms the metrics publisher waits for a connection before checking for a due file dump. */
+};
+
+/**
+ * Common buffer sizes used in Engine
+ */
+enum EngineBufferSizes
+{
+	EBS_MessageQueueSize	= 4096,	/** Capacity of the per-protocol received message queues in engine thread mode. */
+	EBS_DefaultBundleMTU	= 1472,	/** Default max. size of outgoing OSC bundle packets (ethernet mtu minus ip and udp headers). */
+	EBS_MinBundleMTU		= 64,	/** Min. configurable size of outgoing OSC bundle packets. */
+	EBS_MaxBundleMTU		= 65507,	/** Max. configurable size of outgoing OSC bundle packets (max. udp payload). */
+	EBS_ValueStoreChannels	= 128,	/** Min. count of channels the value change filter stores current values for. */
+	EBS_ValueStoreRecords	= 6,	/** Count of records the value change filter stores current values for per channel (invalid, 0 and mapping areas 1-4). */
+	EBS_CoalescingQueueSize	= 4096,	/** Max. count of distinct remote objects that outgoing messages are coalesced for per protocol. */
+	EBS_DefaultRateBurst	= 32,	/** Default count of messages the rate limiter lets pass in a burst. */
+	EBS_RateLimiterQueueSize	= 1024,	/** Max. count of distinct remote objects the rate limiter holds back messages for per lane. */
+	EBS_SubscriptionDueBatchSize	= 1024,	/** Max. count of held back subscription values pushed per processor timer tick. */
+	EBS_TrafficLogSize		= 8192,	/** Capacity of the traffic log ring, in messages. */
+	EBS_TrafficLogHistorySize	= 65536	/** Count of the latest traffic log records the message log view keeps. */
 };
@@ -0,0 +1,57 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+/**
+ * Public API of the RemoteProtocolBridge engine library (Engine/RemoteProtocolBridgeEngine.jucer),
+ * for applications that embed the bridge instead of talking to it through the network.
+ *
+ * - Configuration: fill a ProcessingEngineConfig programmatically (AddDefaultNode, SetProtocolData, ...),
+ *   or read it from a file (SetConfigFile, ReadConfiguration), and hand it to ProcessingEngine::SetConfig.
+ * - Start/stop: ProcessingEngine::Start and ProcessingEngine::Stop. The engine threading mode of the
+ *   configuration defines whether the embedding application has to run a JUCE message loop (ETM_MessageThread)
+ *   or the engine runs on its own threads.
+ * - Message injection: ProcessingEngine::InjectMessage feeds a value into a node as if one of its protocols had received it.
+ * - Message observation: ProcessingEngine::SetLoggingTarget with logging enabled reports all node traffic to a LoggingTarget_Interface.
+ *   It is called on the engine threads, so it should only record the traffic, e.g. in a TrafficLogRing, and format it elsewhere.
+ * - Metrics: ProcessingEngine::GetNodeMetrics and ProcessingEngine::CreateMetricsSnapshot report message counters, latencies and queue depths.
+ */
+
+#include "RemoteProtocolBridgeCommon.h"
+#include "LoggingTarget_Interface.h"
+#include "ProcessingEngineConfig.h"
+#include "ProcessingEngine.h"
+#include "TrafficLogRing.h"
@@ -0,0 +1,155 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include "TrafficLogRing.h"
+
+
+// **************************************************************************************
+//    class TrafficLogRing
+// **************************************************************************************
+/**
+ * Constructor of the ring. Preallocates the storage for the given number of records.
+ *
+ * @param capacity	The min. number of records the ring can hold. Rounded up to the next power of two.
+ */
+TrafficLogRing::TrafficLogRing(int capacity)
+	: m_cells(static_cast<size_t>(nextPowerOfTwo(jmax(2, capacity))))
+{
+	m_mask = static_cast<uint32>(m_cells.size() - 1);
+	for (size_t i = 0; i < m_cells.size(); ++i)
+		m_cells[i].Sequence = static_cast<uint32>(i);
+
+	m_writePosition = 0;
+	m_readPosition = 0;
+	m_droppedCount = 0;
+}
+
+/**
+ * Destructor
+ */
+TrafficLogRing::~TrafficLogRing()
+{
+}
+
+/**
+ * Method to write a record of a message into the ring. Can be called from any number of threads concurrently.
+ * Values of string messages are not recorded.
+ *
+ * @param NId			The node the message was received by.
+ * @param SenderType	The type of the protocol the message was received by.
+ * @param SenderPId		The id of the protocol the message was received by.
+ * @param Id			The remote object id of the message.
+ * @param msgData		The message data.
+ * @return	True if the record was written, false if it was dropped since the ring is full.
+ */
+bool TrafficLogRing::Push(NodeId NId, ProtocolType SenderType, ProtocolId SenderPId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData)
+{
+	// claim a ring position by advancing the write position, as long as the cell at that position was read already
+	Cell* cell = nullptr;
+	uint32 position = m_writePosition.get();
+	while (cell == nullptr)
+	{
+		Cell& candidate = m_cells[position & m_mask];
+		int32 distance = static_cast<int32>(candidate.Sequence.get() - position);
+		if (distance == 0 && m_writePosition.compareAndSetBool(position + 1, position))
+			cell = &candidate;
+		else if (distance < 0)
+		{
+			++m_droppedCount;
+			return false;
+		}
+		else
+			position = m_writePosition.get();
+	}
+
+	TrafficLogRecord& record = cell->Record;
+	record.Time = Time::currentTimeMillis();
+	record.NId = NId;
+	record.SenderType = SenderType;
+	if (!record.Message.Set(SenderPId, Id, msgData))
+	{
+		record.Message.PId = SenderPId;
+		record.Message.Id = Id;
+		record.Message.addrVal = msgData.addrVal;
+		record.Message.valType = ROVT_NONE;
+		record.Message.valCount = 0;
+	}
+
+	// publish the record to the consumer
+	cell->Sequence = position + 1;
+
+	return true;
+}
+
+/**
+ * Method to take the oldest record out of the ring. To be called from the consuming thread only.
+ *
+ * @param record	The record object to copy the popped record into.
+ * @return	True if a record was popped, false if the ring was empty.
+ */
+bool TrafficLogRing::Pop(TrafficLogRecord& record)
+{
+	Cell& cell = m_cells[m_readPosition & m_mask];
+	if (static_cast<int32>(cell.Sequence.get() - (m_readPosition + 1)) < 0)
+		return false;
+
+	record = cell.Record;
+
+	// hand the cell back to the producers for the position one lap ahead
+	cell.Sequence = m_readPosition + m_mask + 1;
+	++m_readPosition;
+
+	return true;
+}
+
+/**
+ * Getter for the number of records the ring can hold.
+ *
+ * @return	The capacity of the ring.
+ */
+int TrafficLogRing::GetCapacity() const
+{
+	return static_cast<int>(m_cells.size());
+}
+
+/**
+ * Getter for the number of records that were dropped since the ring was created.
+ *
+ * @return	The number of dropped records.
+ */
+uint32 TrafficLogRing::GetDroppedCount() const
+{
+	return m_droppedCount.get();
+}
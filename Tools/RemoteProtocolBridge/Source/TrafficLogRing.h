@@ -0,0 +1,90 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#pragma once
+
+#include "RemoteProtocolBridgeCommon.h"
+
+#include <JuceHeader.h>
+
+
+/**
+ * Fixed-size binary record of a single logged protocol message.
+ * Holds everything needed to format the log line later, so nothing has to be formatted while logging.
+ */
+struct TrafficLogRecord
+{
+	int64					Time;		/**< The time the message was logged, in ms since 1970. */
+	NodeId					NId;		/**< The node the message was received by. */
+	ProtocolType			SenderType;	/**< The type of the protocol the message was received by. */
+	RemoteObjectMessageCopy	Message;	/**< The message, incl. the id of the receiving protocol, its object id, addressing and values. */
+};
+
+/**
+ * Class TrafficLogRing is a lock-free multiple producer / single consumer ring buffer of traffic log records.
+ * Node threads write records of the messages they process, the user interface takes and formats them later.
+ * All storage is preallocated on construction, writing a record does not allocate, format or block.
+ * If the ring is full, records are dropped and counted instead.
+ */
+class TrafficLogRing
+{
+public:
+	TrafficLogRing(int capacity = EBS_TrafficLogSize);
+	~TrafficLogRing();
+
+	bool Push(NodeId NId, ProtocolType SenderType, ProtocolId SenderPId, RemoteObjectIdentifier Id, const RemoteObjectMessageData& msgData);
+	bool Pop(TrafficLogRecord& record);
+
+	int GetCapacity() const;
+	uint32 GetDroppedCount() const;
+
+private:
+	/**
+	 * A slot of the ring. The sequence number tells producers and consumer whose turn it is to access the record.
+	 */
+	struct Cell
+	{
+		Atomic<uint32>		Sequence;	/**< The ring position the cell is next written at, or that position + 1 once the record is written. */
+		TrafficLogRecord	Record;		/**< The record stored in the cell. */
+	};
+
+	std::vector<Cell>	m_cells;			/**< The preallocated cells, a power of two count. */
+	uint32				m_mask;				/**< Bitmask to wrap ring positions into the cells. */
+	Atomic<uint32>		m_writePosition;	/**< The ring position the next record is written at. Claimed by the producers. */
+	uint32				m_readPosition;		/**< The ring position the next record is read from. Only accessed by the consumer. */
+	Atomic<uint32>		m_droppedCount;		/**< Count of records that were dropped due to a full ring. */
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrafficLogRing)
+};
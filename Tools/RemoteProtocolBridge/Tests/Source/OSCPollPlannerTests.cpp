@@ -0,0 +1,126 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include <JuceHeader.h>
+
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCPollPlanner.h"
+
+
+/**
+ * Tests of the polling intervals OSCPollPlanner assigns to the composite objects it polls in place of their parts.
+ */
+class OSCPollPlannerTests : public UnitTest
+{
+public:
+	OSCPollPlannerTests() : UnitTest("OSCPollPlanner", "Polling") {}
+
+	void runTest() override
+	{
+		const int defaultInterval = 100;
+
+		beginTest("Part tier only speeds up the composite poll at the same addressing");
+		{
+			Array<RemoteObject> objects;
+			objects.add(CreateObject(ROI_SoundObject_Position_XY, 1));
+			objects.add(CreateObject(ROI_SoundObject_Position_X, 1));
+			objects.add(CreateObject(ROI_SoundObject_Position_XY, 2));
+
+			std::map<RemoteObjectIdentifier, int> tiers;
+			tiers[ROI_SoundObject_Position_X] = 20;
+
+			OSCPollPlanner planner;
+			planner.Plan(objects, defaultInterval, tiers);
+
+			expectEquals(planner.GetPollObjects().size(), 2);
+			expectEquals(GetPollInterval(planner, ROI_SoundObject_Position_XY, 1), 20);
+			expectEquals(GetPollInterval(planner, ROI_SoundObject_Position_XY, 2), defaultInterval);
+		}
+
+		beginTest("Parts without tier keep the composite poll at the default interval");
+		{
+			Array<RemoteObject> objects;
+			objects.add(CreateObject(ROI_SoundObject_Position_X, 1));
+			objects.add(CreateObject(ROI_SoundObject_Position_Y, 1));
+
+			std::map<RemoteObjectIdentifier, int> tiers;
+			tiers[ROI_SoundObject_Position_XY] = 500;
+
+			OSCPollPlanner planner;
+			planner.Plan(objects, defaultInterval, tiers);
+
+			expectEquals(planner.GetPollObjects().size(), 1);
+			expectEquals(GetPollInterval(planner, ROI_SoundObject_Position_XY, 1), defaultInterval);
+		}
+	}
+
+private:
+	/**
+	 * Helper to create a remote object of a source in mapping 1.
+	 *
+	 * @param Id		The remote object id.
+	 * @param source	The source (channel) of the object.
+	 * @return	The remote object.
+	 */
+	static RemoteObject CreateObject(RemoteObjectIdentifier Id, int16 source)
+	{
+		RemoteObject obj;
+		obj.Id = Id;
+		obj.Addr = RemoteObjectAddressing(source, 1);
+
+		return obj;
+	}
+
+	/**
+	 * Helper to look up the polling interval the planner assigned to a polled object.
+	 *
+	 * @param planner	The planner to look up the interval in.
+	 * @param Id		The remote object id of the polled object.
+	 * @param source	The source (channel) of the polled object.
+	 * @return	The polling interval in ms, or -1 if the object is not polled.
+	 */
+	static int GetPollInterval(const OSCPollPlanner& planner, RemoteObjectIdentifier Id, int16 source)
+	{
+		const Array<RemoteObject>& pollObjects = planner.GetPollObjects();
+		for (int i = 0; i < pollObjects.size(); ++i)
+		{
+			if (pollObjects[i].Id == Id && pollObjects[i].Addr.first == source)
+				return planner.GetPollIntervals()[i];
+		}
+
+		return -1;
+	}
+};
+
+static OSCPollPlannerTests s_oscPollPlannerTests;
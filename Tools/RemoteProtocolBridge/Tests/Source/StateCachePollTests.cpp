@@ -0,0 +1,133 @@
+/*
+===============================================================================
+
+Copyright (C) 2019 d&b audiotechnik GmbH & Co. KG. All Rights Reserved.
+
+This file is part of RemoteProtocolBridge.
+
+Redistribution and use in source and binary forms, with or without 
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice,
+this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice,
+this list of conditions and the following disclaimer in the documentation
+and/or other materials provided with the distribution.
+
+3. The name of the author may not be used to endorse or promote products
+derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY d&b audiotechnik GmbH & Co. KG "AS IS" AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+===============================================================================
+*/
+
+
+#include <JuceHeader.h>
+
+#include "../../Source/ProcessingEngineConfig.h"
+#include "../../Source/ProcessingEngineNode.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCProtocolProcessor.h"
+#include "../../Source/ProtocolProcessor/OSCProtocolProcessor/OSCAddressTable.h"
+
+
+/**
+ * Tests of the node state cache answering value-less polls of role A clients.
+ * The polls are fed through both receive paths of an OSC protocol processor that stands in for the role A protocol of the node,
+ * the node's own protocols are not started.
+ */
+class StateCachePollTests : public UnitTest
+{
+public:
+	StateCachePollTests() : UnitTest("RemoteObjectStateCache polls", "StateCache") {}
+
+	void runTest() override
+	{
+		ProcessingEngineConfig config;
+		config.Clear();
+		config.AddDefaultNode();
+		NodeId NId = config.GetNodeIds()[0];
+		config.AddDefaultProtocolA(NId);
+		config.AddDefaultProtocolB(NId);
+		config.SetStateCacheMaxAge(NId, 1000);
+		ProtocolId PAId = config.GetProtocolAIds(NId)[0];
+		ProtocolId PBId = config.GetProtocolBIds(NId)[0];
+
+		ProcessingEngineNode node;
+		node.SetNodeConfiguration(config, NId);
+
+		ProcessingEngineConfig::ProtocolData protocolData = config.GetProtocolData(NId, PAId);
+		protocolData.IpAddress = "127.0.0.1";
+		OSCProtocolProcessor receiver(protocolData.HostPort);
+		receiver.AddListener(&node);
+		receiver.SetProtocolConfigurationData(protocolData, Array<RemoteObject>(), NId, PAId);
+
+		RemoteObjectMessageData pollData;
+		pollData.addrVal = RemoteObjectAddressing(1, 1);
+		pollData.valType = ROVT_NONE;
+		pollData.valCount = 0;
+		pollData.payload = nullptr;
+		pollData.payloadSize = 0;
+
+		OSCMessageEncoder encoder;
+		char poll[256];
+		size_t pollSize = encoder.EncodeMessage(ROI_SoundObject_Position_XY, pollData, poll, sizeof(poll));
+		SenderEndpoint sender = SenderEndpoint::fromString(protocolData.IpAddress, protocolData.ClientPort);
+
+		OSCMessage pollMessage(OSCAddressPattern(String(OSCAddressTable::GetAddress(ROI_SoundObject_Position_XY)) + "/1/1"));
+
+		beginTest("Second role A poll within the response timeout is not sent upstream");
+		{
+			receiver.oscRawDataReceived(poll, pollSize, sender);
+			expectEquals(GetSendCount(node, PBId), uint64(1));
+
+			receiver.oscMessageReceived(pollMessage, protocolData.IpAddress, protocolData.ClientPort);
+			expectEquals(GetSendCount(node, PBId), uint64(1));
+			expectEquals(node.GetStateCache().GetDeduplicatedCount(), uint32(1));
+		}
+
+		beginTest("Role A poll is answered from the cache");
+		{
+			float values[2] = { 0.25f, 0.75f };
+			RemoteObjectMessageData valueData;
+			valueData.addrVal = RemoteObjectAddressing(1, 1);
+			valueData.valType = ROVT_FLOAT;
+			valueData.valCount = 2;
+			valueData.payload = values;
+			valueData.payloadSize = 2 * sizeof(float);
+			node.InjectMessage(PBId, ROI_SoundObject_Position_XY, valueData);
+
+			receiver.oscRawDataReceived(poll, pollSize, sender);
+			expectEquals(node.GetStateCache().GetAnsweredCount(), uint32(1));
+
+			receiver.oscMessageReceived(pollMessage, protocolData.IpAddress, protocolData.ClientPort);
+			expectEquals(node.GetStateCache().GetAnsweredCount(), uint32(2));
+			expectEquals(GetSendCount(node, PBId), uint64(1));
+		}
+	}
+
+private:
+	/**
+	 * Helper to get the count of messages the node passed on to a protocol, whether the protocol could send them or not.
+	 *
+	 * @param node	The node to get the count of.
+	 * @param PId	The id of the protocol.
+	 * @return	The count of messages passed on to the protocol.
+	 */
+	static uint64 GetSendCount(const ProcessingEngineNode& node, ProtocolId PId)
+	{
+		return node.GetMetrics().GetProtocolCount(MC_Sent, PId) + node.GetMetrics().GetProtocolCount(MC_Dropped, PId);
+	}
+};
+
+static StateCachePollTests s_stateCachePollTests;